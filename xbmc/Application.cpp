@@ -1434,6 +1434,7 @@ void CApplication::Render()
   // fresh for the next process(), or after a windowclose animation (where process()
   // isn't called)
   CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  infoMgr.EndFrame();
   infoMgr.ResetCache();
   infoMgr.GetInfoProviders().GetGUIControlsInfoProvider().ResetContainerMovingCache();
 
@@ -3021,6 +3022,8 @@ void CApplication::OnPlayBackEnded()
 {
   CLog::LogF(LOGDEBUG ,"CApplication::OnPlayBackEnded");
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CServiceBroker::GetPVRManager().OnPlaybackEnded(m_itemCurrentFile);
 
   CVariant data(CVariant::VariantTypeObject);
@@ -3063,6 +3066,7 @@ void CApplication::OnPlayBackStarted(const CFileItem &file)
   m_stackHelper.OnPlayBackStarted(file);
 
   m_playerEvent.Reset();
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
 
   CGUIMessage msg(GUI_MSG_PLAYBACK_STARTED, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
@@ -3150,6 +3154,8 @@ void CApplication::OnPlayBackStopped()
 {
   CLog::LogF(LOGDEBUG, "CApplication::OnPlayBackStopped");
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CServiceBroker::GetPVRManager().OnPlaybackStopped(m_itemCurrentFile);
 
   CVariant data(CVariant::VariantTypeObject);
@@ -3176,6 +3182,8 @@ void CApplication::OnPlayBackPaused()
   CServiceBroker::GetXBPython().OnPlayBackPaused();
 #endif
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CVariant param;
   param["player"]["speed"] = 0;
   param["player"]["playerid"] = CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist();
@@ -3189,6 +3197,8 @@ void CApplication::OnPlayBackResumed()
   CServiceBroker::GetXBPython().OnPlayBackResumed();
 #endif
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CVariant param;
   param["player"]["speed"] = 1;
   param["player"]["playerid"] = CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist();
@@ -3202,6 +3212,8 @@ void CApplication::OnPlayBackSpeedChanged(int iSpeed)
   CServiceBroker::GetXBPython().OnPlayBackSpeedChanged(iSpeed);
 #endif
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CVariant param;
   param["player"]["speed"] = iSpeed;
   param["player"]["playerid"] = CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist();
@@ -3216,6 +3228,8 @@ void CApplication::OnPlayBackSeek(int64_t iTime, int64_t seekOffset)
                                                static_cast<int>(seekOffset));
 #endif
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CVariant param;
   CJSONUtils::MillisecondsToTimeObject(iTime, param["player"]["time"]);
   CJSONUtils::MillisecondsToTimeObject(seekOffset, param["player"]["seekoffset"]);
@@ -3237,6 +3251,8 @@ void CApplication::OnAVStarted(const CFileItem &file)
 {
   CLog::LogF(LOGDEBUG, "CApplication::OnAVStarted");
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CGUIMessage msg(GUI_MSG_PLAYBACK_AVSTARTED, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
 
@@ -3251,6 +3267,8 @@ void CApplication::OnAVChange()
 {
   CLog::LogF(LOGDEBUG, "CApplication::OnAVChange");
 
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
+
   CServiceBroker::GetGUI()->GetStereoscopicsManager().OnStreamChange();
 
   CGUIMessage msg(GUI_MSG_PLAYBACK_AVCHANGE, 0, 0);
@@ -3807,6 +3825,8 @@ bool CApplication::OnMessage(CGUIMessage& message)
 
   case GUI_MSG_PLAYBACK_STARTED:
     {
+      m_prefetchedPath.clear();
+
 #ifdef TARGET_DARWIN_EMBEDDED
       // @TODO move this away to platform code
       CDarwinUtils::SetScheduling(m_appPlayer.IsPlayingVideo());
@@ -4219,6 +4239,9 @@ void CApplication::ProcessSlow()
   // check if we should restart the player
   CheckDelayedPlayerRestart();
 
+  // let the player open the next item ahead of time
+  CheckPrefetchNextItem();
+
   //  check if we can unload any unreferenced dlls or sections
   if (!m_appPlayer.IsPlayingVideo())
     CSectionLoader::UnloadDelayed();
@@ -4299,6 +4322,47 @@ void CApplication::CheckDelayedPlayerRestart()
   }
 }
 
+void CApplication::CheckPrefetchNextItem()
+{
+  if (!m_appPlayer.IsPlayingVideo())
+    return;
+
+  const int seconds = CServiceBroker::GetSettingsComponent()
+                          ->GetAdvancedSettings()
+                          ->m_videoPrefetchNextItemSeconds;
+  if (seconds <= 0)
+    return;
+
+  const int64_t totalTime = m_appPlayer.GetTotalTime();
+  if (totalTime <= 0 || totalTime - m_appPlayer.GetTime() > seconds * 1000)
+    return;
+
+  CFileItemPtr item;
+  if (m_stackHelper.IsPlayingRegularStack())
+  {
+    if (m_stackHelper.HasNextStackPartFileItem())
+      item = std::make_shared<CFileItem>(
+          m_stackHelper.GetStackPartFileItem(m_stackHelper.GetCurrentPartNumber() + 1));
+  }
+  else
+  {
+    const CPlayListPlayer& playlistPlayer = CServiceBroker::GetPlaylistPlayer();
+    const int playlist = playlistPlayer.GetCurrentPlaylist();
+    const int next = playlistPlayer.GetNextSong(1);
+    if (playlist == PLAYLIST_VIDEO && next >= 0 && next != playlistPlayer.GetCurrentSong() &&
+        next < playlistPlayer.GetPlaylist(playlist).size())
+      item = playlistPlayer.GetPlaylist(playlist)[next];
+  }
+
+  // stacks, plugins and the like are resolved on playback, there is nothing to open yet
+  if (!item || !item->IsVideo() || item->IsStack() || item->IsPlugin() ||
+      item->GetDynPath() == m_prefetchedPath)
+    return;
+
+  m_prefetchedPath = item->GetDynPath();
+  m_appPlayer.PrefetchNextFile(*item);
+}
+
 void CApplication::Restart(bool bSamePosition)
 {
   // this function gets called when the user changes a setting (like noninterleaved)
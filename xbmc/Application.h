@@ -176,6 +176,7 @@ public:
   void Restart(bool bSamePosition = true);
   void DelayedPlayerRestart();
   void CheckDelayedPlayerRestart();
+  void CheckPrefetchNextItem();
   bool IsPlayingFullScreenVideo() const;
   bool IsFullScreen();
   bool OnAction(const CAction &action);
@@ -386,6 +387,7 @@ protected:
   bool m_bPlatformDirectories = true;
 
   int m_nextPlaylistItem = -1;
+  std::string m_prefetchedPath; ///< next item handed to the player for prefetching
 
   std::chrono::time_point<std::chrono::steady_clock> m_lastRenderTime;
   bool m_skipGuiRender = false;
@@ -43,6 +43,7 @@ void CApplicationPlayer::ResetPlayer()
   // we need to do this directly on the member
   CSingleLock lock(m_playerLock);
   m_pPlayer.reset();
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
 }
 
 void CApplicationPlayer::CloseFile(bool reopen)
@@ -556,6 +557,13 @@ bool CApplicationPlayer::QueueNextFile(const CFileItem &file)
   return (player && player->QueueNextFile(file));
 }
 
+void CApplicationPlayer::PrefetchNextFile(const CFileItem& file)
+{
+  std::shared_ptr<IPlayer> player = GetInternal();
+  if (player)
+    player->PrefetchNextFile(file);
+}
+
 bool CApplicationPlayer::SetPlayerState(const std::string& state)
 {
   std::shared_ptr<IPlayer> player = GetInternal();
@@ -818,8 +826,11 @@ void CApplicationPlayer::FrameMove()
   if (player)
   {
     if (CDataCacheCore::GetInstance().IsPlayerStateChanged())
+    {
+      CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_PLAYER);
       // CApplicationMessenger would be overhead because we are already in gui thread
       CServiceBroker::GetGUI()->GetWindowManager().SendMessage(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_STATE_CHANGED);
+    }
   }
 }
 
@@ -6975,6 +6975,15 @@ const infomap listitem_labels[]= {{ "thumb",            LISTITEM_THUMB },
 ///     @return the name of the visualisation.
 ///     <p>
 ///   }
+///   \table_row3{   <b>`Visualisation.Spectrum(band)`</b>,
+///                  \anchor Visualisation_Spectrum
+///                  _integer_,
+///     @return The level of a band of the audio spectrum shown by the running
+///     visualisation, from 0 to 100. Bands 0 to 15 are log spaced from low to high.
+///     <p><hr>
+///     @skinning_v20 **[New Infolabel]** \link Visualisation_Spectrum `Visualisation.Spectrum(band)`\endlink
+///     <p>
+///   }
 /// \table_end
 ///
 /// -----------------------------------------------------------------------------
@@ -10044,6 +10053,8 @@ int CGUIInfoManager::TranslateSingleString(const std::string &strCondition, bool
     }
     else if (cat.name == "visualisation")
     {
+      if (prop.name == "spectrum" && prop.num_params() == 1)
+        return AddMultiInfo(CGUIInfo(VISUALISATION_SPECTRUM, atoi(prop.param().c_str())));
       for (const infomap& i : visualisation)
       {
         if (prop.name == i.str)
@@ -10456,9 +10467,9 @@ INFO::InfoPtr CGUIInfoManager::Register(const std::string &expression, int conte
   std::pair<INFOBOOLTYPE::iterator, bool> res;
 
   if (condition.find_first_of("|+[]!") != condition.npos)
-    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_refreshCounters));
   else
-    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_refreshCounters));
 
   if (res.second)
     res.first->get()->Initialize();
@@ -11035,7 +11046,85 @@ void CGUIInfoManager::ResetCache()
 {
   // mark our infobools as dirty
   CSingleLock lock(m_critInfo);
-  ++m_refreshCounter;
+  ++m_refreshCounters.counters[INFO::INFO_SOURCE_FRAME];
+
+  // the library bools are set from the scanners and databases, pick up their changes here
+  const unsigned int libraryChangeCounter =
+      m_infoProviders.GetLibraryInfoProvider().GetChangeCounter();
+  if (libraryChangeCounter != m_libraryChangeCounter)
+  {
+    m_libraryChangeCounter = libraryChangeCounter;
+    ++m_refreshCounters.counters[INFO::INFO_SOURCE_LIBRARY];
+  }
+}
+
+void CGUIInfoManager::InvalidateInfoSource(INFO::InfoSource source)
+{
+  // the counters are atomic, this is called from player threads and with the gfx lock held
+  ++m_refreshCounters.counters[source];
+}
+
+void CGUIInfoManager::EndFrame()
+{
+  m_infoBoolUpdatesLastFrame = m_refreshCounters.updates.exchange(0);
+}
+
+unsigned int CGUIInfoManager::GetInfoSources(int condition) const
+{
+  condition = std::abs(condition);
+  if (condition >= MULTI_INFO_START && condition <= MULTI_INFO_END)
+    condition = std::abs(m_multiInfo[condition - MULTI_INFO_START].m_info);
+
+  switch (condition)
+  {
+    case SKIN_BOOL:
+    case SKIN_STRING:
+    case SKIN_STRING_IS_EQUAL:
+      return 1 << INFO::INFO_SOURCE_SKIN_SETTINGS;
+    case LIBRARY_HAS_MUSIC:
+    case LIBRARY_HAS_VIDEO:
+    case LIBRARY_HAS_MOVIES:
+    case LIBRARY_HAS_MOVIE_SETS:
+    case LIBRARY_HAS_TVSHOWS:
+    case LIBRARY_HAS_MUSICVIDEOS:
+    case LIBRARY_HAS_SINGLES:
+    case LIBRARY_HAS_COMPILATIONS:
+    case LIBRARY_HAS_ROLE:
+    case LIBRARY_HAS_BOXSETS:
+      return 1 << INFO::INFO_SOURCE_LIBRARY;
+    case WINDOW_IS:
+    case WINDOW_IS_MEDIA:
+    case WINDOW_IS_ACTIVE:
+    case WINDOW_IS_VISIBLE:
+    case WINDOW_IS_DIALOG_TOPMOST:
+    case WINDOW_IS_MODAL_DIALOG_TOPMOST:
+    case WINDOW_NEXT:
+    case WINDOW_PREVIOUS:
+    case SYSTEM_HAS_ACTIVE_MODAL_DIALOG:
+    case SYSTEM_HAS_VISIBLE_MODAL_DIALOG:
+      return 1 << INFO::INFO_SOURCE_WINDOWS;
+    case PLAYER_HAS_MEDIA:
+    case PLAYER_HAS_AUDIO:
+    case PLAYER_HAS_VIDEO:
+    case PLAYER_HAS_GAME:
+    case PLAYER_PLAYING:
+    case PLAYER_PAUSED:
+    case PLAYER_REWINDING:
+    case PLAYER_REWINDING_2x:
+    case PLAYER_REWINDING_4x:
+    case PLAYER_REWINDING_8x:
+    case PLAYER_REWINDING_16x:
+    case PLAYER_REWINDING_32x:
+    case PLAYER_FORWARDING:
+    case PLAYER_FORWARDING_2x:
+    case PLAYER_FORWARDING_4x:
+    case PLAYER_FORWARDING_8x:
+    case PLAYER_FORWARDING_16x:
+    case PLAYER_FORWARDING_32x:
+      return 1 << INFO::INFO_SOURCE_PLAYER;
+    default:
+      return INFO::INFO_SOURCE_MASK_FRAME;
+  }
 }
 
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag &tag)
@@ -61,6 +61,27 @@ public:
   void Clear();
   void ResetCache();
 
+  /*! \brief Mark the info bools depending on the given source as dirty
+   Conditions on sources other than INFO::INFO_SOURCE_FRAME are not dirtied by ResetCache,
+   whoever changes their state has to call this. May be called from any thread.
+   \param source the source that changed
+   */
+  void InvalidateInfoSource(INFO::InfoSource source);
+
+  /*! \brief Called by the application once per rendered frame to sample the info bool updates
+   */
+  void EndFrame();
+
+  /*! \brief Number of cached info bools updated in the last frame, shown in the debug overlay
+   */
+  unsigned int GetInfoBoolUpdatesLastFrame() const { return m_infoBoolUpdatesLastFrame; }
+
+  /*! \brief Get the info sources a condition depends on
+   \param condition the condition as returned by TranslateSingleString
+   \return mask of INFO::INFO_SOURCE_* bits
+   */
+  unsigned int GetInfoSources(int condition) const;
+
   // KODI::MESSAGING::IMessageTarget implementation
   int GetMessageMask() override;
   void OnApplicationMessage(KODI::MESSAGING::ThreadMessage* pMsg) override;
@@ -202,7 +223,9 @@ private:
 
   typedef std::set<INFO::InfoPtr, bool(*)(const INFO::InfoPtr&, const INFO::InfoPtr&)> INFOBOOLTYPE;
   INFOBOOLTYPE m_bools;
-  unsigned int m_refreshCounter = 0;
+  INFO::InfoRefreshCounters m_refreshCounters;
+  unsigned int m_libraryChangeCounter = 0;
+  unsigned int m_infoBoolUpdatesLastFrame = 0;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
@@ -14,16 +14,28 @@
 #include "guilib/GUIComponent.h"
 #include "guilib/Texture.h"
 #include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
 #include "utils/JobManager.h"
 #include "utils/TimeUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <exception>
 
+namespace
+{
+// images loaded at once, at least
+constexpr unsigned int MIN_RUNNING_JOBS = 2;
+// an image asked for within this time (ms) is waited for by a visible control
+constexpr unsigned int VISIBLE_TIME = 100;
+// number of loaded images the queue latency is logged for
+constexpr unsigned int STATS_INTERVAL = 100;
+} // namespace
+
 CImageLoader::CImageLoader(const std::string &path, const bool useCache):
   m_path(path)
 {
@@ -43,7 +55,7 @@ bool CImageLoader::DoWork()
     return false;
 
   if (m_use_cache)
-    loadPath = CTextureCache::GetInstance().CheckCachedImage(texturePath, needsChecking);
+    loadPath = CTextureCache::GetInstance().CheckCachedTexture(texturePath, needsChecking);
   else
     loadPath = texturePath;
 
@@ -60,6 +72,7 @@ bool CImageLoader::DoWork()
 
     if (duration.count() > 100)
       CLog::Log(LOGDEBUG, "{} - took {} ms to load {}", __FUNCTION__, duration.count(), loadPath);
+    m_loadTime = duration.count();
 
     if (m_texture)
     {
@@ -77,7 +90,11 @@ bool CImageLoader::DoWork()
     return false; // We're done
 
   // not in our texture cache or it failed to load from it, so try and load directly and then cache the result
+  auto start = std::chrono::steady_clock::now();
   CTextureCache::GetInstance().CacheImage(texturePath, &m_texture);
+  m_loadTime += std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
   return (m_texture != NULL);
 }
 
@@ -173,6 +190,18 @@ bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &t
 
   if (firstRequest)
     QueueImage(path, useCache);
+  else
+  {
+    // still wanted by a visible control, keep it ahead of those that have scrolled away
+    for (auto& queued : m_queued)
+    {
+      if (queued.image->GetPath() == path)
+      {
+        queued.requestTime = CTimeUtils::GetFrameTime();
+        break;
+      }
+    }
+  }
 
   return true;
 }
@@ -192,13 +221,18 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
   }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    unsigned int id = it->first;
-    CLargeTexture *image = it->second;
+    unsigned int id = it->jobID;
+    CLargeTexture *image = it->image;
     if (image->GetPath() == path && image->DecrRef(true))
     {
-      // cancel this job
-      CJobManager::GetInstance().CancelJob(id);
+      // cancel this job, images still waiting haven't got one yet
+      if (id)
+      {
+        CJobManager::GetInstance().CancelJob(id);
+        m_runningJobs--;
+      }
       m_queued.erase(it);
+      StartJobs();
       return;
     }
   }
@@ -213,18 +247,86 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    CLargeTexture *image = it->second;
+    CLargeTexture *image = it->image;
     if (image->GetPath() == path)
     {
       image->AddRef();
+      it->requestTime = CTimeUtils::GetFrameTime();
       return; // already queued
     }
   }
 
   // queue the item
   CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, CJob::PRIORITY_NORMAL);
-  m_queued.emplace_back(jobID, image);
+  m_queued.push_back(
+      {image, useCache, 0, CTimeUtils::GetFrameTime(), std::chrono::steady_clock::now()});
+  StartJobs();
+}
+
+void CGUILargeTextureManager::StartJobs()
+{
+  const std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  const unsigned int maxJobs =
+      std::max(MIN_RUNNING_JOBS, cpuInfo ? static_cast<unsigned int>(cpuInfo->GetCPUCount()) / 2
+                                         : 0);
+  const unsigned int frameTime = CTimeUtils::GetFrameTime();
+
+  // asked for during the last frames means a visible control is waiting for it, after that
+  // the most recent requests are the images coming into view
+  auto isVisible = [frameTime](const QueuedImage& queued) {
+    return queued.requestTime + VISIBLE_TIME >= frameTime;
+  };
+  auto isMoreWanted = [&isVisible](const QueuedImage& a, const QueuedImage& b) {
+    if (isVisible(a) != isVisible(b))
+      return isVisible(a);
+    if (a.requestTime != b.requestTime)
+      return a.requestTime > b.requestTime;
+    return a.queueTime > b.queueTime;
+  };
+
+  while (m_runningJobs < maxJobs)
+  {
+    queueIterator next = m_queued.end();
+    for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
+    {
+      if (!it->jobID && (next == m_queued.end() || isMoreWanted(*it, *next)))
+        next = it;
+    }
+    if (next == m_queued.end())
+      return;
+
+    next->jobID = CJobManager::GetInstance().AddJob(
+        new CImageLoader(next->image->GetPath(), next->useCache), this, CJob::PRIORITY_NORMAL);
+    if (!next->jobID)
+      return;
+    m_runningJobs++;
+  }
+}
+
+void CGUILargeTextureManager::UpdateStats(const QueuedImage& queued, unsigned int loadTime)
+{
+  const double waitTime = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - queued.queueTime)
+                              .count() -
+                          loadTime;
+
+  m_statsImages++;
+  m_statsWaitTime += waitTime;
+  m_statsMaxWaitTime = std::max(m_statsMaxWaitTime, waitTime);
+  m_statsLoadTime += loadTime;
+
+  if (m_statsImages == STATS_INTERVAL)
+  {
+    CLog::Log(LOGDEBUG,
+              "CGUILargeTextureManager::{} - {} images waited {:.1f} ms on average ({:.1f} ms "
+              "max), loading took {:.1f} ms on average",
+              __FUNCTION__, m_statsImages, m_statsWaitTime / m_statsImages, m_statsMaxWaitTime,
+              m_statsLoadTime / m_statsImages);
+    m_statsImages = 0;
+    m_statsWaitTime = 0.0;
+    m_statsMaxWaitTime = 0.0;
+    m_statsLoadTime = 0.0;
+  }
 }
 
 void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJob *job)
@@ -233,14 +335,17 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    if (it->first == jobID)
+    if (it->jobID == jobID)
     { // found our job
       CImageLoader *loader = static_cast<CImageLoader*>(job);
-      CLargeTexture *image = it->second;
+      CLargeTexture *image = it->image;
       image->SetTexture(std::move(loader->m_texture));
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
+      UpdateStats(*it, loader->m_loadTime);
       m_queued.erase(it);
       m_allocated.push_back(image);
+      m_runningJobs--;
+      StartJobs();
       return;
     }
   }
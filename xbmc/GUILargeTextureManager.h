@@ -12,6 +12,7 @@
 #include "threads/CriticalSection.h"
 #include "utils/Job.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -41,6 +42,7 @@ public:
   bool          m_use_cache; ///< Whether or not to use any caching with this image
   std::string    m_path; ///< path of image to load
   std::unique_ptr<CTexture> m_texture; ///< Texture object to load the image into \sa CTexture.
+  unsigned int m_loadTime = 0; ///< time taken to load the image in ms
 };
 
 /*!
@@ -50,6 +52,11 @@ public:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Only a few images are loaded at once, the others wait in the manager so the order can change
+ while they wait. Images still asked for by visible controls go first, the most recently
+ requested of them first, so while scrolling the ones coming into view are loaded before those
+ that have passed already. Images that are released while waiting are dropped without loading.
+
  \sa IJobCallback, CGUITexture
  */
 class CGUILargeTextureManager : public IJobCallback
@@ -131,12 +138,36 @@ private:
     unsigned int m_timeToDelete;
   };
 
+  struct QueuedImage
+  {
+    CLargeTexture* image;
+    bool useCache;
+    unsigned int jobID; ///< 0 while waiting for a job
+    unsigned int requestTime; ///< frame time the image was last asked for
+    std::chrono::steady_clock::time_point queueTime;
+  };
+
   void QueueImage(const std::string &path, bool useCache = true);
 
-  std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  /*!
+   \brief Start loading the most wanted waiting images, as long as there are free jobs.
+   */
+  void StartJobs();
+
+  void UpdateStats(const QueuedImage& queued, unsigned int loadTime);
+
+  std::vector<QueuedImage> m_queued;
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
-  typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
+  typedef std::vector<QueuedImage>::iterator queueIterator;
+
+  unsigned int m_runningJobs = 0;
+
+  // queue latency, logged every now and then
+  unsigned int m_statsImages = 0;
+  double m_statsWaitTime = 0.0;
+  double m_statsMaxWaitTime = 0.0;
+  double m_statsLoadTime = 0.0;
 
   CCriticalSection m_listSection;
 };
@@ -16,6 +16,8 @@
 #include "filesystem/IFileTypes.h"
 #include "guilib/Texture.h"
 #include "profiles/ProfileManager.h"
+#include "rendering/RenderSystem.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/Crc32.h"
@@ -31,6 +33,12 @@
 using namespace XFILE;
 using namespace std::chrono_literals;
 
+namespace
+{
+// images with fewer pixels are not worth keeping a compressed copy of
+constexpr unsigned int MIN_DDS_SIZE = 128 * 128;
+} // namespace
+
 CTextureCache &CTextureCache::GetInstance()
 {
   static CTextureCache s_cache;
@@ -117,6 +125,28 @@ std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsR
   return "";
 }
 
+std::string CTextureCache::CheckCachedTexture(const std::string &url, bool &needsRecaching)
+{
+  CTextureDetails details;
+  std::string path(GetCachedImage(url, details, true));
+  needsRecaching = !details.hash.empty();
+  if (!path.empty() && UseDDS(details))
+  {
+    std::string ddsPath = URIUtils::ReplaceExtension(path, ".dds");
+    if (CFile::Exists(ddsPath))
+      return ddsPath;
+    AddJob(new CTextureDDSJob(path));
+  }
+  return path;
+}
+
+bool CTextureCache::UseDDS(const CTextureDetails &details)
+{
+  return !details.file.empty() && details.width * details.height >= MIN_DDS_SIZE &&
+         CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_useDDSTextures &&
+         CServiceBroker::GetRenderSystem()->SupportsDXT();
+}
+
 void CTextureCache::BackgroundCacheImage(const std::string &url)
 {
   if (url.empty())
@@ -291,7 +321,17 @@ void CTextureCache::OnCachingComplete(bool success, CTextureCacheJob *job)
     if (job->m_oldHash == job->m_details.hash)
       SetCachedTextureValid(job->m_url, job->m_details.updateable);
     else
+    {
       AddCachedTexture(job->m_url, job->m_details);
+
+      // a .dds version of the previous image is out of date
+      std::string cachedFile = GetCachedPath(job->m_details.file);
+      std::string ddsFile = URIUtils::ReplaceExtension(cachedFile, ".dds");
+      if (!job->m_oldHash.empty() && CFile::Exists(ddsFile))
+        CFile::Delete(ddsFile);
+      if (UseDDS(job->m_details))
+        AddJob(new CTextureDDSJob(cachedFile));
+    }
   }
 
   { // remove from our processing list
@@ -62,6 +62,18 @@ public:
    */
   std::string CheckCachedImage(const std::string &image, bool &needsRecaching);
 
+  /*! \brief Check whether we already have this image cached, for loading as a texture
+
+   As CheckCachedImage, but returns the .dds version of the image once it exists, which
+   only the GUI can load. Queues creation of the .dds version if it should be kept.
+
+   \param image url of the image to check
+   \param needsRecaching [out] whether the image needs recaching.
+   \return cached url of this image or its .dds version
+   \sa CheckCachedImage
+   */
+  std::string CheckCachedTexture(const std::string &image, bool &needsRecaching);
+
   /*! \brief Cache image (if required) using a background job
 
    Checks firstly whether an image is already cached, and return URL if so [see CheckCacheImage]
@@ -214,6 +226,12 @@ private:
    */
   void OnCachingComplete(bool success, CTextureCacheJob *job);
 
+  /*! \brief Check whether a .dds version should be kept of a cached image.
+   \param details the details of the cached image.
+   \return true if compressed textures are enabled and supported, and the image is large enough.
+   */
+  static bool UseDDS(const CTextureDetails &details);
+
   CCriticalSection m_databaseSection;
   CTextureDatabase m_database;
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
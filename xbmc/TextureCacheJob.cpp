@@ -16,6 +16,7 @@
 #include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/audiodecoder.h"
 #include "commons/ilog.h"
 #include "filesystem/File.h"
+#include "guilib/DDSImage.h"
 #include "guilib/Texture.h"
 #include "music/MusicThumbLoader.h"
 #include "pictures/Picture.h"
@@ -261,6 +262,36 @@ std::string CTextureCacheJob::GetImageHash(const std::string &url)
   return "";
 }
 
+CTextureDDSJob::CTextureDDSJob(const std::string &original) : m_original(original)
+{
+}
+
+bool CTextureDDSJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(),GetType()) == 0)
+  {
+    const CTextureDDSJob* ddsJob = dynamic_cast<const CTextureDDSJob*>(job);
+    if (ddsJob && ddsJob->m_original == m_original)
+      return true;
+  }
+  return false;
+}
+
+bool CTextureDDSJob::DoWork()
+{
+  if (URIUtils::HasExtension(m_original, ".dds"))
+    return false;
+
+  // the cached image has been scaled and orientated already
+  std::unique_ptr<CTexture> texture = CTexture::LoadFromFile(m_original, 0, 0, true);
+  if (!texture || !texture->GetPixels())
+    return false;
+
+  CDDSImage dds;
+  return dds.Create(URIUtils::ReplaceExtension(m_original, ".dds"), texture->GetWidth(),
+                    texture->GetHeight(), texture->GetPitch(), texture->GetPixels());
+}
+
 CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
 {
 }
@@ -121,6 +121,20 @@ private:
   std::string    m_cachePath;
 };
 
+/* \brief Job class for creating .dds versions of cached images
+ */
+class CTextureDDSJob : public CJob
+{
+public:
+  explicit CTextureDDSJob(const std::string &original);
+
+  const char* GetType() const override { return "ddscompress"; }
+  bool operator==(const CJob *job) const override;
+  bool DoWork() override;
+
+  std::string m_original;
+};
+
 /* \brief Job class for storing the use count of textures
  */
 class CTextureUseCountJob : public CJob
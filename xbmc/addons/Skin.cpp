@@ -8,6 +8,7 @@
 
 #include "Skin.h"
 #include "AddonManager.h"
+#include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "dialogs/GUIDialogKaiToast.h"
@@ -49,6 +50,14 @@ std::shared_ptr<ADDON::CSkinInfo> g_SkinInfo;
 namespace
 {
 constexpr auto DELAY = 500ms;
+
+// conditions on skin settings are only updated when a setting changed
+void InvalidateSkinSettingConditions()
+{
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  if (gui)
+    gui->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_SKIN_SETTINGS);
+}
 }
 
 namespace ADDON
@@ -278,14 +287,24 @@ void CSkinInfo::LoadIncludes()
   CLog::Log(LOGINFO, "Loading skin includes from {}", includesPath);
   m_includes.Clear();
   m_includes.Load(includesPath);
+  m_skinIncludeFiles = m_includes.GetFiles();
 }
 
-void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */)
+void CSkinInfo::ResolveIncludes(TiXmlElement *node,
+                                std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */,
+                                std::vector<std::string>* includeFiles /* = nullptr */)
 {
   if(xmlIncludeConditions)
     xmlIncludeConditions->clear();
+  if (includeFiles)
+    includeFiles->clear();
 
-  m_includes.Resolve(node, xmlIncludeConditions);
+  m_includes.Resolve(node, xmlIncludeConditions, includeFiles);
+}
+
+void CSkinInfo::LoadIncludeFile(const std::string& file)
+{
+  m_includes.Load(file);
 }
 
 int CSkinInfo::GetStartWindow() const
@@ -602,6 +621,7 @@ void CSkinInfo::SetString(int setting, const std::string &label)
   {
     it->second->value = label;
     m_settingsUpdateHandler->TriggerSave();
+    InvalidateSkinSettingConditions();
     return;
   }
 
@@ -646,6 +666,7 @@ void CSkinInfo::SetBool(int setting, bool set)
   {
     it->second->value = set;
     m_settingsUpdateHandler->TriggerSave();
+    InvalidateSkinSettingConditions();
     return;
   }
 
@@ -662,6 +683,7 @@ void CSkinInfo::Reset(const std::string &setting)
     {
       it.second->value.clear();
       m_settingsUpdateHandler->TriggerSave();
+      InvalidateSkinSettingConditions();
       return;
     }
   }
@@ -673,6 +695,7 @@ void CSkinInfo::Reset(const std::string &setting)
     {
       it.second->value = false;
       m_settingsUpdateHandler->TriggerSave();
+      InvalidateSkinSettingConditions();
       return;
     }
   }
@@ -688,6 +711,7 @@ void CSkinInfo::Reset()
     it.second->value.clear();
 
   m_settingsUpdateHandler->TriggerSave();
+  InvalidateSkinSettingConditions();
 }
 
 std::set<CSkinSettingPtr> CSkinInfo::ParseSettings(const TiXmlElement* rootElement)
@@ -767,6 +791,7 @@ bool CSkinInfo::SettingsFromXML(const CXBMCTinyXML &doc, bool loadDefaults /* =
                 setting->GetType());
   }
 
+  InvalidateSkinSettingConditions();
   return true;
 }
 
@@ -150,7 +150,24 @@ public:
    */
   static bool TranslateResolution(const std::string &name, RESOLUTION_INFO &res);
 
-  void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
+  void ResolveIncludes(TiXmlElement *node,
+                       std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL,
+                       std::vector<std::string>* includeFiles = nullptr);
+
+  /*! \brief Load an include file a window refers to, if it isn't loaded yet
+   \param file path of the include file
+   */
+  void LoadIncludeFile(const std::string& file);
+
+  /*! \brief Retrieve the include files the skin and its windows have loaded
+   \return paths of the include files
+   */
+  const std::vector<std::string>& GetIncludeFiles() const { return m_includes.GetFiles(); }
+
+  /*! \brief Retrieve the include files loaded with the skin's includes.xml, before any window
+   \return paths of the include files
+   */
+  const std::vector<std::string>& GetSkinIncludeFiles() const { return m_skinIncludeFiles; }
 
   float GetEffectsSlowdown() const { return m_effectsSlowDown; }
 
@@ -221,6 +238,7 @@ protected:
 
   float m_effectsSlowDown;
   CGUIIncludes m_includes;
+  std::vector<std::string> m_skinIncludeFiles;
   std::string m_currentAspect;
 
   std::vector<CStartupWindow> m_startupWindows;
@@ -12,25 +12,44 @@ using namespace AE;
 using namespace ActiveAE;
 #include "ActiveAESettings.h"
 #include "ActiveAESound.h"
+#include "ActiveAESoundBank.h"
 #include "ActiveAEStream.h"
+#include "ActiveAEStreamWorkers.h"
+#include "ActiveAEVizAnalysis.h"
 #include "ServiceBroker.h"
 #include "cores/AudioEngine/Interfaces/IAudioCallback.h"
+#include "cores/AudioEngine/Utils/AEKernels.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/AudioEngine/Utils/AEStreamData.h"
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Encoders/AEEncoderFFmpeg.h"
 
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
-#include "windowing/WinSystem.h"
+#include "utils/CPUInfo.h"
 #include "utils/log.h"
+#include "windowing/WinSystem.h"
+
+#include <algorithm>
+#include <chrono>
 
 using namespace std::chrono_literals;
 
-#define MAX_CACHE_LEVEL 0.4   // total cache time of stream in seconds
-#define MAX_WATER_LEVEL 0.2   // buffered time after stream stages in seconds
-#define MAX_BUFFER_TIME 0.1   // max time of a buffer in seconds
+namespace
+{
+constexpr AEBufferLevels NORMAL_LEVELS = {0.4f, 0.2f, 0.1f};
+// low latency asks the sink for short periods and keeps only a few of them in flight
+constexpr AEBufferLevels LOW_LATENCY_LEVELS = {0.08f, 0.04f, 0.02f};
+// a single stream that isn't resampled only needs enough cache to cover a sink period or two
+constexpr AEBufferLevels SINGLE_STREAM_LEVELS = {0.03f, 0.03f, 0.02f};
+constexpr double LOW_LATENCY_PERIOD = 0.01;
+// threads resampling streams besides the engine thread
+constexpr int MAX_STREAM_WORKERS = 3;
+// smoothing of the measured delay, per sink period
+constexpr float MEASURED_DELAY_WEIGHT = 0.05f;
+} // namespace
 
 void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
 {
@@ -40,6 +59,20 @@ void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
   m_bufferedSamples = 0;
   m_suspended = false;
   m_pcmOutput = pcm;
+  m_measuredDelay = 0.0f;
+  m_measuredPeak = 0.0f;
+}
+
+void CEngineStats::SetLevels(const AEBufferLevels& levels)
+{
+  CSingleLock lock(m_lock);
+  m_levels = levels;
+}
+
+AEBufferLevels CEngineStats::GetLevels()
+{
+  CSingleLock lock(m_lock);
+  return m_levels;
 }
 
 void CEngineStats::UpdateSinkDelay(const AEDelayStatus& status, int samples)
@@ -52,6 +85,18 @@ void CEngineStats::UpdateSinkDelay(const AEDelayStatus& status, int samples)
   }
   else
     m_bufferedSamples -= samples;
+
+  float delay = static_cast<float>(m_sinkDelay.delay) + m_sinkLatency;
+  if (m_pcmOutput)
+    delay += static_cast<float>(m_bufferedSamples) / m_sinkSampleRate;
+  else
+    delay += static_cast<float>(m_bufferedSamples * m_sinkFormat.m_streamInfo.GetDuration()) / 1000;
+
+  if (m_measuredDelay == 0.0f)
+    m_measuredDelay = delay;
+  else
+    m_measuredDelay += (delay - m_measuredDelay) * MEASURED_DELAY_WEIGHT;
+  m_measuredPeak = std::max(m_measuredPeak, delay);
 }
 
 void CEngineStats::AddSamples(int samples, const std::list<CActiveAEStream*>& streams)
@@ -118,22 +163,30 @@ void CEngineStats::UpdateStream(CActiveAEStream *stream)
         str.m_resampleRatio = 1.0;
       }
 
-      CSingleLock lock(stream->m_statsLock);
-      std::deque<CSampleBuffer*>::iterator itBuf;
-      for(itBuf=stream->m_processingSamples.begin(); itBuf!=stream->m_processingSamples.end(); ++itBuf)
-      {
-        if (m_pcmOutput)
-          delay += (float)(*itBuf)->pkt->nb_samples / (*itBuf)->pkt->config.sample_rate;
-        else
-          delay += static_cast<float>(m_sinkFormat.m_streamInfo.GetDuration() / 1000.0);
-      }
       str.m_bufferedTime = static_cast<double>(delay);
-      stream->m_bufferedTime = 0;
       break;
     }
   }
 }
 
+void CEngineStats::ReceiveSamples(CActiveAEStream* stream, int64_t samples)
+{
+  // moving the samples from queued to processing time must look atomic to readers
+  CSingleLock lock(m_lock);
+  stream->m_samplesReceived += samples;
+  UpdateStream(stream);
+}
+
+// samples the stream has written which have not reached the engine yet
+float CEngineStats::GetQueuedTime(CActiveAEStream* stream)
+{
+  const int64_t queued = stream->m_samplesAdded.load() - stream->m_samplesReceived;
+  if (stream->m_format.m_dataFormat == AE_FMT_RAW)
+    return static_cast<float>(queued * stream->m_format.m_streamInfo.GetDuration() / 1000);
+  else
+    return static_cast<float>(queued) / stream->m_format.m_sampleRate;
+}
+
 // this is used to sync a/v so we need to add sink latency here
 void CEngineStats::GetDelay(AEDelayStatus& status, CActiveAEStream *stream)
 {
@@ -149,8 +202,7 @@ void CEngineStats::GetDelay(AEDelayStatus& status, CActiveAEStream *stream)
   {
     if (str.m_streamId == stream->m_id)
     {
-      CSingleLock lock(stream->m_statsLock);
-      float buffertime = static_cast<float>(str.m_bufferedTime) + stream->m_bufferedTime;
+      float buffertime = static_cast<float>(str.m_bufferedTime) + GetQueuedTime(stream);
       status.delay += static_cast<double>(buffertime) / str.m_resampleRatio;
       return;
     }
@@ -174,8 +226,7 @@ void CEngineStats::GetSyncInfo(CAESyncInfo& info, CActiveAEStream *stream)
   {
     if (str.m_streamId == stream->m_id)
     {
-      CSingleLock lock(stream->m_statsLock);
-      float buffertime = static_cast<float>(str.m_bufferedTime) + stream->m_bufferedTime;
+      float buffertime = static_cast<float>(str.m_bufferedTime) + GetQueuedTime(stream);
       status.delay += static_cast<double>(buffertime) / str.m_resampleRatio;
       info.delay = status.GetDelay();
       info.error = str.m_syncError;
@@ -196,8 +247,7 @@ float CEngineStats::GetCacheTime(CActiveAEStream *stream)
   {
     if (str.m_streamId == stream->m_id)
     {
-      CSingleLock lock(stream->m_statsLock);
-      float buffertime = static_cast<float>(str.m_bufferedTime) + stream->m_bufferedTime;
+      float buffertime = static_cast<float>(str.m_bufferedTime) + GetQueuedTime(stream);
       delay += buffertime / static_cast<float>(str.m_resampleRatio);
       break;
     }
@@ -207,13 +257,14 @@ float CEngineStats::GetCacheTime(CActiveAEStream *stream)
 
 float CEngineStats::GetCacheTotal()
 {
-  return MAX_CACHE_LEVEL;
+  CSingleLock lock(m_lock);
+  return m_levels.cache;
 }
 
-float CEngineStats::GetMaxDelay() const
+float CEngineStats::GetMaxDelay()
 {
-  return static_cast<float>(MAX_CACHE_LEVEL) + static_cast<float>(MAX_WATER_LEVEL) +
-         m_sinkCacheTotal;
+  CSingleLock lock(m_lock);
+  return m_levels.cache + m_levels.water + m_sinkCacheTotal;
 }
 
 float CEngineStats::GetWaterLevel()
@@ -249,6 +300,13 @@ AEAudioFormat CEngineStats::GetCurrentSinkFormat()
   return m_sinkFormat;
 }
 
+void CEngineStats::GetMeasuredDelay(float& average, float& peak)
+{
+  CSingleLock lock(m_lock);
+  average = m_measuredDelay;
+  peak = m_measuredPeak;
+}
+
 CActiveAE::CActiveAE() :
   CThread("ActiveAE"),
   m_controlPort("OutputControlPort", &m_inMsgEvent, &m_outMsgEvent),
@@ -271,6 +329,7 @@ CActiveAE::CActiveAE() :
   m_sinkHasVolume = false;
   m_aeGUISoundForce = false;
   m_stats.Reset(44100, true);
+  m_stats.SetLevels(NORMAL_LEVELS);
   m_streamIdGen = 0;
 
   m_settingsHandler.reset(new CActiveAESettings(*this));
@@ -781,21 +840,6 @@ void CActiveAE::StateMachine(int signal, Protocol *port, Message *msg)
           else
             msg->Reply(CActiveAEDataProtocol::ERR);
           return;
-        case CActiveAEDataProtocol::STREAMSAMPLE:
-          MsgStreamSample *msgData;
-          CSampleBuffer *samples;
-          msgData = reinterpret_cast<MsgStreamSample*>(msg->data);
-          samples = msgData->stream->m_processingSamples.front();
-          msgData->stream->m_processingSamples.pop_front();
-          if (samples != msgData->buffer)
-            CLog::Log(LOGERROR, "CActiveAE - inconsistency in stream sample message");
-          if (msgData->buffer->pkt->nb_samples == 0)
-            msgData->buffer->Return();
-          else
-            msgData->stream->m_processingBuffers->m_inputSamples.push_back(msgData->buffer);
-          m_extTimeout = 0ms;
-          m_state = AE_TOP_CONFIGURED_PLAY;
-          return;
         case CActiveAEDataProtocol::FREESTREAM:
           MsgStreamFree *msgStreamFree;
           msgStreamFree = reinterpret_cast<MsgStreamFree*>(msg->data);
@@ -1039,6 +1083,13 @@ void CActiveAE::Process()
   m_extDeferData = false;
   m_extKeepConfig = 0ms;
 
+  int workers = 0;
+  if (CServiceBroker::GetCPUInfo())
+    workers = std::min(CServiceBroker::GetCPUInfo()->GetCPUCount() - 1, MAX_STREAM_WORKERS);
+  m_streamWorkers.reset(new CActiveAEStreamWorkers(std::max(workers, 0)));
+  m_vizAnalysis.reset(new CActiveAEVizAnalysis(m_vizLock, m_vizCallbackLock, m_audioCallback));
+  m_soundBank.reset(new CActiveAESoundBank());
+
   // start sink
   m_sink.Start();
 
@@ -1106,6 +1157,15 @@ void CActiveAE::Process()
       continue;
     }
 
+    // samples of streams, they are queued outside of the data protocol
+    else if (!m_extDeferData && AE_parentStates[m_state] == AE_TOP_CONFIGURED &&
+             ReceiveStreamSamples())
+    {
+      m_extTimeout = 0ms;
+      m_state = AE_TOP_CONFIGURED_PLAY;
+      continue;
+    }
+
     // wait for message
     else if (m_outMsgEvent.Wait(m_extTimeout))
     {
@@ -1127,6 +1187,11 @@ void CActiveAE::Process()
       }
     }
   }
+
+  m_soundBank.reset();
+  ClearDiscardedSounds();
+  m_vizAnalysis.reset();
+  m_streamWorkers.reset();
 }
 
 AEAudioFormat CActiveAE::GetInputFormat(AEAudioFormat *desiredFmt)
@@ -1174,13 +1239,29 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   ApplySettingsToFormat(m_sinkRequestFormat, m_settings, (int*)&m_mode);
   m_extKeepConfig = 0ms;
 
+  // passthrough and the encoder have fixed frame sizes, only pcm output runs low latency
+  bool lowLatency = m_settings.lowLatency;
+  for (auto stream : m_streams)
+  {
+    if (stream->m_lowLatency)
+      lowLatency = true;
+  }
+  lowLatency = lowLatency && m_mode == MODE_PCM;
+
+  // a non zero frame count asks the sink for a period of that size
+  m_sinkRequestFormat.m_frames = 0;
+  if (lowLatency)
+    m_sinkRequestFormat.m_frames = LOW_LATENCY_PERIOD * m_sinkRequestFormat.m_sampleRate;
+
   std::string device = (m_sinkRequestFormat.m_dataFormat == AE_FMT_RAW) ? m_settings.passthroughdevice : m_settings.device;
   std::string driver;
   CAESinkFactory::ParseDevice(device, driver);
   if ((!CompareFormat(m_sinkRequestFormat, m_sinkFormat) && !CompareFormat(m_sinkRequestFormat, oldSinkRequestFormat)) ||
       m_currDevice.compare(device) != 0 ||
-      m_settings.driver.compare(driver) != 0)
+      m_settings.driver.compare(driver) != 0 ||
+      m_lowLatency != lowLatency)
   {
+    m_lowLatency = lowLatency;
     FlushEngine();
     if (!InitSink())
       return;
@@ -1193,13 +1274,14 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     if (m_sinkRequestFormat.m_dataFormat != AE_FMT_RAW)
     {
       // limit buffer size in case of sink returns large buffer
+      const double maxBufferTime = (m_lowLatency ? LOW_LATENCY_LEVELS : NORMAL_LEVELS).period;
       double buffertime = (double)m_sinkFormat.m_frames / m_sinkFormat.m_sampleRate;
-      if (buffertime > MAX_BUFFER_TIME)
+      if (buffertime > maxBufferTime)
       {
         CLog::Log(LOGWARNING,
                   "ActiveAE::{} - sink returned large period time of {} ms, reducing to {} ms",
-                  __FUNCTION__, (int)(buffertime * 1000), (int)(MAX_BUFFER_TIME * 1000));
-        m_sinkFormat.m_frames = MAX_BUFFER_TIME * m_sinkFormat.m_sampleRate;
+                  __FUNCTION__, (int)(buffertime * 1000), (int)(maxBufferTime * 1000));
+        m_sinkFormat.m_frames = maxBufferTime * m_sinkFormat.m_sampleRate;
       }
     }
   }
@@ -1210,6 +1292,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     m_silenceBuffers = NULL;
   }
 
+  AEBufferLevels levels = m_lowLatency ? LOW_LATENCY_LEVELS : NORMAL_LEVELS;
+
   // buffers for driving gui sounds if no streams are active
   if (m_streams.empty())
   {
@@ -1223,7 +1307,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     inputFormat.m_frameSize = inputFormat.m_channelLayout.Count() *
                               (CAEUtil::DataFormatToBits(inputFormat.m_dataFormat) >> 3);
     m_silenceBuffers = new CActiveAEBufferPool(inputFormat);
-    m_silenceBuffers->Create(MAX_WATER_LEVEL*1000);
+    m_stats.SetLevels(levels);
+    m_silenceBuffers->Create(levels.water * 1000);
     sinkInputFormat = inputFormat;
     m_internalFormat = inputFormat;
 
@@ -1303,7 +1388,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         if (!m_encoderBuffers)
         {
           m_encoderBuffers = new CActiveAEBufferPool(format);
-          m_encoderBuffers->Create(MAX_WATER_LEVEL*1000);
+          m_encoderBuffers->Create(levels.water * 1000);
         }
       }
 
@@ -1335,6 +1420,22 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     }
     m_internalFormat = outputFormat;
 
+    // a single stream at the output rate and layout still goes through the stream stages, the
+    // sample format conversion there adds no delay, so the stream cache can be shrunk further
+    if (m_lowLatency && m_streams.size() == 1)
+    {
+      const CActiveAEStream* stream = m_streams.front();
+      if (!stream->m_forceResampler &&
+          stream->m_format.m_sampleRate == outputFormat.m_sampleRate &&
+          stream->m_format.m_channelLayout == outputFormat.m_channelLayout)
+      {
+        CLog::Log(LOGDEBUG, "ActiveAE::{} - single stream without resampling, shrinking the cache",
+                  __FUNCTION__);
+        levels = SINGLE_STREAM_LEVELS;
+      }
+    }
+    m_stats.SetLevels(levels);
+
     std::list<CActiveAEStream*>::iterator it;
     for(it=m_streams.begin(); it!=m_streams.end(); ++it)
     {
@@ -1345,7 +1446,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
         // create buffer pool
         (*it)->m_inputBuffers = new CActiveAEBufferPool((*it)->m_format);
-        (*it)->m_inputBuffers->Create(MAX_CACHE_LEVEL*1000);
+        (*it)->m_inputBuffers->Create(levels.cache * 1000);
         (*it)->m_streamSpace = (*it)->m_format.m_frameSize * (*it)->m_format.m_frames;
 
         // if input format does not follow ffmpeg channel mask, we may need to remap channels
@@ -1361,10 +1462,10 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
       }
       if (!(*it)->m_processingBuffers)
       {
-        (*it)->m_processingBuffers = new CActiveAEStreamBuffers((*it)->m_inputBuffers->m_format, outputFormat, m_settings.resampleQuality);
+        (*it)->m_processingBuffers = new CActiveAEStreamBuffers((*it)->m_inputBuffers->m_format, outputFormat, m_qualityControl.GetQuality());
         (*it)->m_processingBuffers->ForceResampler((*it)->m_forceResampler);
 
-        (*it)->m_processingBuffers->Create(MAX_CACHE_LEVEL*1000, false, m_settings.stereoupmix, m_settings.normalizelevels);
+        (*it)->m_processingBuffers->Create(levels.cache * 1000, false, m_settings.stereoupmix, m_settings.normalizelevels);
       }
       if (m_mode == MODE_TRANSCODE || m_streams.size() > 1)
         (*it)->m_processingBuffers->FillBuffer();
@@ -1401,7 +1502,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         m_vizBuffersInput->Create(2000 + m_stats.GetMaxDelay() * 1000);
 
         // resample buffers
-        m_vizBuffers = new CActiveAEBufferPoolResample(m_internalFormat, vizFormat, m_settings.resampleQuality);
+        m_vizBuffers = new CActiveAEBufferPoolResample(m_internalFormat, vizFormat, m_qualityControl.GetQuality());
         //! @todo use cache of sync + water level
         m_vizBuffers->Create(2000 + m_stats.GetMaxDelay() * 1000, false, false);
         m_vizInitialized = false;
@@ -1425,12 +1526,14 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   if (!m_sinkBuffers)
   {
     m_sinkBuffers = new CActiveAEBufferPoolResample(sinkInputFormat, m_sinkFormat, m_settings.resampleQuality);
-    m_sinkBuffers->Create(MAX_WATER_LEVEL*1000, true, false);
+    m_sinkBuffers->Create(levels.water * 1000, true, false);
   }
 
   // reset gui sounds
   if (!CompareFormat(oldInternalFormat, m_internalFormat))
   {
+    // sounds converted to the old format are of no use anymore
+    m_soundBank->Cancel();
     if (m_settings.guisoundmode == AE_SOUND_ALWAYS ||
        (m_settings.guisoundmode == AE_SOUND_IDLE && m_streams.empty()) ||
        m_aeGUISoundForce)
@@ -1490,6 +1593,9 @@ CActiveAEStream* CActiveAE::CreateStream(MsgStreamNew *streamMsg)
   if (streamMsg->options & AESTREAM_FORCE_RESAMPLE)
     stream->m_forceResampler = true;
 
+  if (streamMsg->options & AESTREAM_LOW_LATENCY)
+    stream->m_lowLatency = true;
+
   stream->m_pClock = streamMsg->clock;
 
   m_streams.push_back(stream);
@@ -1541,11 +1647,12 @@ void CActiveAE::SFlushStream(CActiveAEStream *stream)
   }
   stream->m_processingBuffers->Flush();
   stream->m_streamPort->Purge();
-  stream->m_bufferedTime = 0.0;
+  // the stream waits for the flush to finish, it can't touch its queues meanwhile
+  stream->m_freeQueue.Clear();
+  stream->m_sampleQueue.Clear();
   stream->m_paused = false;
   stream->m_syncState = CAESyncInfo::AESyncState::SYNC_START;
   stream->m_syncError.Flush();
-  stream->ResetFreeBuffers();
 
   // flush the engine if we only have a single stream
   if (m_streams.size() == 1)
@@ -1553,7 +1660,8 @@ void CActiveAE::SFlushStream(CActiveAEStream *stream)
     FlushEngine();
   }
 
-  m_stats.UpdateStream(stream);
+  // whatever the stream had written is gone
+  m_stats.ReceiveSamples(stream, stream->m_samplesAdded.load() - stream->m_samplesReceived);
 }
 
 void CActiveAE::FlushEngine()
@@ -1630,19 +1738,37 @@ void CActiveAE::DiscardSound(CActiveAESound *sound)
   {
     if ((*it) == sound)
     {
+      // the remaining sounds are converted again later
+      if (m_soundBank)
+        m_soundBank->Cancel();
       m_sounds.erase(it);
-      delete sound;
+
+      // the bank may still be reading it
+      if (m_soundBank && m_soundBank->IsBusy())
+        m_discardSounds.push_back(sound);
+      else
+        delete sound;
       return;
     }
   }
 }
 
+void CActiveAE::ClearDiscardedSounds()
+{
+  if (m_soundBank && m_soundBank->IsBusy())
+    return;
+
+  for (auto& sound : m_discardSounds)
+    delete sound;
+  m_discardSounds.clear();
+}
+
 void CActiveAE::ChangeResamplers()
 {
   std::list<CActiveAEStream*>::iterator it;
   for(it=m_streams.begin(); it!=m_streams.end(); ++it)
   {
-    (*it)->m_processingBuffers->ConfigureResampler(m_settings.normalizelevels, m_settings.stereoupmix, m_settings.resampleQuality);
+    (*it)->m_processingBuffers->ConfigureResampler(m_settings.normalizelevels, m_settings.stereoupmix, m_qualityControl.GetQuality());
   }
 }
 
@@ -1892,17 +2018,58 @@ void CActiveAE::UnconfigureSink()
 }
 
 
+bool CActiveAE::ProcessStreams(float period)
+{
+  m_streamJobs.clear();
+  for (auto& stream : m_streams)
+  {
+    if (stream->m_processingBuffers && !stream->m_paused)
+      m_streamJobs.push_back(stream->m_processingBuffers);
+  }
+  if (m_streamJobs.empty())
+    return false;
+
+  const auto start = std::chrono::steady_clock::now();
+  const bool busy = m_streamWorkers->Process(m_streamJobs);
+  const auto end = std::chrono::steady_clock::now();
+
+  // a pass longer than half a sink period eats into the buffered audio of the sink
+  const auto deadline = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<float>(period / 2));
+  if (!m_qualityControl.Update(end, end - start, deadline))
+    return busy;
+
+  const AEQuality quality = m_qualityControl.GetQuality();
+  for (auto& stream : m_streams)
+  {
+    if (stream->m_processingBuffers)
+      stream->m_processingBuffers->SetResampleQuality(quality);
+  }
+  if (m_vizBuffers)
+    m_vizBuffers->SetResampleQuality(quality);
+
+  const AEQualityStats& stats = m_qualityControl.GetStats();
+  CLog::Log(LOGINFO,
+            "CActiveAE::ProcessStreams - stream stage load {:.0f}%, resample quality {} "
+            "(setting {}), lowered {} times, late windows {}, dropouts avoided {}",
+            stats.load * 100, static_cast<int>(quality),
+            static_cast<int>(m_qualityControl.GetUserQuality()), stats.degradations,
+            stats.lateWindows, stats.dropoutsAvoided);
+  return busy;
+}
+
 bool CActiveAE::RunStages()
 {
   bool busy = false;
 
+  const AEBufferLevels levels = m_stats.GetLevels();
+
   // serve input streams
+  busy = ProcessStreams(levels.period);
+
   std::list<CActiveAEStream*>::iterator it;
   for (it = m_streams.begin(); it != m_streams.end(); ++it)
   {
-    if ((*it)->m_processingBuffers && !(*it)->m_paused)
-      busy = (*it)->m_processingBuffers->ProcessBuffers();
-
     if ((*it)->m_streamIsBuffering &&
         (*it)->m_processingBuffers &&
         ((*it)->m_processingBuffers->HasInputLevel(50)))
@@ -1919,15 +2086,20 @@ bool CActiveAE::RunStages()
       float buftime = (float)(*it)->m_inputBuffers->m_format.m_frames / (*it)->m_inputBuffers->m_format.m_sampleRate;
       if ((*it)->m_inputBuffers->m_format.m_dataFormat == AE_FMT_RAW)
         buftime = (*it)->m_inputBuffers->m_format.m_streamInfo.GetDuration() / 1000;
-      while ((time < static_cast<float>(MAX_CACHE_LEVEL) || (*it)->m_streamIsBuffering) &&
-             !(*it)->m_inputBuffers->m_freeSamples.empty())
+      bool queued = false;
+      // the stream queues can't overflow as long as no more buffers are out than they hold
+      while ((time < levels.cache || (*it)->m_streamIsBuffering) &&
+             !(*it)->m_inputBuffers->m_freeSamples.empty() &&
+             (*it)->m_processingSamples.size() < (*it)->m_freeQueue.Capacity())
       {
         buffer = (*it)->m_inputBuffers->GetFreeBuffer();
         (*it)->m_processingSamples.push_back(buffer);
-        (*it)->m_streamPort->SendInMessage(CActiveAEDataProtocol::STREAMBUFFER, &buffer, sizeof(CSampleBuffer*));
-        (*it)->IncFreeBuffers();
+        (*it)->m_freeQueue.Push(buffer);
         time += buftime;
+        queued = true;
       }
+      if (queued)
+        (*it)->m_inMsgEvent.Set();
     }
     else
     {
@@ -1959,7 +2131,7 @@ bool CActiveAE::RunStages()
     }
   }
 
-  if (m_stats.GetWaterLevel() < static_cast<float>(MAX_WATER_LEVEL) &&
+  if (m_stats.GetWaterLevel() < levels.water &&
       (m_mode != MODE_TRANSCODE || (m_encoderBuffers && !m_encoderBuffers->m_freeSamples.empty())))
   {
     // calculate sync error
@@ -2027,6 +2199,7 @@ bool CActiveAE::RunStages()
           allStreamsReady = false;
       }
 
+      const AEKernels& kernels = AEKernels::Get();
       bool needClamp = false;
       for (it = m_streams.begin(); it != m_streams.end() && allStreamsReady; ++it)
       {
@@ -2052,8 +2225,7 @@ bool CActiveAE::RunStages()
             (*it)->m_processingBuffers->m_outputSamples.pop_front();
 
             int nb_floats = out->pkt->nb_samples * out->pkt->config.channels / out->pkt->planes;
-            int nb_loops = 1;
-            float fadingStep = 0.0f;
+            bool perFrame = false;
 
             // fading
             if ((*it)->m_fadingSamples == -1)
@@ -2069,13 +2241,7 @@ bool CActiveAE::RunStages()
               }
             }
             if ((*it)->m_fadingSamples > 0)
-            {
-              nb_floats = out->pkt->config.channels / out->pkt->planes;
-              nb_loops = out->pkt->nb_samples;
-              float delta = (*it)->m_fadingTarget - (*it)->m_fadingBase;
-              int samples = m_internalFormat.m_sampleRate * (float)(*it)->m_fadingTime / 1000.0f;
-              fadingStep = delta / samples;
-            }
+              perFrame = true;
 
             // for stream amplification,
             // turned off downmix normalization,
@@ -2084,42 +2250,21 @@ bool CActiveAE::RunStages()
             if ((*it)->m_amplify != 1.0f || !(*it)->m_processingBuffers->DoesNormalize() ||
                 (m_sinkFormat.m_dataFormat == AE_FMT_FLOAT))
             {
-              nb_floats = out->pkt->config.channels / out->pkt->planes;
-              nb_loops = out->pkt->nb_samples;
+              perFrame = true;
             }
 
-            for(int i=0; i<nb_loops; i++)
+            if (perFrame)
+            {
+              const float* gain = GetStreamGain(*it, out);
+              for(int j=0; j<out->pkt->planes; j++)
+                kernels.MulFrames((float*)out->pkt->data[j], gain, out->pkt->nb_samples,
+                                  out->pkt->config.channels / out->pkt->planes);
+            }
+            else
             {
-              if ((*it)->m_fadingSamples > 0)
-              {
-                (*it)->m_volume += fadingStep;
-                (*it)->m_fadingSamples--;
-
-                if ((*it)->m_fadingSamples == 0)
-                {
-                  // set variables being polled via stream interface
-                  CSingleLock lock((*it)->m_streamLock);
-                  (*it)->m_streamFading = false;
-                }
-              }
-
-              // volume for stream
               float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)out->pkt->data, out->pkt->config.channels, i*nb_floats, out->pkt->planes > 1);
-
               for(int j=0; j<out->pkt->planes; j++)
-              {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
-              }
+                kernels.Mul((float*)out->pkt->data[j], volume, nb_floats);
             }
           }
           else
@@ -2129,8 +2274,7 @@ bool CActiveAE::RunStages()
             (*it)->m_processingBuffers->m_outputSamples.pop_front();
 
             int nb_floats = mix->pkt->nb_samples * mix->pkt->config.channels / mix->pkt->planes;
-            int nb_loops = 1;
-            float fadingStep = 0.0f;
+            bool perFrame = false;
 
             // fading
             if ((*it)->m_fadingSamples == -1)
@@ -2139,65 +2283,29 @@ bool CActiveAE::RunStages()
               (*it)->m_volume = (*it)->m_fadingBase;
             }
             if ((*it)->m_fadingSamples > 0)
-            {
-              nb_floats = mix->pkt->config.channels / mix->pkt->planes;
-              nb_loops = mix->pkt->nb_samples;
-              float delta = (*it)->m_fadingTarget - (*it)->m_fadingBase;
-              int samples = m_internalFormat.m_sampleRate * (float)(*it)->m_fadingTime / 1000.0f;
-              fadingStep = delta / samples;
-            }
+              perFrame = true;
 
             // for streams amplification of turned off downmix normalization
             // we need to run on a per sample basis
             if ((*it)->m_amplify != 1.0f || !(*it)->m_processingBuffers->DoesNormalize())
-            {
-              nb_floats = out->pkt->config.channels / out->pkt->planes;
-              nb_loops = out->pkt->nb_samples;
-            }
+              perFrame = true;
 
-            for(int i=0; i<nb_loops; i++)
+            for(int j=0; j<out->pkt->planes && j<mix->pkt->planes; j++)
             {
-              if ((*it)->m_fadingSamples > 0)
+              float *dst = (float*)out->pkt->data[j];
+              float *src = (float*)mix->pkt->data[j];
+              if (perFrame)
               {
-                (*it)->m_volume += fadingStep;
-                (*it)->m_fadingSamples--;
-
-                if ((*it)->m_fadingSamples == 0)
-                {
-                  // set variables being polled via stream interface
-                  CSingleLock lock((*it)->m_streamLock);
-                  (*it)->m_streamFading = false;
-                }
+                // gain is computed once for all planes
+                const float* gain = j == 0 ? GetStreamGain(*it, mix) : m_streamGain.data();
+                kernels.MulAddFrames(dst, src, gain, mix->pkt->nb_samples,
+                                     mix->pkt->config.channels / mix->pkt->planes);
               }
+              else
+                kernels.MulAdd(dst, src, (*it)->m_volume * (*it)->m_rgain, nb_floats);
 
-              // volume for stream
-              float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)mix->pkt->data, mix->pkt->config.channels, i*nb_floats, mix->pkt->planes > 1);
-
-              for(int j=0; j<out->pkt->planes && j<mix->pkt->planes; j++)
-              {
-                float *dst = (float*)out->pkt->data[j]+i*nb_floats;
-                float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
-              }
+              if (kernels.MaxAbs(dst, nb_floats) > 1.0f)
+                needClamp = true;
             }
             mix->Return();
           }
@@ -2260,8 +2368,9 @@ bool CActiveAE::RunStages()
               {
                 unsigned int samples = static_cast<unsigned int>(buf->pkt->nb_samples) *
                                        buf->pkt->config.channels / buf->pkt->planes;
-                for (auto& it : m_audioCallback)
-                  it->OnAudioData((float*)(buf->pkt->data[0]), samples);
+                if (!m_vizAnalysis->Add(reinterpret_cast<float*>(buf->pkt->data[0]), samples))
+                  CLog::Log(LOGDEBUG, "ActiveAE::{} - viz analysis is behind, dropped a block",
+                            __FUNCTION__);
                 buf->Return();
                 m_vizBuffers->m_outputSamples.pop_front();
               }
@@ -2343,6 +2452,34 @@ bool CActiveAE::RunStages()
   return busy;
 }
 
+bool CActiveAE::ReceiveStreamSamples()
+{
+  bool received = false;
+  for (auto stream : m_streams)
+  {
+    int64_t samples = 0;
+    CSampleBuffer* buffer;
+    while (stream->m_sampleQueue.Pop(buffer))
+    {
+      CSampleBuffer* expected = stream->m_processingSamples.front();
+      stream->m_processingSamples.pop_front();
+      if (expected != buffer)
+        CLog::Log(LOGERROR, "CActiveAE - inconsistency in stream sample queue");
+      if (buffer->pkt->nb_samples == 0)
+        buffer->Return();
+      else
+      {
+        samples += stream->m_format.m_dataFormat == AE_FMT_RAW ? 1 : buffer->pkt->nb_samples;
+        stream->m_processingBuffers->m_inputSamples.push_back(buffer);
+      }
+      received = true;
+    }
+    if (samples)
+      m_stats.ReceiveSamples(stream, samples);
+  }
+  return received;
+}
+
 bool CActiveAE::HasWork()
 {
   if (!m_sounds_playing.empty())
@@ -2562,6 +2699,8 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
   if (m_sounds_playing.empty())
     return;
 
+  InstallSoundBank();
+
   float volume;
   float *out;
   float *sample_buffer;
@@ -2585,12 +2724,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      AEKernels::Get().MulAdd(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2615,15 +2749,50 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      AEKernels::Get().Mul(buffer, volume, nb_floats);
+    }
+  }
+}
+
+const float* CActiveAE::GetStreamGain(CActiveAEStream* stream, CSampleBuffer* buffer)
+{
+  const int frames = buffer->pkt->nb_samples;
+  if (static_cast<int>(m_streamGain.size()) < frames)
+    m_streamGain.resize(frames);
+  float* gain = m_streamGain.data();
+
+  // limiter looks at the samples before any volume is applied
+  stream->m_limiter.RunFrames(reinterpret_cast<float**>(buffer->pkt->data),
+                              buffer->pkt->config.channels, frames, buffer->pkt->planes > 1,
+                              gain);
+
+  float fadingStep = 0.0f;
+  if (stream->m_fadingSamples > 0)
+  {
+    float delta = stream->m_fadingTarget - stream->m_fadingBase;
+    int samples = m_internalFormat.m_sampleRate * (float)stream->m_fadingTime / 1000.0f;
+    fadingStep = delta / samples;
+  }
+
+  for (int i = 0; i < frames; i++)
+  {
+    if (stream->m_fadingSamples > 0)
+    {
+      stream->m_volume += fadingStep;
+      stream->m_fadingSamples--;
+
+      if (stream->m_fadingSamples == 0)
+      {
+        // set variables being polled via stream interface
+        CSingleLock lock(stream->m_streamLock);
+        stream->m_streamFading = false;
+      }
     }
+
+    // volume for stream
+    gain[i] *= stream->m_volume * stream->m_rgain;
   }
+  return gain;
 }
 
 //-----------------------------------------------------------------------------
@@ -2658,9 +2827,13 @@ void CActiveAE::LoadSettings()
       settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_DTSHDCOREFALLBACK);
 
   m_settings.resampleQuality = static_cast<AEQuality>(settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_PROCESSQUALITY));
+  if (m_qualityControl.GetUserQuality() != m_settings.resampleQuality)
+    m_qualityControl.Reset(m_settings.resampleQuality);
   m_settings.atempoThreshold = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_ATEMPOTHRESHOLD) / 100.0;
   m_settings.streamNoise = settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_STREAMNOISE);
   m_settings.silenceTimeout = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_STREAMSILENCE) * 60000;
+  m_settings.lowLatency =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioLowLatency;
 }
 
 void CActiveAE::Start()
@@ -3195,23 +3368,52 @@ void CActiveAE::StopSound(CActiveAESound *sound)
  * resample sounds to destination format for mixing
  * destination format is either format of stream or
  * default sink format when no stream is playing
+ * all sounds not converted yet are handed to the sound bank,
+ * which converts them off the engine thread
  */
 void CActiveAE::ResampleSounds()
 {
+  InstallSoundBank();
+  ClearDiscardedSounds();
+
   if ((m_settings.guisoundmode == AE_SOUND_OFF ||
       (m_settings.guisoundmode == AE_SOUND_IDLE && !m_streams.empty())) &&
       !m_aeGUISoundForce)
     return;
 
-  std::vector<CActiveAESound*>::iterator it;
-  for (it = m_sounds.begin(); it != m_sounds.end(); ++it)
+  if (m_mode == MODE_RAW || m_internalFormat.m_dataFormat == AE_FMT_INVALID)
+    return;
+
+  if (m_soundBank->IsBusy())
+    return;
+
+  std::vector<CActiveAESound*> sounds;
+  for (auto& sound : m_sounds)
   {
-    if (!(*it)->IsConverted())
+    if (!sound->IsConverted())
+      sounds.push_back(sound);
+  }
+  if (!sounds.empty())
+    m_soundBank->Build(sounds, m_internalFormat, m_settings.resampleQuality);
+}
+
+void CActiveAE::InstallSoundBank()
+{
+  std::unique_ptr<CActiveAESoundBank::Bank> bank = m_soundBank->Take();
+  if (!bank)
+    return;
+
+  // a sound converted while it waited keeps its packet until it stopped playing
+  for (auto& entry : bank->entries)
+  {
+    bool playing = false;
+    for (auto& state : m_sounds_playing)
     {
-      ResampleSound(*it);
-      // only do one sound, then yield to main loop
-      break;
+      if (state.sound == entry.sound)
+        playing = entry.sound->IsConverted();
     }
+    if (!playing)
+      entry.sound->SetBankSound(entry.packet.release(), bank->storage);
   }
 }
 
@@ -3462,6 +3664,8 @@ void CActiveAE::RegisterAudioCallback(IAudioCallback* pCallback)
 
 void CActiveAE::UnregisterAudioCallback(IAudioCallback* pCallback)
 {
+  // wait for the viz analysis to leave the callback, the caller may delete it
+  CSingleLock callbackLock(m_vizCallbackLock);
   CSingleLock lock(m_vizLock);
   auto it = std::find(m_audioCallback.begin(), m_audioCallback.end(), pCallback);
   if (it != m_audioCallback.end())
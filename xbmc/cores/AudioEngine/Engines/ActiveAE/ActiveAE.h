@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "ActiveAEQualityControl.h"
 #include "ActiveAESink.h"
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
 #include "cores/AudioEngine/Interfaces/AESound.h"
@@ -17,6 +18,7 @@
 #include "threads/Thread.h"
 
 #include <list>
+#include <memory>
 #include <queue>
 #include <string>
 #include <utility>
@@ -37,6 +39,10 @@ namespace ActiveAE
 
 class CActiveAESound;
 class CActiveAEStream;
+class CActiveAESoundBank;
+class CActiveAEStreamBuffers;
+class CActiveAEStreamWorkers;
+class CActiveAEVizAnalysis;
 class CActiveAESettings;
 
 struct AudioSettings
@@ -62,6 +68,7 @@ struct AudioSettings
   double atempoThreshold;
   bool streamNoise;
   int silenceTimeout;
+  bool lowLatency;
 };
 
 class CActiveAEControlProtocol : public Protocol
@@ -120,14 +127,12 @@ public:
     FREESOUND,
     NEWSTREAM,
     FREESTREAM,
-    STREAMSAMPLE,
     DRAINSTREAM,
   };
   enum InSignal
   {
     ACC,
     ERR,
-    STREAMBUFFER,
     STREAMDRAINED,
   };
 };
@@ -145,12 +150,6 @@ struct MsgStreamFree
   bool finish; // if true switch back to gui sound mode
 };
 
-struct MsgStreamSample
-{
-  CSampleBuffer *buffer;
-  CActiveAEStream *stream;
-};
-
 struct MsgStreamParameter
 {
   CActiveAEStream *stream;
@@ -178,21 +177,34 @@ struct MsgStreamFFmpegInfo
   enum AVAudioServiceType audio_service_type;
 };
 
+/*!
+ * \brief Buffer times in seconds the engine works with.
+ */
+struct AEBufferLevels
+{
+  float cache; //!< total cache time of a stream
+  float water; //!< buffered time after the stream stages
+  float period; //!< max time of a sink period
+};
+
 class CEngineStats
 {
 public:
   void Reset(unsigned int sampleRate, bool pcm);
+  void SetLevels(const AEBufferLevels& levels);
+  AEBufferLevels GetLevels();
   void UpdateSinkDelay(const AEDelayStatus& status, int samples);
   void AddSamples(int samples, const std::list<CActiveAEStream*>& streams);
   void GetDelay(AEDelayStatus& status);
   void AddStream(unsigned int streamid);
   void RemoveStream(unsigned int streamid);
   void UpdateStream(CActiveAEStream *stream);
+  void ReceiveSamples(CActiveAEStream* stream, int64_t samples);
   void GetDelay(AEDelayStatus& status, CActiveAEStream *stream);
   void GetSyncInfo(CAESyncInfo& info, CActiveAEStream *stream);
   float GetCacheTime(CActiveAEStream *stream);
   float GetCacheTotal();
-  float GetMaxDelay() const;
+  float GetMaxDelay();
   float GetWaterLevel();
   void SetSuspended(bool state);
   void SetCurrentSinkFormat(const AEAudioFormat& SinkFormat);
@@ -200,7 +212,17 @@ public:
   void SetSinkLatency(float time) { m_sinkLatency = time; }
   bool IsSuspended();
   AEAudioFormat GetCurrentSinkFormat();
+
+  /*!
+   * \brief Output delay of the engine as measured at the sink: buffered time after the
+   * stream stages, sink buffer and sink latency. Reset with the sink.
+   * \param average smoothed delay of the last few hundred milliseconds
+   * \param peak largest delay seen
+   */
+  void GetMeasuredDelay(float& average, float& peak);
 protected:
+  float GetQueuedTime(CActiveAEStream* stream);
+
   float m_sinkCacheTotal;
   float m_sinkLatency;
   int m_bufferedSamples;
@@ -209,6 +231,9 @@ protected:
   bool m_suspended;
   AEAudioFormat m_sinkFormat;
   bool m_pcmOutput;
+  AEBufferLevels m_levels;
+  float m_measuredDelay = 0.0f;
+  float m_measuredPeak = 0.0f;
   CCriticalSection m_lock;
   struct StreamStats
   {
@@ -273,6 +298,8 @@ public:
   void OnResetDisplay() override;
   void OnAppFocusChange(bool focus) override;
 
+  void GetMeasuredDelay(float& average, float& peak) { m_stats.GetMeasuredDelay(average, peak); }
+
 private:
   bool FreeStream(IAEStream* stream, bool finish) override;
   void FreeSound(IAESound* sound) override;
@@ -319,16 +346,21 @@ protected:
   void ClearDiscardedBuffers();
   void SStopSound(CActiveAESound *sound);
   void DiscardSound(CActiveAESound *sound);
+  void ClearDiscardedSounds();
   void ChangeResamplers();
 
   bool RunStages();
+  bool ProcessStreams(float period);
+  bool ReceiveStreamSamples();
   bool HasWork();
   CSampleBuffer* SyncStream(CActiveAEStream *stream);
 
   void ResampleSounds();
   bool ResampleSound(CActiveAESound *sound);
+  void InstallSoundBank();
   void MixSounds(CSoundPacket &dstSample);
   void Deamplify(CSoundPacket &dstSample);
+  const float* GetStreamGain(CActiveAEStream* stream, CSampleBuffer* buffer);
 
   bool CompareFormat(const AEAudioFormat& lhs, const AEAudioFormat& rhs);
 
@@ -363,6 +395,7 @@ protected:
   AEAudioFormat m_inputFormat;
   AudioSettings m_settings;
   CEngineStats m_stats;
+  bool m_lowLatency = false;
   IAEEncoder *m_encoder;
   std::string m_currDevice;
   std::unique_ptr<CActiveAESettings> m_settingsHandler;
@@ -378,6 +411,9 @@ protected:
   std::list<CActiveAEStream*> m_streams;
   std::list<CActiveAEBufferPool*> m_discardBufferPools;
   unsigned int m_streamIdGen;
+  std::unique_ptr<CActiveAEStreamWorkers> m_streamWorkers;
+  std::vector<CActiveAEStreamBuffers*> m_streamJobs;
+  CActiveAEQualityControl m_qualityControl;
 
   // gui sounds
   struct SoundState
@@ -387,6 +423,9 @@ protected:
   };
   std::list<SoundState> m_sounds_playing;
   std::vector<CActiveAESound*> m_sounds;
+  std::vector<CActiveAESound*> m_discardSounds; //!< deleted once the sound bank is idle
+  std::unique_ptr<CActiveAESoundBank> m_soundBank;
+  std::vector<float> m_streamGain; ///< per frame gain of the stream being mixed
 
   float m_volume; // volume on a 0..1 scale corresponding to a proportion along the dB scale
   float m_volumeScaled; // multiplier to scale samples in order to achieve the volume specified in m_volume
@@ -397,6 +436,8 @@ protected:
   std::vector<IAudioCallback*> m_audioCallback;
   bool m_vizInitialized;
   CCriticalSection m_vizLock;
+  CCriticalSection m_vizCallbackLock; ///< held by the viz analysis while calling the callbacks
+  std::unique_ptr<CActiveAEVizAnalysis> m_vizAnalysis;
 
   // polled via the interface
   float m_aeVolume;
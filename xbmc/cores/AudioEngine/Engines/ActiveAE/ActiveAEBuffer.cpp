@@ -23,10 +23,36 @@ CSoundPacket::CSoundPacket(SampleConfig conf, int samples) : config(conf)
   pause_burst_ms = 0;
 }
 
+CSoundPacket::CSoundPacket(SampleConfig conf, int samples, uint8_t* buffer) : config(conf)
+{
+  planes = av_sample_fmt_is_planar(config.fmt) ? config.channels : 1;
+  bytes_per_sample = av_get_bytes_per_sample(config.fmt);
+  linesize = BufferSize(config, samples) / planes;
+  data = new uint8_t*[planes];
+  for (int i = 0; i < planes; i++)
+    data[i] = buffer + i * linesize;
+  max_nb_samples = samples;
+  nb_samples = 0;
+  pause_burst_ms = 0;
+  m_ownsData = false;
+}
+
 CSoundPacket::~CSoundPacket()
 {
-  if (data)
+  if (!data)
+    return;
+
+  if (m_ownsData)
     CActiveAE::FreeSoundSample(data);
+  else
+    delete[] data;
+}
+
+int CSoundPacket::BufferSize(const SampleConfig& conf, int samples)
+{
+  const int planes = av_sample_fmt_is_planar(conf.fmt) ? conf.channels : 1;
+  const int bytes = samples * av_get_bytes_per_sample(conf.fmt) * conf.channels / planes;
+  return FFALIGN(bytes, 32) * planes;
 }
 
 CSampleBuffer::~CSampleBuffer()
@@ -378,6 +404,16 @@ void CActiveAEBufferPoolResample::ConfigureResampler(bool normalizelevels, bool
   m_normalize = normalize;
 }
 
+void CActiveAEBufferPoolResample::SetResampleQuality(AEQuality quality)
+{
+  if (m_resampleQuality == quality)
+    return;
+
+  m_resampleQuality = quality;
+  if (m_resampler)
+    m_changeResampler = true;
+}
+
 float CActiveAEBufferPoolResample::GetDelay()
 {
   float delay = 0;
@@ -29,7 +29,15 @@ class CSoundPacket
 {
 public:
   CSoundPacket(SampleConfig conf, int samples);
+  /*!
+   * \brief Packet on storage owned by the caller, laid out as BufferSize() describes.
+   */
+  CSoundPacket(SampleConfig conf, int samples, uint8_t* buffer);
   ~CSoundPacket();
+
+  //! bytes of storage a packet of the given format and size needs, planes aligned to 32
+  static int BufferSize(const SampleConfig& conf, int samples);
+
   uint8_t **data;                        // array with pointers to planes of data
   SampleConfig config;
   int bytes_per_sample;                  // bytes per sample and per channel
@@ -38,6 +46,9 @@ public:
   int nb_samples;                        // number of frames used
   int max_nb_samples;                    // max number of frames this packet can hold
   int pause_burst_ms;
+
+private:
+  bool m_ownsData = true;
 };
 
 class CActiveAEBufferPool;
@@ -81,6 +92,10 @@ public:
   bool Create(unsigned int totaltime, bool remap, bool upmix, bool normalize = true);
   bool ResampleBuffers(int64_t timestamp = 0);
   void ConfigureResampler(bool normalizelevels, bool stereoupmix, AEQuality quality);
+  /*!
+   * \brief Change the quality of a running resampler, does not create one.
+   */
+  void SetResampleQuality(AEQuality quality);
   float GetDelay();
   void Flush();
   void SetDrain(bool drain);
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAEQualityControl.h"
+
+#include <algorithm>
+
+using namespace ActiveAE;
+
+void CActiveAEQualityControl::Reset(AEQuality quality)
+{
+  m_userQuality = quality;
+  m_quality = quality;
+  m_windowStart = clock::time_point();
+  m_processTime = clock::duration::zero();
+  m_late = false;
+  m_lateDegrade = false;
+  m_calmWindows = 0;
+  m_restoreWindows = RESTORE_WINDOWS;
+  m_sinceRestore = MAX_RESTORE_WINDOWS;
+}
+
+bool CActiveAEQualityControl::Update(clock::time_point now,
+                                     clock::duration processTime,
+                                     clock::duration deadline)
+{
+  if (m_windowStart == clock::time_point())
+    m_windowStart = now - processTime;
+
+  m_processTime += processTime;
+  m_late |= processTime > deadline;
+
+  const clock::duration elapsed = now - m_windowStart;
+  if (elapsed < WINDOW)
+    return false;
+
+  const float load = std::chrono::duration<float>(m_processTime) /
+                     std::chrono::duration<float>(elapsed);
+  const bool late = m_late;
+  m_windowStart = now;
+  m_processTime = clock::duration::zero();
+  m_late = false;
+
+  return Evaluate(load, late);
+}
+
+bool CActiveAEQualityControl::Evaluate(float load, bool late)
+{
+  m_stats.load = load;
+  m_stats.peakLoad = std::max(m_stats.peakLoad, load);
+  if (late)
+    m_stats.lateWindows++;
+
+  // the engine fell behind, lowering the quality got it back on time
+  if (m_lateDegrade && !late)
+    m_stats.dropoutsAvoided++;
+  m_lateDegrade = false;
+
+  if (m_sinceRestore < MAX_RESTORE_WINDOWS)
+    m_sinceRestore++;
+
+  if (late || load > DEGRADE_LOAD)
+  {
+    m_calmWindows = 0;
+    const AEQuality lower = Lower(m_quality);
+    if (lower == m_quality)
+      return false;
+
+    if (m_sinceRestore <= m_restoreWindows)
+      m_restoreWindows = std::min(m_restoreWindows * 2, MAX_RESTORE_WINDOWS);
+    else
+      m_restoreWindows = RESTORE_WINDOWS;
+
+    m_quality = lower;
+    m_lateDegrade = late;
+    m_stats.degradations++;
+    return true;
+  }
+
+  if (!IsDegraded())
+    return false;
+
+  if (load > RESTORE_LOAD)
+  {
+    m_calmWindows = 0;
+    return false;
+  }
+
+  if (++m_calmWindows < m_restoreWindows)
+    return false;
+
+  m_calmWindows = 0;
+  m_sinceRestore = 0;
+  m_quality = std::min(Raise(m_quality), m_userQuality);
+  m_stats.restores++;
+  return true;
+}
+
+AEQuality CActiveAEQualityControl::Lower(AEQuality quality)
+{
+  // other levels leave swr at its defaults, which are as cheap as low
+  switch (quality)
+  {
+    case AE_QUALITY_HIGH:
+      return AE_QUALITY_MID;
+    case AE_QUALITY_MID:
+      return AE_QUALITY_LOW;
+    default:
+      return quality;
+  }
+}
+
+AEQuality CActiveAEQualityControl::Raise(AEQuality quality)
+{
+  switch (quality)
+  {
+    case AE_QUALITY_LOW:
+      return AE_QUALITY_MID;
+    case AE_QUALITY_MID:
+      return AE_QUALITY_HIGH;
+    default:
+      return quality;
+  }
+}
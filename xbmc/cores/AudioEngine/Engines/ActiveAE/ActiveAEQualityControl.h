@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AE.h"
+
+#include <chrono>
+
+namespace ActiveAE
+{
+
+struct AEQualityStats
+{
+  unsigned int degradations = 0; //!< times the quality was lowered
+  unsigned int restores = 0; //!< times it was raised again
+  unsigned int lateWindows = 0; //!< windows in which a pass missed its deadline
+  unsigned int dropoutsAvoided = 0; //!< late windows followed by one on time at lower quality
+  float load = 0.0f; //!< share of the engine thread taken by the stream stage, last window
+  float peakLoad = 0.0f;
+};
+
+/*!
+ * \brief Picks the resample quality of the stream stage from the time it takes.
+ *
+ * The engine reports every pass of the stream stage. Once per window the quality drops
+ * one step if the stage took more than half of the engine thread or a single pass missed
+ * its deadline. After a calm period it rises one step back towards the
+ * quality the user configured. A degradation shortly after a restore doubles the calm
+ * period needed for the next one, so a box at its limit does not toggle forever.
+ */
+class CActiveAEQualityControl
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  static constexpr clock::duration WINDOW = std::chrono::milliseconds(500);
+  static constexpr float DEGRADE_LOAD = 0.5f;
+  static constexpr float RESTORE_LOAD = 0.2f;
+  static constexpr unsigned int RESTORE_WINDOWS = 20;
+  static constexpr unsigned int MAX_RESTORE_WINDOWS = 320;
+
+  /*!
+   * \brief Start over at the given quality, keeps the statistics.
+   */
+  void Reset(AEQuality quality);
+
+  /*!
+   * \brief Account a pass of the stream stage.
+   * \param now end of the pass
+   * \param processTime time the pass took
+   * \param deadline time the pass may take without starving the sink
+   * \return true if GetQuality() changed
+   */
+  bool Update(clock::time_point now, clock::duration processTime, clock::duration deadline);
+
+  AEQuality GetQuality() const { return m_quality; }
+  AEQuality GetUserQuality() const { return m_userQuality; }
+  bool IsDegraded() const { return m_quality != m_userQuality; }
+  const AEQualityStats& GetStats() const { return m_stats; }
+
+protected:
+  bool Evaluate(float load, bool late);
+  static AEQuality Lower(AEQuality quality);
+  static AEQuality Raise(AEQuality quality);
+
+  AEQuality m_userQuality = AE_QUALITY_DEFAULT;
+  AEQuality m_quality = AE_QUALITY_DEFAULT;
+  AEQualityStats m_stats;
+
+  clock::time_point m_windowStart;
+  clock::duration m_processTime = clock::duration::zero();
+  bool m_late = false;
+
+  bool m_lateDegrade = false;
+  unsigned int m_calmWindows = 0;
+  unsigned int m_restoreWindows = RESTORE_WINDOWS;
+  unsigned int m_sinceRestore = MAX_RESTORE_WINDOWS;
+};
+
+} // namespace ActiveAE
@@ -67,12 +67,22 @@ uint8_t** CActiveAESound::InitSound(bool orig, SampleConfig config, int nb_sampl
 
   delete *info;
   *info = new CSoundPacket(config, nb_samples);
+  if (!orig)
+    m_bankStorage.reset();
 
   (*info)->nb_samples = 0;
   m_isConverted = false;
   return (*info)->data;
 }
 
+void CActiveAESound::SetBankSound(CSoundPacket* packet, std::shared_ptr<uint8_t> storage)
+{
+  delete m_dst_sound;
+  m_dst_sound = packet;
+  m_bankStorage = std::move(storage);
+  m_isConverted = true;
+}
+
 bool CActiveAESound::StoreSound(bool orig, uint8_t **buffer, int samples, int linesize)
 {
   CSoundPacket **info;
@@ -12,6 +12,8 @@
 #include "cores/AudioEngine/Interfaces/AESound.h"
 #include "filesystem/File.h"
 
+#include <memory>
+
 class DllAvUtil;
 
 namespace ActiveAE
@@ -37,6 +39,11 @@ public:
   uint8_t** InitSound(bool orig, SampleConfig config, int nb_samples);
   bool StoreSound(bool orig, uint8_t **buffer, int samples, int linesize);
   CSoundPacket *GetSound(bool orig);
+  /*!
+   * \brief Take a converted sound that lives in a sound bank, engine thread only.
+   * \param storage the bank, kept alive as long as the sound refers to it
+   */
+  void SetBankSound(CSoundPacket* packet, std::shared_ptr<uint8_t> storage);
 
   bool IsConverted() { return m_isConverted; }
   void SetConverted(bool state) { m_isConverted = state; }
@@ -61,6 +68,7 @@ protected:
 
   CSoundPacket *m_orig_sound;
   CSoundPacket *m_dst_sound;
+  std::shared_ptr<uint8_t> m_bankStorage;
 
   bool m_isConverted;
 };
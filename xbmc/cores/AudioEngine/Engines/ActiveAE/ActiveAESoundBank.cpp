@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAESoundBank.h"
+
+#include "ActiveAEBuffer.h"
+#include "ActiveAESound.h"
+#include "cores/AudioEngine/AEResampleFactory.h"
+#include "cores/AudioEngine/Interfaces/AEResample.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <cmath>
+
+extern "C" {
+#include <libavutil/mem.h>
+}
+
+using namespace ActiveAE;
+
+CActiveAESoundBank::CActiveAESoundBank() : CThread("ActiveAESounds")
+{
+  Create();
+}
+
+CActiveAESoundBank::~CActiveAESoundBank()
+{
+  m_generation++;
+  StopThread();
+}
+
+bool CActiveAESoundBank::Build(const std::vector<CActiveAESound*>& sounds,
+                               const AEAudioFormat& format,
+                               AEQuality quality)
+{
+  if (m_busy || m_ready)
+    return false;
+
+  CSingleLock lock(m_lock);
+  m_jobs.clear();
+  for (auto& sound : sounds)
+  {
+    const CSoundPacket* orig = sound->GetSound(true);
+    if (!orig)
+      continue;
+
+    Job job{sound, orig, {}};
+
+    // mono sounds testing a speaker are played on that speaker only
+    AEChannel testChannel = sound->GetChannel();
+    if (orig->config.channels == 1 && testChannel != AE_CH_NULL)
+    {
+      for (unsigned int out = 0; out < format.m_channelLayout.Count(); out++)
+      {
+        if (format.m_channelLayout[out] == AE_CH_FC && testChannel != AE_CH_FC)
+          job.outChannels += AE_CH_FL;
+        else if (format.m_channelLayout[out] == testChannel)
+          job.outChannels += AE_CH_FC;
+        else
+          job.outChannels += format.m_channelLayout[out];
+      }
+    }
+    m_jobs.push_back(std::move(job));
+  }
+
+  if (m_jobs.empty())
+    return true;
+
+  m_format = format;
+  m_quality = quality;
+  m_jobGeneration = m_generation;
+  m_busy = true;
+  m_jobEvent.Set();
+  return true;
+}
+
+std::unique_ptr<CActiveAESoundBank::Bank> CActiveAESoundBank::Take()
+{
+  if (!m_ready)
+    return nullptr;
+
+  CSingleLock lock(m_lock);
+  m_ready = false;
+  return std::move(m_bank);
+}
+
+void CActiveAESoundBank::Cancel()
+{
+  // a conversion still running sees the new generation and drops its result
+  CSingleLock lock(m_lock);
+  m_generation++;
+  m_bank.reset();
+  m_ready = false;
+}
+
+void CActiveAESoundBank::Process()
+{
+  while (!m_bStop)
+  {
+    if (!m_busy)
+    {
+      AbortableWait(m_jobEvent);
+      continue;
+    }
+
+    std::unique_ptr<Bank> bank = Convert();
+    {
+      CSingleLock lock(m_lock);
+      m_jobs.clear();
+      if (bank && m_jobGeneration == m_generation)
+      {
+        m_bank = std::move(bank);
+        m_ready = true;
+      }
+    }
+    m_busy = false;
+  }
+}
+
+std::unique_ptr<CActiveAESoundBank::Bank> CActiveAESoundBank::Convert()
+{
+  // the jobs are only changed by Build while the worker is idle, so no lock is held here
+  // and Cancel or Take don't have to wait for the conversion
+  SampleConfig dstConfig;
+  dstConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_format.m_channelLayout);
+  dstConfig.channels = m_format.m_channelLayout.Count();
+  dstConfig.sample_rate = m_format.m_sampleRate;
+  dstConfig.fmt = CAEUtil::GetAVSampleFormat(m_format.m_dataFormat);
+  dstConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat);
+  dstConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_format.m_dataFormat);
+
+  // size all sounds first so they can share one allocation
+  std::vector<std::unique_ptr<IAEResample>> resamplers;
+  std::vector<int> samples;
+  size_t size = 0;
+  for (auto& job : m_jobs)
+  {
+    std::unique_ptr<IAEResample> resampler(
+        CAEResampleFactory::Create(AERESAMPLEFACTORY_QUICK_RESAMPLE));
+    resampler->Init(dstConfig, job.orig->config, false, true, M_SQRT1_2,
+                    job.outChannels.Count() > 0 ? &job.outChannels : nullptr, m_quality, false);
+
+    const int dstSamples = resampler->CalcDstSampleCount(
+        job.orig->nb_samples, m_format.m_sampleRate, job.orig->config.sample_rate);
+    size += CSoundPacket::BufferSize(dstConfig, dstSamples);
+    resamplers.push_back(std::move(resampler));
+    samples.push_back(dstSamples);
+  }
+
+  std::unique_ptr<Bank> bank(new Bank);
+  bank->storage.reset(static_cast<uint8_t*>(av_malloc(size)), av_free);
+  if (!bank->storage)
+  {
+    CLog::Log(LOGERROR, "CActiveAESoundBank::{} - failed to allocate {} bytes", __FUNCTION__,
+              size);
+    return nullptr;
+  }
+
+  uint8_t* buffer = bank->storage.get();
+  for (size_t i = 0; i < m_jobs.size(); i++)
+  {
+    if (m_jobGeneration != m_generation || m_bStop)
+      return nullptr;
+
+    std::unique_ptr<CSoundPacket> packet(new CSoundPacket(dstConfig, samples[i], buffer));
+    packet->nb_samples = resamplers[i]->Resample(packet->data, samples[i], m_jobs[i].orig->data,
+                                                 m_jobs[i].orig->nb_samples, 1.0);
+    bank->entries.push_back({m_jobs[i].sound, std::move(packet)});
+    buffer += CSoundPacket::BufferSize(dstConfig, samples[i]);
+  }
+
+  CLog::Log(LOGDEBUG, "CActiveAESoundBank::{} - converted {} sounds into {} bytes", __FUNCTION__,
+            bank->entries.size(), size);
+  return bank;
+}
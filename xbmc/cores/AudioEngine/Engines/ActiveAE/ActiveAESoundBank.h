@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "ActiveAEBuffer.h"
+#include "cores/AudioEngine/Interfaces/AE.h"
+#include "cores/AudioEngine/Utils/AEAudioFormat.h"
+#include "cores/AudioEngine/Utils/AEChannelInfo.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace ActiveAE
+{
+
+class CActiveAESound;
+
+/*!
+ * \brief Converts gui sounds to the mixing format of the engine off the engine thread.
+ *
+ * The engine hands over all sounds that are not converted whenever the format changes or
+ * sounds are added. A worker resamples them into a single contiguous buffer, once that
+ * is done the engine installs the result by swapping the sounds' packets, so playing a
+ * sound never has to convert it first.
+ */
+class CActiveAESoundBank : private CThread
+{
+public:
+  struct Entry
+  {
+    CActiveAESound* sound;
+    std::unique_ptr<CSoundPacket> packet; //!< refers to storage
+  };
+
+  struct Bank
+  {
+    std::vector<Entry> entries;
+    std::shared_ptr<uint8_t> storage;
+  };
+
+  CActiveAESoundBank();
+  ~CActiveAESoundBank() override;
+
+  /*!
+   * \brief Start converting sounds, engine thread only.
+   * \param sounds must not be deleted while the bank is busy
+   * \return false if the previous bank is not done yet
+   */
+  bool Build(const std::vector<CActiveAESound*>& sounds,
+             const AEAudioFormat& format,
+             AEQuality quality);
+
+  /*!
+   * \brief Take the converted sounds if there are any, engine thread only.
+   */
+  std::unique_ptr<Bank> Take();
+
+  /*!
+   * \brief Drop the bank in progress and the one not taken yet, engine thread only.
+   *
+   * Doesn't wait for the worker, a conversion still running is dropped when it is done.
+   */
+  void Cancel();
+
+  bool IsBusy() const { return m_busy; }
+
+protected:
+  void Process() override;
+
+private:
+  struct Job
+  {
+    CActiveAESound* sound;
+    const CSoundPacket* orig;
+    CAEChannelInfo outChannels; //!< mapping for sounds testing a single channel
+  };
+
+  std::unique_ptr<Bank> Convert();
+
+  CCriticalSection m_lock;
+  std::vector<Job> m_jobs;
+  AEAudioFormat m_format;
+  AEQuality m_quality = AE_QUALITY_DEFAULT;
+  std::unique_ptr<Bank> m_bank;
+  std::atomic<bool> m_busy{false};
+  std::atomic<bool> m_ready{false};
+  std::atomic<unsigned int> m_generation{0}; //!< bumped by Cancel
+  unsigned int m_jobGeneration = 0; //!< generation the jobs were built in
+  CEvent m_jobEvent;
+};
+
+} // namespace ActiveAE
@@ -22,7 +22,6 @@ CActiveAEStream::CActiveAEStream(AEAudioFormat *format, unsigned int streamid, C
   m_activeAE = ae;
   m_format = *format;
   m_id = streamid;
-  m_bufferedTime = 0;
   m_currentBuffer = NULL;
   m_drain = false;
   m_paused = false;
@@ -34,13 +33,13 @@ CActiveAEStream::CActiveAEStream(AEAudioFormat *format, unsigned int streamid, C
   m_streamDraining = false;
   m_streamDrained = false;
   m_streamFading = false;
-  m_streamFreeBuffers = 0;
   m_streamIsBuffering = false;
   m_streamIsFlushed = false;
   m_streamSlave = NULL;
   m_leftoverBuffer = new uint8_t[m_format.m_frameSize];
   m_leftoverBytes = 0;
   m_forceResampler = false;
+  m_lowLatency = false;
   m_remapper = NULL;
   m_remapBuffer = NULL;
   m_streamResampleRatio = 1.0;
@@ -61,22 +60,11 @@ CActiveAEStream::~CActiveAEStream()
   delete m_remapBuffer;
 }
 
-void CActiveAEStream::IncFreeBuffers()
+void CActiveAEStream::QueueBuffer()
 {
-  CSingleLock lock(m_streamLock);
-  m_streamFreeBuffers++;
-}
-
-void CActiveAEStream::DecFreeBuffers()
-{
-  CSingleLock lock(m_streamLock);
-  m_streamFreeBuffers--;
-}
-
-void CActiveAEStream::ResetFreeBuffers()
-{
-  CSingleLock lock(m_streamLock);
-  m_streamFreeBuffers = 0;
+  m_sampleQueue.Push(m_currentBuffer);
+  m_currentBuffer = nullptr;
+  m_activeAE->m_outMsgEvent.Set();
 }
 
 void CActiveAEStream::InitRemapper()
@@ -224,16 +212,15 @@ std::chrono::milliseconds CActiveAEStream::GetErrorInterval()
 
 unsigned int CActiveAEStream::GetSpace()
 {
-  CSingleLock lock(m_streamLock);
+  const unsigned int freeBuffers = m_freeQueue.Size();
   if (m_format.m_dataFormat == AE_FMT_RAW)
-    return m_streamFreeBuffers;
+    return freeBuffers;
   else
-    return m_streamFreeBuffers * m_streamSpace;
+    return freeBuffers * m_streamSpace;
 }
 
 unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int offset, unsigned int frames, ExtData *extData)
 {
-  Message *msg;
   unsigned int copied = 0;
   int sourceFrames = frames;
   const uint8_t* const *buf = data;
@@ -297,51 +284,28 @@ unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int o
         m_currentBuffer->centerMixLevel = extData->centerMixLevel;
 
       bool rawPktComplete = false;
+      m_currentBuffer->pkt->nb_samples += minFrames;
+      if (m_format.m_dataFormat != AE_FMT_RAW)
+        m_samplesAdded += minFrames;
+      else
       {
-        CSingleLock lock(m_statsLock);
-        if (m_format.m_dataFormat != AE_FMT_RAW)
-        {
-          m_currentBuffer->pkt->nb_samples += minFrames;
-          m_bufferedTime +=
-              static_cast<float>(minFrames) / m_currentBuffer->pkt->config.sample_rate;
-        }
-        else
-        {
-          m_bufferedTime += static_cast<float>(m_format.m_streamInfo.GetDuration()) / 1000;
-          m_currentBuffer->pkt->nb_samples += minFrames;
-          rawPktComplete = true;
-        }
+        m_samplesAdded++;
+        rawPktComplete = true;
       }
 
       if (m_currentBuffer->pkt->nb_samples == m_currentBuffer->pkt->max_nb_samples || rawPktComplete)
       {
-        MsgStreamSample msgData;
-        msgData.buffer = m_currentBuffer;
-        msgData.stream = this;
         RemapBuffer();
-        m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
-        m_currentBuffer = nullptr;
+        QueueBuffer();
       }
       continue;
     }
-    else if (m_streamPort->ReceiveInMessage(&msg))
+    else if (m_freeQueue.Pop(m_currentBuffer))
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        m_currentBuffer = *((CSampleBuffer**)msg->data);
-        m_currentBuffer->timestamp = 0;
-        m_currentBuffer->pkt->nb_samples = 0;
-        m_currentBuffer->pkt->pause_burst_ms = 0;
-        msg->Release();
-        DecFreeBuffers();
-        continue;
-      }
-      else
-      {
-        CLog::Log(LOGERROR, "CActiveAEStream::AddData - unknown signal");
-        msg->Release();
-        break;
-      }
+      m_currentBuffer->timestamp = 0;
+      m_currentBuffer->pkt->nb_samples = 0;
+      m_currentBuffer->pkt->pause_burst_ms = 0;
+      continue;
     }
     if (!m_inMsgEvent.Wait(200ms))
       break;
@@ -417,12 +381,8 @@ void CActiveAEStream::Drain(bool wait)
 
   if (m_currentBuffer)
   {
-    MsgStreamSample msgData;
-    msgData.buffer = m_currentBuffer;
-    msgData.stream = this;
     RemapBuffer();
-    m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
-    m_currentBuffer = NULL;
+    QueueBuffer();
   }
 
   if (wait)
@@ -431,22 +391,21 @@ void CActiveAEStream::Drain(bool wait)
   XbmcThreads::EndTime<> timer(2000ms);
   while (!timer.IsTimePast())
   {
-    if (m_streamPort->ReceiveInMessage(&msg))
+    // hand back new buffers empty
+    if (m_freeQueue.Pop(m_currentBuffer))
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        MsgStreamSample msgData;
-        msgData.stream = this;
-        msgData.buffer = *((CSampleBuffer**)msg->data);
-        msg->Reply(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
-        DecFreeBuffers();
-        continue;
-      }
-      else if (msg->signal == CActiveAEDataProtocol::STREAMDRAINED)
+      m_currentBuffer->pkt->nb_samples = 0;
+      QueueBuffer();
+      continue;
+    }
+    else if (m_streamPort->ReceiveInMessage(&msg))
+    {
+      if (msg->signal == CActiveAEDataProtocol::STREAMDRAINED)
       {
         msg->Release();
         return;
       }
+      msg->Release();
     }
     else if (!wait)
       return;
@@ -668,6 +627,11 @@ void CActiveAEStreamBuffers::ConfigureResampler(bool normalizelevels, bool stere
   m_resampleBuffers->ConfigureResampler(normalizelevels, stereoupmix, quality);
 }
 
+void CActiveAEStreamBuffers::SetResampleQuality(AEQuality quality)
+{
+  m_resampleBuffers->SetResampleQuality(quality);
+}
+
 float CActiveAEStreamBuffers::GetDelay()
 {
   float delay = 0;
@@ -14,6 +14,7 @@
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Utils/AELimiter.h"
 #include "threads/Event.h"
+#include "threads/SPSCQueue.h"
 
 #include <atomic>
 #include <deque>
@@ -100,6 +101,7 @@ public:
   void SetExtraData(int profile, enum AVMatrixEncoding matrix_encoding, enum AVAudioServiceType audio_service_type);
   bool ProcessBuffers();
   void ConfigureResampler(bool normalizelevels, bool stereoupmix, AEQuality quality);
+  void SetResampleQuality(AEQuality quality);
   bool HasInputLevel(int level);
   float GetDelay();
   void Flush();
@@ -135,9 +137,7 @@ protected:
   CActiveAEStream(AEAudioFormat *format, unsigned int streamid, CActiveAE *ae);
   ~CActiveAEStream() override;
   void FadingFinished();
-  void IncFreeBuffers();
-  void DecFreeBuffers();
-  void ResetFreeBuffers();
+  void QueueBuffer();
   void InitRemapper();
   void RemapBuffer();
   double CalcResampleRatio(double error);
@@ -197,12 +197,10 @@ protected:
   bool m_streamDraining;
   bool m_streamDrained;
   bool m_streamFading;
-  int m_streamFreeBuffers;
   bool m_streamIsBuffering;
   bool m_streamIsFlushed;
   IAEStream *m_streamSlave;
   CCriticalSection m_streamLock;
-  CCriticalSection m_statsLock;
   uint8_t *m_leftoverBuffer;
   int m_leftoverBytes;
   CSampleBuffer *m_currentBuffer;
@@ -212,6 +210,15 @@ protected:
   double m_lastPtsJump;
   std::chrono::milliseconds m_errorInterval{1000};
 
+  // Buffers move between the engine and the thread calling AddData without locks:
+  // empty ones through m_freeQueue, filled ones back through m_sampleQueue. The engine
+  // never has more buffers out than a queue holds.
+  static constexpr size_t MAX_QUEUED_BUFFERS = 512;
+  CSPSCQueue<CSampleBuffer*> m_freeQueue{MAX_QUEUED_BUFFERS};
+  CSPSCQueue<CSampleBuffer*> m_sampleQueue{MAX_QUEUED_BUFFERS};
+  // frames, or packets for raw streams, written by AddData
+  std::atomic<int64_t> m_samplesAdded{0};
+
   // only accessed by engine
   CActiveAEBufferPool *m_inputBuffers;
   CActiveAEStreamBuffers *m_processingBuffers;
@@ -225,7 +232,7 @@ protected:
   float m_volume;
   float m_rgain;
   float m_amplify;
-  float m_bufferedTime;
+  int64_t m_samplesReceived = 0;
   int m_fadingSamples;
   float m_fadingBase;
   float m_fadingTarget;
@@ -237,6 +244,7 @@ protected:
   enum AVMatrixEncoding m_matrixEncoding;
   enum AVAudioServiceType m_audioServiceType;
   bool m_forceResampler;
+  bool m_lowLatency;
   IAEClockCallback *m_pClock;
   CSyncError m_syncError;
   double m_lastSyncError;
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAEStreamWorkers.h"
+
+#include "ActiveAEStream.h"
+#include "threads/Thread.h"
+
+#include <algorithm>
+
+using namespace ActiveAE;
+
+class CActiveAEStreamWorkers::CWorker : public CThread
+{
+public:
+  explicit CWorker(CActiveAEStreamWorkers& owner) : CThread("ActiveAEWorker"), m_owner(owner) {}
+
+  void Wake() { m_workEvent.Set(); }
+
+protected:
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      if (AbortableWait(m_workEvent) != WAIT_SIGNALED)
+        break;
+
+      m_owner.RunJobs();
+      m_owner.WorkerDone();
+    }
+  }
+
+private:
+  CActiveAEStreamWorkers& m_owner;
+  CEvent m_workEvent;
+};
+
+CActiveAEStreamWorkers::CActiveAEStreamWorkers(unsigned int workers)
+{
+  for (unsigned int i = 0; i < workers; i++)
+  {
+    m_workers.emplace_back(new CWorker(*this));
+    m_workers.back()->Create();
+  }
+}
+
+CActiveAEStreamWorkers::~CActiveAEStreamWorkers()
+{
+  for (auto& worker : m_workers)
+    worker->StopThread();
+}
+
+bool CActiveAEStreamWorkers::Process(const std::vector<CActiveAEStreamBuffers*>& buffers)
+{
+  if (buffers.size() < 2 || m_workers.empty())
+  {
+    bool busy = false;
+    for (auto& buf : buffers)
+      busy |= buf->ProcessBuffers();
+    return busy;
+  }
+
+  const size_t helpers = std::min(m_workers.size(), buffers.size() - 1);
+  m_jobs = &buffers;
+  m_nextJob = 0;
+  m_busy = false;
+  m_running = static_cast<unsigned int>(helpers);
+  for (size_t i = 0; i < helpers; i++)
+    m_workers[i]->Wake();
+
+  RunJobs();
+
+  // a worker may still be on the last stream, wait until all of them left the jobs
+  while (m_running > 0)
+    m_doneEvent.Wait();
+
+  m_jobs = nullptr;
+  return m_busy;
+}
+
+void CActiveAEStreamWorkers::RunJobs()
+{
+  for (size_t job = m_nextJob++; job < m_jobs->size(); job = m_nextJob++)
+  {
+    if ((*m_jobs)[job]->ProcessBuffers())
+      m_busy = true;
+  }
+}
+
+void CActiveAEStreamWorkers::WorkerDone()
+{
+  if (--m_running == 0)
+    m_doneEvent.Set();
+}
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Event.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace ActiveAE
+{
+class CActiveAEStreamBuffers;
+
+/*!
+ * \brief Runs the stream stage of several streams in parallel.
+ *
+ * The buffers of a stream are only touched by the stage of that stream, so streams can
+ * be resampled on different threads. The calling engine thread takes part and Process()
+ * returns when all streams are done, the engine sees no difference to a serial loop.
+ */
+class CActiveAEStreamWorkers
+{
+public:
+  /*!
+   * \param workers number of threads besides the calling one, 0 processes serially
+   */
+  explicit CActiveAEStreamWorkers(unsigned int workers);
+  ~CActiveAEStreamWorkers();
+
+  CActiveAEStreamWorkers(const CActiveAEStreamWorkers&) = delete;
+  CActiveAEStreamWorkers& operator=(const CActiveAEStreamWorkers&) = delete;
+
+  /*!
+   * \brief Call ProcessBuffers of each of the given streams.
+   * \return true if any of them was busy
+   */
+  bool Process(const std::vector<CActiveAEStreamBuffers*>& buffers);
+
+  unsigned int GetWorkers() const { return static_cast<unsigned int>(m_workers.size()); }
+
+private:
+  class CWorker;
+
+  void RunJobs();
+  void WorkerDone();
+
+  std::vector<std::unique_ptr<CWorker>> m_workers;
+  const std::vector<CActiveAEStreamBuffers*>* m_jobs = nullptr;
+  std::atomic<size_t> m_nextJob{0};
+  std::atomic<unsigned int> m_running{0};
+  std::atomic_bool m_busy{false};
+  CEvent m_doneEvent;
+};
+
+} // namespace ActiveAE
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAEVizAnalysis.h"
+
+#include "cores/AudioEngine/Interfaces/IAudioCallback.h"
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+
+using namespace ActiveAE;
+
+namespace
+{
+constexpr unsigned int BLOCKS = 8;
+// samples per channel of a transform, what visualizations have always been given
+constexpr unsigned int FFT_SIZE = 256;
+} // namespace
+
+CActiveAEVizAnalysis::CActiveAEVizAnalysis(CCriticalSection& lock,
+                                           CCriticalSection& callbackLock,
+                                           const std::vector<IAudioCallback*>& callbacks)
+  : CThread("ActiveAEViz"),
+    m_blocks(BLOCKS),
+    m_freeQueue(BLOCKS),
+    m_dataQueue(BLOCKS),
+    m_spectrum(FFT_SIZE),
+    m_lock(lock),
+    m_callbackLock(callbackLock),
+    m_callbacks(callbacks)
+{
+  for (auto& block : m_blocks)
+    m_freeQueue.Push(&block);
+
+  Create();
+}
+
+CActiveAEVizAnalysis::~CActiveAEVizAnalysis()
+{
+  StopThread();
+}
+
+bool CActiveAEVizAnalysis::Add(const float* data, unsigned int length)
+{
+  Block* block;
+  if (!m_freeQueue.Pop(block))
+    return false;
+
+  // blocks keep their storage, this only allocates for the first few
+  if (block->data.size() < length)
+    block->data.resize(length);
+  std::copy(data, data + length, block->data.begin());
+  block->length = length;
+
+  m_dataQueue.Push(block);
+  m_dataEvent.Set();
+  return true;
+}
+
+void CActiveAEVizAnalysis::Process()
+{
+  while (!m_bStop)
+  {
+    Block* block;
+    if (!m_dataQueue.Pop(block))
+    {
+      AbortableWait(m_dataEvent);
+      continue;
+    }
+
+    m_spectrum.Calculate(block->data.data(), block->length);
+    {
+      // the engine only waits for the copy, not for the visualization
+      CSingleLock callbackLock(m_callbackLock);
+      {
+        CSingleLock lock(m_lock);
+        m_currentCallbacks.assign(m_callbacks.begin(), m_callbacks.end());
+      }
+      for (auto& callback : m_currentCallbacks)
+        callback->OnAudioSpectrum(block->data.data(), block->length, m_spectrum);
+    }
+
+    m_freeQueue.Push(block);
+  }
+}
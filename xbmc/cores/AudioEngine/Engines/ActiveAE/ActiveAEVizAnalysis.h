@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Utils/AESpectrum.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SPSCQueue.h"
+#include "threads/Thread.h"
+
+#include <vector>
+
+class IAudioCallback;
+
+namespace ActiveAE
+{
+
+/*!
+ * \brief Analysis stage for visualizations.
+ *
+ * The engine hands over each viz block when it is due. A worker thread computes its
+ * spectrum once and passes both to all audio callbacks, so neither the transform nor
+ * the callbacks run on the engine thread.
+ */
+class CActiveAEVizAnalysis : private CThread
+{
+public:
+  /*!
+   * \param lock guards the list, only held to copy it
+   * \param callbackLock held while calling the callbacks, take it before lock to remove a
+   * callback that may be in use
+   * \param callbacks audio callbacks of the engine
+   */
+  CActiveAEVizAnalysis(CCriticalSection& lock,
+                       CCriticalSection& callbackLock,
+                       const std::vector<IAudioCallback*>& callbacks);
+  ~CActiveAEVizAnalysis() override;
+
+  /*!
+   * \brief Queue a block of interleaved stereo float samples, engine thread only.
+   * \return false if the worker is behind and the block was dropped
+   */
+  bool Add(const float* data, unsigned int length);
+
+protected:
+  void Process() override;
+
+private:
+  struct Block
+  {
+    std::vector<float> data;
+    unsigned int length = 0;
+  };
+
+  std::vector<Block> m_blocks;
+  CSPSCQueue<Block*> m_freeQueue; //!< engine takes, worker returns
+  CSPSCQueue<Block*> m_dataQueue; //!< engine adds, worker takes
+  CEvent m_dataEvent;
+  CAESpectrum m_spectrum;
+  CCriticalSection& m_lock;
+  CCriticalSection& m_callbackLock;
+  const std::vector<IAudioCallback*>& m_callbacks;
+  std::vector<IAudioCallback*> m_currentCallbacks;
+};
+
+} // namespace ActiveAE
@@ -0,0 +1,389 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
+#include "cores/AudioEngine/Interfaces/AESound.h"
+#include "cores/AudioEngine/Interfaces/AEStream.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "cores/AudioEngine/Utils/AEStreamData.h"
+#include "filesystem/File.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/XTimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr char SOUND_PATH[] = "special://temp/TestActiveAEBenchmark.wav";
+
+/*!
+ * \brief Runs N streams through a real CActiveAE on the null sink and measures it.
+ *
+ * Stream data is resampled (forced), amplified so the limiter runs, mixed with a GUI
+ * sound and deamplified by the engine volume. With transcode set the mix is encoded to
+ * AC3 and IEC 61937 packed for the sink, which needs more than two channels.
+ * With low latency set the streams are neither resampled nor amplified, so a single
+ * stream takes the direct path of the engine.
+ */
+class CActiveAEBenchmark
+{
+public:
+  struct Config
+  {
+    unsigned int streams = 1;
+    unsigned int sampleRate = 44100;
+    unsigned int channels = 2;
+    double seconds = 10.0; ///< audio fed per stream
+    double clockSpeed = 0.0; ///< see CAESinkNULL::SetClockSpeed
+    bool transcode = false;
+    bool lowLatency = false; ///< streams are created with AESTREAM_LOW_LATENCY
+  };
+
+  struct Result
+  {
+    double audioSeconds = 0.0; ///< audio consumed by the sink
+    double cpuSeconds = 0.0; ///< process CPU time of the run, all threads
+    double meanDelay = 0.0; ///< mean of IAEStream::GetDelay() while feeding
+    double maxDelay = 0.0;
+    double firstAudio = 0.0; ///< wall time from first AddData to first audible frame at the sink
+    float engineDelay = 0.0f; ///< CActiveAE::GetMeasuredDelay() average at the end of feeding
+
+    double CpuMsPerSecond() const { return audioSeconds > 0 ? cpuSeconds * 1000 / audioSeconds : 0; }
+  };
+
+  explicit CActiveAEBenchmark(const Config& config) : m_config(config) {}
+
+  Result Run()
+  {
+    ApplySettings();
+    CAESinkNULL::SetClockSpeed(m_config.clockSpeed);
+    CAESinkNULL::ResetStats();
+
+    CActiveAE ae;
+    ae.Start();
+    ae.SetVolume(0.5f);
+
+    WriteSound();
+    IAE::SoundPtr sound = ae.MakeSound(SOUND_PATH);
+
+    AEAudioFormat format;
+    format.m_dataFormat = AE_FMT_FLOAT;
+    format.m_sampleRate = m_config.sampleRate;
+    format.m_channelLayout = m_config.channels > 2 ? AE_CH_LAYOUT_5_1 : AE_CH_LAYOUT_2_0;
+
+    std::vector<IAE::StreamPtr> streams;
+    for (unsigned int i = 0; i < m_config.streams; i++)
+    {
+      AEAudioFormat streamFormat = format;
+      if (m_config.lowLatency)
+        streams.push_back(ae.MakeStream(streamFormat, AESTREAM_LOW_LATENCY));
+      else
+      {
+        streams.push_back(ae.MakeStream(streamFormat, AESTREAM_FORCE_RESAMPLE));
+        streams.back()->SetAmplification(2.0f);
+      }
+    }
+
+    const unsigned int channels = format.m_channelLayout.Count();
+    const unsigned int chunk = m_config.sampleRate / 100;
+    std::vector<float> samples(chunk * channels);
+
+    const auto total = static_cast<uint64_t>(m_config.seconds * m_config.sampleRate);
+    std::vector<uint64_t> fed(streams.size(), 0);
+    double delaySum = 0.0;
+    unsigned int delayCount = 0;
+    Result result;
+
+    const std::clock_t cpuStart = std::clock();
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t lastSound = 0;
+
+    while (*std::min_element(fed.begin(), fed.end()) < total)
+    {
+      bool added = false;
+      for (size_t i = 0; i < streams.size(); i++)
+      {
+        if (fed[i] >= total || streams[i]->GetSpace() < samples.size() * sizeof(float))
+          continue;
+
+        FillSine(samples, channels, fed[i], i);
+        const uint8_t* data[] = {reinterpret_cast<const uint8_t*>(samples.data())};
+        IAEStream::ExtData ext;
+        ext.pts = fed[i] * 1000.0 / m_config.sampleRate;
+        fed[i] += streams[i]->AddData(data, 0, chunk, &ext);
+        added = true;
+
+        const double delay = streams[i]->GetDelay();
+        delaySum += delay;
+        delayCount++;
+        result.maxDelay = std::max(result.maxDelay, delay);
+      }
+
+      // a gui sound every half second of stream time
+      if (sound && fed[0] - lastSound >= m_config.sampleRate / 2)
+      {
+        sound->Play();
+        lastSound = fed[0];
+      }
+
+      if (!added)
+        KODI::TIME::Sleep(1ms);
+    }
+
+    float peak;
+    ae.GetMeasuredDelay(result.engineDelay, peak);
+
+    for (auto& stream : streams)
+      stream->Drain(true);
+
+    const CAESinkNULL::Stats stats = CAESinkNULL::GetStats();
+    result.cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    result.audioSeconds = stats.sampleRate ? static_cast<double>(stats.frames) / stats.sampleRate : 0;
+    result.meanDelay = delayCount ? delaySum / delayCount : 0;
+    if (stats.hasSignal)
+      result.firstAudio = std::chrono::duration<double>(stats.firstSignal - start).count();
+
+    streams.clear();
+    sound.reset();
+    ae.Shutdown();
+    CAESinkNULL::SetClockSpeed(1.0);
+    XFILE::CFile::Delete(SOUND_PATH);
+
+    CLog::Log(LOGINFO,
+              "CActiveAEBenchmark: {} streams, {} ch, transcode {}, low latency {}: {:.3f} s audio, "
+              "{:.2f} ms CPU per s audio, delay mean {:.1f} ms max {:.1f} ms, engine {:.1f} ms, "
+              "first audio after {:.1f} ms",
+              m_config.streams, channels, m_config.transcode, m_config.lowLatency,
+              result.audioSeconds, result.CpuMsPerSecond(), result.meanDelay * 1000,
+              result.maxDelay * 1000, result.engineDelay * 1000, result.firstAudio * 1000);
+    return result;
+  }
+
+private:
+  void ApplySettings()
+  {
+    const std::shared_ptr<CSettings> settings =
+        CServiceBroker::GetSettingsComponent()->GetSettings();
+    settings->SetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE, "NULL:null");
+    settings->SetString(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGHDEVICE, "NULL:null");
+    settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG, AE_CONFIG_AUTO);
+    settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_GUISOUNDMODE, AE_SOUND_ALWAYS);
+    settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_STREAMSILENCE, 0);
+    settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_STREAMNOISE, false);
+    settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH, m_config.transcode);
+    settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_AC3PASSTHROUGH, m_config.transcode);
+    settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_AC3TRANSCODE, m_config.transcode);
+  }
+
+  void FillSine(std::vector<float>& samples, unsigned int channels, uint64_t pos, size_t stream)
+  {
+    // a different tone per stream so the mix isn't just a louder copy
+    const double step = 2.0 * M_PI * (220.0 * (stream + 1)) / m_config.sampleRate;
+    for (size_t frame = 0; frame < samples.size() / channels; frame++)
+    {
+      const float value = 0.25f * static_cast<float>(std::sin(step * (pos + frame)));
+      std::fill_n(samples.begin() + frame * channels, channels, value);
+    }
+  }
+
+  static void WriteSound()
+  {
+    // 100 ms 16 bit stereo 48kHz click
+    constexpr uint32_t rate = 48000;
+    constexpr uint32_t frames = rate / 10;
+    std::vector<uint8_t> wav(44 + frames * 4, 0);
+    auto put32 = [&wav](size_t pos, uint32_t v) {
+      for (int i = 0; i < 4; i++)
+        wav[pos + i] = (v >> (8 * i)) & 0xFF;
+    };
+    auto put16 = [&wav](size_t pos, uint16_t v) {
+      wav[pos] = v & 0xFF;
+      wav[pos + 1] = v >> 8;
+    };
+    memcpy(wav.data(), "RIFF", 4);
+    put32(4, static_cast<uint32_t>(wav.size() - 8));
+    memcpy(wav.data() + 8, "WAVEfmt ", 8);
+    put32(16, 16);
+    put16(20, 1);
+    put16(22, 2);
+    put32(24, rate);
+    put32(28, rate * 4);
+    put16(32, 4);
+    put16(34, 16);
+    memcpy(wav.data() + 36, "data", 4);
+    put32(40, frames * 4);
+    for (uint32_t i = 0; i < frames * 2; i++)
+      put16(44 + i * 2, static_cast<uint16_t>(static_cast<int16_t>(
+                            8000 * std::sin(2.0 * M_PI * 1000.0 * (i / 2) / rate))));
+
+    XFILE::CFile file;
+    if (file.OpenForWrite(SOUND_PATH, true))
+      file.Write(wav.data(), wav.size());
+  }
+
+  Config m_config;
+};
+} // namespace
+
+/*!
+ * \brief The benchmarks change the audio settings and the registered sinks, which are
+ * global. They are restored afterwards so the rest of the suite doesn't see them.
+ *
+ * The benchmarks are disabled by default as they take a while and depend on the load of
+ * the machine. Run them with
+ * --gtest_also_run_disabled_tests --gtest_filter=TestActiveAEBenchmark.*
+ * The timings are reported as test properties and in the log.
+ */
+class TestActiveAEBenchmark : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    const std::shared_ptr<CSettings> settings =
+        CServiceBroker::GetSettingsComponent()->GetSettings();
+    for (const char* id : STRING_SETTINGS)
+      m_strings[id] = settings->GetString(id);
+    for (const char* id : INT_SETTINGS)
+      m_ints[id] = settings->GetInt(id);
+    for (const char* id : BOOL_SETTINGS)
+      m_bools[id] = settings->GetBool(id);
+
+    m_sinks = CSinkRegistry::Get();
+    CAESinkNULL::Register();
+  }
+
+  void TearDown() override
+  {
+    CSinkRegistry::Set(m_sinks);
+
+    const std::shared_ptr<CSettings> settings =
+        CServiceBroker::GetSettingsComponent()->GetSettings();
+    for (const auto& setting : m_strings)
+      settings->SetString(setting.first, setting.second);
+    for (const auto& setting : m_ints)
+      settings->SetInt(setting.first, setting.second);
+    for (const auto& setting : m_bools)
+      settings->SetBool(setting.first, setting.second);
+  }
+
+  void Report(const CActiveAEBenchmark::Result& result, const std::string& prefix = "")
+  {
+    RecordProperty(prefix + "cpuMsPerSecond", std::to_string(result.CpuMsPerSecond()));
+    RecordProperty(prefix + "meanDelayMs", std::to_string(result.meanDelay * 1000));
+    RecordProperty(prefix + "maxDelayMs", std::to_string(result.maxDelay * 1000));
+    RecordProperty(prefix + "engineDelayMs", std::to_string(result.engineDelay * 1000));
+    RecordProperty(prefix + "firstAudioMs", std::to_string(result.firstAudio * 1000));
+  }
+
+private:
+  //! access to the registered sinks
+  class CSinkRegistry : public AE::CAESinkFactory
+  {
+  public:
+    static std::map<std::string, AE::AESinkRegEntry> Get() { return m_AESinkRegEntry; }
+    static void Set(const std::map<std::string, AE::AESinkRegEntry>& sinks)
+    {
+      m_AESinkRegEntry = sinks;
+    }
+  };
+
+  static constexpr const char* STRING_SETTINGS[] = {
+      CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE, CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGHDEVICE};
+  static constexpr const char* INT_SETTINGS[] = {CSettings::SETTING_AUDIOOUTPUT_CONFIG,
+                                                 CSettings::SETTING_AUDIOOUTPUT_GUISOUNDMODE,
+                                                 CSettings::SETTING_AUDIOOUTPUT_STREAMSILENCE};
+  static constexpr const char* BOOL_SETTINGS[] = {CSettings::SETTING_AUDIOOUTPUT_STREAMNOISE,
+                                                  CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH,
+                                                  CSettings::SETTING_AUDIOOUTPUT_AC3PASSTHROUGH,
+                                                  CSettings::SETTING_AUDIOOUTPUT_AC3TRANSCODE};
+
+  std::map<std::string, std::string> m_strings;
+  std::map<std::string, int> m_ints;
+  std::map<std::string, bool> m_bools;
+  std::map<std::string, AE::AESinkRegEntry> m_sinks;
+};
+
+TEST_F(TestActiveAEBenchmark, DISABLED_SingleStream)
+{
+  CActiveAEBenchmark::Config config;
+  const auto result = CActiveAEBenchmark(config).Run();
+  Report(result);
+
+  // the sink also plays the buffered tail and silence while the engine settles
+  EXPECT_GE(result.audioSeconds, config.seconds * 0.9);
+  EXPECT_GT(result.firstAudio, 0.0);
+  EXPECT_GT(result.meanDelay, 0.0);
+}
+
+TEST_F(TestActiveAEBenchmark, DISABLED_MultipleStreams)
+{
+  CActiveAEBenchmark::Config config;
+  config.streams = 4;
+  const auto result = CActiveAEBenchmark(config).Run();
+  Report(result);
+
+  EXPECT_GE(result.audioSeconds, config.seconds * 0.9);
+  EXPECT_GT(result.cpuSeconds, 0.0);
+}
+
+TEST_F(TestActiveAEBenchmark, DISABLED_Transcode)
+{
+  CActiveAEBenchmark::Config config;
+  config.sampleRate = 48000;
+  config.channels = 6;
+  config.transcode = true;
+  const auto result = CActiveAEBenchmark(config).Run();
+  Report(result);
+
+  EXPECT_GE(result.audioSeconds, config.seconds * 0.9);
+}
+
+TEST_F(TestActiveAEBenchmark, DISABLED_Realtime)
+{
+  // paced by the sink clock, measures the latency a real device would see
+  CActiveAEBenchmark::Config config;
+  config.seconds = 1.0;
+  config.clockSpeed = 1.0;
+  const auto result = CActiveAEBenchmark(config).Run();
+  Report(result);
+
+  EXPECT_GT(result.firstAudio, 0.0);
+}
+
+TEST_F(TestActiveAEBenchmark, DISABLED_LowLatency)
+{
+  CActiveAEBenchmark::Config config;
+  config.seconds = 1.0;
+  config.clockSpeed = 1.0;
+  const auto normal = CActiveAEBenchmark(config).Run();
+  Report(normal, "normal.");
+
+  config.lowLatency = true;
+  const auto low = CActiveAEBenchmark(config).Run();
+  Report(low, "low.");
+
+  // the engine buffers less, this doesn't depend on the timing of the run
+  EXPECT_GT(low.engineDelay, 0.0f);
+  EXPECT_LT(low.engineDelay, normal.engineDelay);
+}
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEQualityControl.h"
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr CActiveAEQualityControl::clock::duration DEADLINE = 50ms;
+
+class TestActiveAEQualityControl : public ::testing::Test
+{
+protected:
+  TestActiveAEQualityControl() { Reset(AE_QUALITY_HIGH); }
+
+  void Reset(AEQuality quality)
+  {
+    m_control.Reset(quality);
+    // the first pass starts the window
+    m_control.Update(m_now, 0ms, DEADLINE);
+  }
+
+  /*!
+   * \brief Run passes of the given length every 10ms for one window.
+   * \return number of quality changes
+   */
+  unsigned int RunWindow(CActiveAEQualityControl::clock::duration pass)
+  {
+    unsigned int changes = 0;
+    const auto end = m_now + CActiveAEQualityControl::WINDOW;
+    while (m_now < end)
+    {
+      m_now += std::max<CActiveAEQualityControl::clock::duration>(pass, 10ms);
+      if (m_control.Update(m_now, pass, DEADLINE))
+        changes++;
+    }
+    return changes;
+  }
+
+  CActiveAEQualityControl m_control;
+  CActiveAEQualityControl::clock::time_point m_now = CActiveAEQualityControl::clock::now();
+};
+} // namespace
+
+TEST_F(TestActiveAEQualityControl, DegradesOnLoad)
+{
+  EXPECT_EQ(0u, RunWindow(2ms));
+  EXPECT_EQ(AE_QUALITY_HIGH, m_control.GetQuality());
+
+  EXPECT_EQ(1u, RunWindow(6ms));
+  EXPECT_EQ(AE_QUALITY_MID, m_control.GetQuality());
+  EXPECT_EQ(1u, RunWindow(6ms));
+  EXPECT_EQ(AE_QUALITY_LOW, m_control.GetQuality());
+  EXPECT_EQ(0u, RunWindow(6ms));
+  EXPECT_EQ(AE_QUALITY_LOW, m_control.GetQuality());
+
+  const AEQualityStats& stats = m_control.GetStats();
+  EXPECT_EQ(2u, stats.degradations);
+  EXPECT_EQ(0u, stats.lateWindows);
+  EXPECT_EQ(0u, stats.dropoutsAvoided);
+  EXPECT_NEAR(0.6f, stats.load, 0.05f);
+}
+
+TEST_F(TestActiveAEQualityControl, LatePass)
+{
+  EXPECT_EQ(1u, RunWindow(60ms));
+  EXPECT_EQ(AE_QUALITY_MID, m_control.GetQuality());
+
+  // back on time at the lower quality
+  EXPECT_EQ(0u, RunWindow(2ms));
+  const AEQualityStats& stats = m_control.GetStats();
+  EXPECT_EQ(1u, stats.lateWindows);
+  EXPECT_EQ(1u, stats.dropoutsAvoided);
+}
+
+TEST_F(TestActiveAEQualityControl, Restore)
+{
+  RunWindow(6ms);
+  ASSERT_EQ(AE_QUALITY_MID, m_control.GetQuality());
+
+  // a busy window restarts the calm period
+  for (unsigned int i = 0; i < CActiveAEQualityControl::RESTORE_WINDOWS - 1; i++)
+    EXPECT_EQ(0u, RunWindow(1ms));
+  EXPECT_EQ(0u, RunWindow(3ms));
+  for (unsigned int i = 0; i < CActiveAEQualityControl::RESTORE_WINDOWS - 1; i++)
+    EXPECT_EQ(0u, RunWindow(1ms));
+  EXPECT_EQ(1u, RunWindow(1ms));
+  EXPECT_EQ(AE_QUALITY_HIGH, m_control.GetQuality());
+  EXPECT_FALSE(m_control.IsDegraded());
+
+  // degrading right after the restore doubles the next calm period
+  RunWindow(6ms);
+  ASSERT_EQ(AE_QUALITY_MID, m_control.GetQuality());
+  for (unsigned int i = 0; i < CActiveAEQualityControl::RESTORE_WINDOWS * 2 - 1; i++)
+    EXPECT_EQ(0u, RunWindow(1ms));
+  EXPECT_EQ(1u, RunWindow(1ms));
+  EXPECT_EQ(2u, m_control.GetStats().restores);
+}
+
+TEST_F(TestActiveAEQualityControl, UserQuality)
+{
+  // never above what the user configured
+  Reset(AE_QUALITY_MID);
+  RunWindow(6ms);
+  ASSERT_EQ(AE_QUALITY_LOW, m_control.GetQuality());
+  for (unsigned int i = 0; i < CActiveAEQualityControl::RESTORE_WINDOWS * 3; i++)
+    RunWindow(1ms);
+  EXPECT_EQ(AE_QUALITY_MID, m_control.GetQuality());
+
+  // levels without swr options have nothing to save
+  Reset(AE_QUALITY_REALLYHIGH);
+  EXPECT_EQ(0u, RunWindow(60ms));
+  EXPECT_EQ(AE_QUALITY_REALLYHIGH, m_control.GetQuality());
+}
@@ -12,6 +12,8 @@
 //
 //////////////////////////////////////////////////////////////////////
 
+class CAESpectrum;
+
 class IAudioCallback
 {
 public:
@@ -19,5 +21,16 @@ public:
   virtual ~IAudioCallback() = default;
   virtual void OnInitialize(int iChannels, int iSamplesPerSec, int iBitsPerSample) = 0;
   virtual void OnAudioData(const float* pAudioData, unsigned int iAudioDataLength) = 0;
+
+  /*!
+   * \brief Audio data along with its spectrum, which the engine computes once for all
+   * callbacks. Called instead of OnAudioData by engines that analyse the audio.
+   */
+  virtual void OnAudioSpectrum(const float* pAudioData,
+                               unsigned int iAudioDataLength,
+                               const CAESpectrum& spectrum)
+  {
+    OnAudioData(pAudioData, iAudioDataLength);
+  }
 };
 
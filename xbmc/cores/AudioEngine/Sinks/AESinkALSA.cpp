@@ -734,6 +734,16 @@ bool CAESinkALSA::InitializeHW(const ALSAConfig &inconfig, ALSAConfig &outconfig
   */
   periodSize = std::min(periodSize, bufferSize / 4);
 
+  /*
+   The engine asks for short periods in low latency mode, keep 4 of them in the buffer.
+   Passthrough bursts need the full sizes.
+  */
+  if (m_initFormat.m_frames > 0 && !m_passthrough)
+  {
+    periodSize = std::min(periodSize, static_cast<snd_pcm_uframes_t>(m_initFormat.m_frames));
+    bufferSize = std::min(bufferSize, periodSize * 4);
+  }
+
   CLog::Log(LOGDEBUG, "CAESinkALSA::InitializeHW - Request: periodSize {}, bufferSize {}",
             periodSize, bufferSize);
 
@@ -0,0 +1,337 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AESinkNULL.h"
+
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/XTimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// period and buffer of the simulated device, similar to what ALSA or PulseAudio get
+constexpr unsigned int PERIOD_MS = 20;
+constexpr unsigned int PERIODS = 4;
+
+// anything below is treated as silence, leaves room for dither and stream noise
+constexpr float SIGNAL_THRESHOLD = 1.0f / 1024;
+
+constexpr char DEVICE_NULL[] = "null";
+constexpr char DEVICE_WAV[] = "wav";
+constexpr char DEFAULT_WAV_PATH[] = "special://temp/audiosink.wav";
+
+constexpr uint16_t WAVE_FORMAT_PCM = 1;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+constexpr uint32_t WAV_HEADER_SIZE = 44;
+
+CCriticalSection statsSection;
+CAESinkNULL::Stats stats;
+double clockSpeed = 1.0;
+
+void PutLE16(uint8_t* p, uint16_t v)
+{
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+void PutLE32(uint8_t* p, uint32_t v)
+{
+  p[0] = v & 0xFF;
+  p[1] = (v >> 8) & 0xFF;
+  p[2] = (v >> 16) & 0xFF;
+  p[3] = v >> 24;
+}
+} // namespace
+
+CAESinkNULL::~CAESinkNULL()
+{
+  Deinitialize();
+}
+
+void CAESinkNULL::Register()
+{
+  AE::AESinkRegEntry entry;
+  entry.sinkName = "NULL";
+  entry.createFunc = CAESinkNULL::Create;
+  entry.enumerateFunc = CAESinkNULL::EnumerateDevicesEx;
+  AE::CAESinkFactory::RegisterSink(entry);
+}
+
+IAESink* CAESinkNULL::Create(std::string& device, AEAudioFormat& desiredFormat)
+{
+  IAESink* sink = new CAESinkNULL();
+  if (sink->Initialize(desiredFormat, device))
+    return sink;
+
+  delete sink;
+  return nullptr;
+}
+
+void CAESinkNULL::EnumerateDevicesEx(AEDeviceInfoList& list, bool force)
+{
+  for (const char* name : {DEVICE_NULL, DEVICE_WAV})
+  {
+    CAEDeviceInfo info;
+    info.m_deviceName = name;
+    info.m_displayName = name == DEVICE_NULL ? "Null output" : "WAV file output";
+    info.m_displayNameExtra = "";
+    info.m_deviceType = AE_DEVTYPE_HDMI;
+    info.m_channels = AE_CH_LAYOUT_7_1;
+    info.m_sampleRates = {32000, 44100, 48000, 88200, 96000, 176400, 192000};
+    info.m_dataFormats = {AE_FMT_FLOAT, AE_FMT_S32NE, AE_FMT_S16NE, AE_FMT_RAW};
+    info.m_streamTypes = {CAEStreamInfo::STREAM_TYPE_AC3,      CAEStreamInfo::STREAM_TYPE_EAC3,
+                          CAEStreamInfo::STREAM_TYPE_DTSHD_CORE, CAEStreamInfo::STREAM_TYPE_DTS_512,
+                          CAEStreamInfo::STREAM_TYPE_DTS_1024, CAEStreamInfo::STREAM_TYPE_DTS_2048,
+                          CAEStreamInfo::STREAM_TYPE_DTSHD,    CAEStreamInfo::STREAM_TYPE_DTSHD_MA,
+                          CAEStreamInfo::STREAM_TYPE_TRUEHD};
+    info.m_wantsIECPassthrough = true;
+    list.push_back(info);
+  }
+}
+
+void CAESinkNULL::SetClockSpeed(double speed)
+{
+  CSingleLock lock(statsSection);
+  clockSpeed = std::max(speed, 0.0);
+}
+
+CAESinkNULL::Stats CAESinkNULL::GetStats()
+{
+  CSingleLock lock(statsSection);
+  return stats;
+}
+
+void CAESinkNULL::ResetStats()
+{
+  CSingleLock lock(statsSection);
+  stats = Stats();
+}
+
+bool CAESinkNULL::Initialize(AEAudioFormat& format, std::string& device)
+{
+  if (format.m_sampleRate == 0 || format.m_channelLayout.Count() == 0)
+    return false;
+
+  if (format.m_dataFormat == AE_FMT_RAW)
+  {
+    // IEC 61937 bursts are carried as 16 bit frames
+    format.m_frameSize = 2 * format.m_channelLayout.Count();
+  }
+  else
+  {
+    if (format.m_dataFormat != AE_FMT_S16NE && format.m_dataFormat != AE_FMT_S32NE)
+      format.m_dataFormat = AE_FMT_FLOAT;
+    format.m_frameSize =
+        (CAEUtil::DataFormatToBits(format.m_dataFormat) >> 3) * format.m_channelLayout.Count();
+  }
+  // honour the period the engine asks for, but not above the default
+  const unsigned int period = format.m_sampleRate * PERIOD_MS / 1000;
+  if (format.m_frames == 0 || format.m_frames > period)
+    format.m_frames = period;
+
+  m_format = format;
+  m_bufferFrames = format.m_frames * PERIODS;
+  m_written = 0;
+  m_played = 0.0;
+  m_lastUpdate = std::chrono::steady_clock::now();
+  {
+    CSingleLock lock(statsSection);
+    m_speed = clockSpeed;
+    stats.sampleRate = format.m_sampleRate;
+  }
+
+  if (!StringUtils::EqualsNoCase(device, DEVICE_NULL))
+  {
+    const std::string path = StringUtils::EqualsNoCase(device, DEVICE_WAV) ? DEFAULT_WAV_PATH
+                                                                           : device;
+    if (!m_file.OpenForWrite(path, true))
+    {
+      CLog::Log(LOGERROR, "CAESinkNULL::Initialize - failed to open {}", path);
+      return false;
+    }
+    m_isFileOpen = true;
+    m_dataBytes = 0;
+    if (!WriteWavHeader())
+    {
+      Deinitialize();
+      return false;
+    }
+  }
+
+  CLog::Log(LOGDEBUG, "CAESinkNULL::Initialize - {} {}Hz {} channels, clock speed {}", device,
+            format.m_sampleRate, format.m_channelLayout.Count(), m_speed);
+  return true;
+}
+
+void CAESinkNULL::Deinitialize()
+{
+  if (m_isFileOpen)
+  {
+    // sizes were left open while writing
+    WriteWavHeader();
+    m_file.Close();
+    m_isFileOpen = false;
+  }
+}
+
+double CAESinkNULL::GetCacheTotal()
+{
+  return FramesToTime(m_bufferFrames).count();
+}
+
+unsigned int CAESinkNULL::AddPackets(uint8_t** data, unsigned int frames, unsigned int offset)
+{
+  UpdateClock();
+
+  // a device blocks until a period was played, a clock without speed just plays it
+  double space = m_bufferFrames - (m_written - m_played);
+  if (space < 1.0 && m_speed <= 0.0)
+  {
+    m_played = static_cast<double>(m_written + m_format.m_frames - m_bufferFrames);
+    space = m_format.m_frames;
+  }
+  while (space < 1.0)
+  {
+    KODI::TIME::Sleep(std::chrono::duration_cast<std::chrono::microseconds>(
+        FramesToTime(m_format.m_frames - space)));
+    UpdateClock();
+    space = m_bufferFrames - (m_written - m_played);
+  }
+
+  const unsigned int count = std::min(frames, static_cast<unsigned int>(std::max(space, 0.0)));
+  if (count == 0)
+    return 0;
+
+  const uint8_t* buffer = data[0] + offset * m_format.m_frameSize;
+  if (m_isFileOpen)
+  {
+    const ssize_t size = count * m_format.m_frameSize;
+    if (m_file.Write(buffer, size) == size)
+      m_dataBytes += size;
+  }
+
+  m_written += count;
+
+  CSingleLock lock(statsSection);
+  stats.frames += count;
+  if (!stats.hasSignal && HasSignal(buffer, count))
+  {
+    stats.hasSignal = true;
+    stats.firstSignal = std::chrono::steady_clock::now();
+  }
+
+  return count;
+}
+
+void CAESinkNULL::AddPause(unsigned int millis)
+{
+  if (m_speed > 0.0)
+    KODI::TIME::Sleep(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::milliseconds(millis) / m_speed));
+}
+
+void CAESinkNULL::GetDelay(AEDelayStatus& status)
+{
+  UpdateClock();
+  status.SetDelay(FramesToTime(m_written - m_played).count());
+}
+
+void CAESinkNULL::Drain()
+{
+  UpdateClock();
+  if (m_speed > 0.0)
+    KODI::TIME::Sleep(std::chrono::duration_cast<std::chrono::microseconds>(
+        FramesToTime(m_written - m_played)));
+  m_played = static_cast<double>(m_written);
+}
+
+void CAESinkNULL::UpdateClock()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (m_speed > 0.0)
+  {
+    const std::chrono::duration<double> elapsed = now - m_lastUpdate;
+    m_played = std::min(m_played + elapsed.count() * m_format.m_sampleRate * m_speed,
+                        static_cast<double>(m_written));
+  }
+  m_lastUpdate = now;
+}
+
+std::chrono::duration<double> CAESinkNULL::FramesToTime(double frames) const
+{
+  // wall clock time, so delays stay consistent with a sped up clock
+  const double speed = m_speed > 0.0 ? m_speed : 1.0;
+  return std::chrono::duration<double>(frames / (m_format.m_sampleRate * speed));
+}
+
+bool CAESinkNULL::HasSignal(const uint8_t* buffer, unsigned int frames) const
+{
+  const unsigned int samples = frames * m_format.m_channelLayout.Count();
+  switch (m_format.m_dataFormat)
+  {
+    case AE_FMT_FLOAT:
+    {
+      const float* p = reinterpret_cast<const float*>(buffer);
+      return std::any_of(p, p + samples,
+                         [](float s) { return std::fabs(s) > SIGNAL_THRESHOLD; });
+    }
+    case AE_FMT_S32NE:
+    {
+      const int32_t* p = reinterpret_cast<const int32_t*>(buffer);
+      return std::any_of(p, p + samples, [](int32_t s) {
+        return std::abs(static_cast<int64_t>(s)) > static_cast<int64_t>(SIGNAL_THRESHOLD * INT32_MAX);
+      });
+    }
+    case AE_FMT_S16NE:
+    {
+      const int16_t* p = reinterpret_cast<const int16_t*>(buffer);
+      return std::any_of(p, p + samples, [](int16_t s) {
+        return std::abs(static_cast<int>(s)) > static_cast<int>(SIGNAL_THRESHOLD * INT16_MAX);
+      });
+    }
+    default:
+      // bitstreams carry silence as encoded frames
+      return false;
+  }
+}
+
+bool CAESinkNULL::WriteWavHeader()
+{
+  const bool isFloat = m_format.m_dataFormat == AE_FMT_FLOAT;
+  const uint16_t channels = m_format.m_channelLayout.Count();
+  const uint16_t bitsPerSample = static_cast<uint16_t>(m_format.m_frameSize * 8 / channels);
+
+  uint8_t header[WAV_HEADER_SIZE];
+  memcpy(header, "RIFF", 4);
+  PutLE32(header + 4, WAV_HEADER_SIZE - 8 + m_dataBytes);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  PutLE32(header + 16, 16);
+  PutLE16(header + 20, isFloat ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM);
+  PutLE16(header + 22, channels);
+  PutLE32(header + 24, m_format.m_sampleRate);
+  PutLE32(header + 28, m_format.m_sampleRate * m_format.m_frameSize);
+  PutLE16(header + 32, static_cast<uint16_t>(m_format.m_frameSize));
+  PutLE16(header + 34, bitsPerSample);
+  memcpy(header + 36, "data", 4);
+  PutLE32(header + 40, m_dataBytes);
+
+  const int64_t pos = m_file.GetPosition();
+  if (pos > 0)
+    m_file.Seek(0, SEEK_SET);
+  const bool ok = m_file.Write(header, sizeof(header)) == sizeof(header);
+  if (pos > 0)
+    m_file.Seek(pos, SEEK_SET);
+  return ok;
+}
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AESink.h"
+#include "cores/AudioEngine/Utils/AEDeviceInfo.h"
+#include "filesystem/File.h"
+
+#include <chrono>
+#include <stdint.h>
+
+/*!
+ * \brief Sink without an audio device, for headless hosts and for measuring the engine.
+ *
+ * The device "null" discards all data, any other device name is taken as the path of a
+ * WAV file the output is written to. Consumption follows a simulated device clock with a
+ * buffer of a few periods, so delay and blocking behave like a real device. The clock
+ * can be sped up, or run as fast as data arrives, to process audio faster than realtime.
+ */
+class CAESinkNULL : public IAESink
+{
+public:
+  const char* GetName() override { return "NULL"; }
+
+  CAESinkNULL() = default;
+  ~CAESinkNULL() override;
+
+  static void Register();
+  static IAESink* Create(std::string& device, AEAudioFormat& desiredFormat);
+  static void EnumerateDevicesEx(AEDeviceInfoList& list, bool force = false);
+
+  /*!
+   * \brief Set the speed of the device clock for sinks created afterwards.
+   * \param speed multiple of realtime, 0 consumes data as fast as it is added
+   */
+  static void SetClockSpeed(double speed);
+
+  struct Stats
+  {
+    uint64_t frames = 0; ///< frames consumed since ResetStats()
+    unsigned int sampleRate = 0; ///< rate of the last opened sink
+    bool hasSignal = false; ///< a non-silent frame was consumed
+    std::chrono::steady_clock::time_point firstSignal; ///< when hasSignal became true
+  };
+
+  /*!
+   * \brief Totals of all null sinks, used by benchmarks.
+   */
+  static Stats GetStats();
+  static void ResetStats();
+
+  bool Initialize(AEAudioFormat& format, std::string& device) override;
+  void Deinitialize() override;
+
+  double GetCacheTotal() override;
+  unsigned int AddPackets(uint8_t** data, unsigned int frames, unsigned int offset) override;
+  void AddPause(unsigned int millis) override;
+  void GetDelay(AEDelayStatus& status) override;
+  void Drain() override;
+
+private:
+  void UpdateClock();
+  std::chrono::duration<double> FramesToTime(double frames) const;
+  bool HasSignal(const uint8_t* buffer, unsigned int frames) const;
+  bool WriteWavHeader();
+
+  AEAudioFormat m_format;
+  double m_speed = 1.0;
+  unsigned int m_bufferFrames = 0;
+  uint64_t m_written = 0;
+  double m_played = 0.0;
+  std::chrono::steady_clock::time_point m_lastUpdate;
+
+  XFILE::CFile m_file;
+  bool m_isFileOpen = false;
+  uint32_t m_dataBytes = 0;
+};
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "filesystem/File.h"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+AEAudioFormat MakeFormat(AEDataFormat dataFormat, unsigned int sampleRate)
+{
+  AEAudioFormat format;
+  format.m_dataFormat = dataFormat;
+  format.m_sampleRate = sampleRate;
+  format.m_channelLayout = AE_CH_LAYOUT_2_0;
+  return format;
+}
+
+uint32_t ReadLE32(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+} // namespace
+
+class TestAESinkNULL : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    CAESinkNULL::SetClockSpeed(0.0);
+    CAESinkNULL::ResetStats();
+  }
+
+  void TearDown() override { CAESinkNULL::SetClockSpeed(1.0); }
+};
+
+TEST_F(TestAESinkNULL, NegotiatesInterleavedFormat)
+{
+  CAESinkNULL sink;
+  std::string device = "null";
+  AEAudioFormat format = MakeFormat(AE_FMT_FLOATP, 48000);
+
+  ASSERT_TRUE(sink.Initialize(format, device));
+  EXPECT_EQ(AE_FMT_FLOAT, format.m_dataFormat);
+  EXPECT_EQ(8u, format.m_frameSize);
+  EXPECT_EQ(960u, format.m_frames);
+}
+
+TEST_F(TestAESinkNULL, UnpacedClockNeverBlocks)
+{
+  CAESinkNULL sink;
+  std::string device = "null";
+  AEAudioFormat format = MakeFormat(AE_FMT_S16NE, 48000);
+  ASSERT_TRUE(sink.Initialize(format, device));
+
+  // every period of ten seconds of audio is taken at once, a full buffer is played instantly
+  std::vector<int16_t> samples(format.m_frames * 2, 0);
+  uint8_t* data[] = {reinterpret_cast<uint8_t*>(samples.data())};
+  const auto start = std::chrono::steady_clock::now();
+  unsigned int frames = 0;
+  while (frames < format.m_sampleRate * 10)
+  {
+    const unsigned int added = sink.AddPackets(data, format.m_frames, 0);
+    ASSERT_EQ(format.m_frames, added);
+    frames += added;
+  }
+  RecordProperty("elapsedMs", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                   std::chrono::steady_clock::now() - start)
+                                                   .count()));
+
+  AEDelayStatus status;
+  sink.GetDelay(status);
+  EXPECT_GT(status.delay, 0.0);
+  EXPECT_LE(status.delay, sink.GetCacheTotal());
+
+  const CAESinkNULL::Stats stats = CAESinkNULL::GetStats();
+  EXPECT_EQ(frames, stats.frames);
+  EXPECT_FALSE(stats.hasSignal);
+}
+
+TEST_F(TestAESinkNULL, DetectsSignal)
+{
+  CAESinkNULL sink;
+  std::string device = "null";
+  AEAudioFormat format = MakeFormat(AE_FMT_FLOAT, 44100);
+  ASSERT_TRUE(sink.Initialize(format, device));
+
+  std::vector<float> samples(format.m_frames * 2, 0.0f);
+  uint8_t* data[] = {reinterpret_cast<uint8_t*>(samples.data())};
+  sink.AddPackets(data, format.m_frames, 0);
+  EXPECT_FALSE(CAESinkNULL::GetStats().hasSignal);
+
+  samples[10] = 0.5f;
+  sink.AddPackets(data, format.m_frames, 0);
+  EXPECT_TRUE(CAESinkNULL::GetStats().hasSignal);
+}
+
+TEST_F(TestAESinkNULL, WritesWavFile)
+{
+  const std::string path = "special://temp/TestAESinkNULL.wav";
+  {
+    CAESinkNULL sink;
+    std::string device = path;
+    AEAudioFormat format = MakeFormat(AE_FMT_S16NE, 48000);
+    ASSERT_TRUE(sink.Initialize(format, device));
+
+    std::vector<int16_t> samples(format.m_frames * 2, 1000);
+    uint8_t* data[] = {reinterpret_cast<uint8_t*>(samples.data())};
+    EXPECT_EQ(format.m_frames, sink.AddPackets(data, format.m_frames, 0));
+    sink.Deinitialize();
+  }
+
+  XFILE::CFile file;
+  ASSERT_TRUE(file.Open(path));
+  uint8_t header[44];
+  ASSERT_EQ(44, file.Read(header, sizeof(header)));
+  EXPECT_EQ(0, memcmp(header, "RIFF", 4));
+  EXPECT_EQ(0, memcmp(header + 8, "WAVEfmt ", 8));
+  EXPECT_EQ(48000u, ReadLE32(header + 24));
+  EXPECT_EQ(960u * 4, ReadLE32(header + 40));
+  EXPECT_EQ(44 + 960 * 4, file.GetLength());
+  file.Close();
+
+  XFILE::CFile::Delete(path);
+}
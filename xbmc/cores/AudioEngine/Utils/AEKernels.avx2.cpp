@@ -0,0 +1,273 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#include <immintrin.h>
+
+// This file is built with -mavx2 and only called after a cpu check. It must not
+// instantiate inline functions or templates of other headers, the linker could pick
+// this copy for callers that run on any cpu.
+
+namespace
+{
+constexpr float S16_SCALE = 32768.0f;
+constexpr float S16_MAX = 32767.0f;
+constexpr float S32_SCALE = 2147483648.0f;
+constexpr float S32_MAX = 2147483520.0f;
+
+inline __m256 Abs(__m256 v)
+{
+  return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF)));
+}
+
+inline float Abs(float v)
+{
+  return v < 0.0f ? -v : v;
+}
+
+inline int32_t Round(float v, float min, float max)
+{
+  v = v < min ? min : v;
+  v = v > max ? max : v;
+  return _mm_cvtss_si32(_mm_set_ss(v));
+}
+
+void Mul(float* data, float mul, unsigned int count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+  for (; i < count; i++)
+    data[i] *= mul;
+}
+
+void MulAdd(float* dst, const float* src, float mul, unsigned int count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i),
+                                            _mm256_mul_ps(_mm256_loadu_ps(src + i), m)));
+  for (; i < count; i++)
+    dst[i] += src[i] * mul;
+}
+
+inline __m256 LoadGain2(const float* gain)
+{
+  // g0 g0 g1 g1 g2 g2 g3 g3
+  const __m256i index = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+  return _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(gain)), index);
+}
+
+void MulFrames(float* data, const float* gain, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 8 <= frames; f += 8)
+      _mm256_storeu_ps(data + f,
+                       _mm256_mul_ps(_mm256_loadu_ps(data + f), _mm256_loadu_ps(gain + f)));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+      _mm256_storeu_ps(data + f * 2, _mm256_mul_ps(_mm256_loadu_ps(data + f * 2), LoadGain2(gain + f)));
+  }
+  else
+  {
+    for (; f < frames; f++)
+      Mul(data + f * channels, gain[f], channels);
+  }
+
+  for (; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      data[f * channels + c] *= gain[f];
+}
+
+void MulAddFrames(
+    float* dst, const float* src, const float* gain, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 8 <= frames; f += 8)
+      _mm256_storeu_ps(dst + f, _mm256_add_ps(_mm256_loadu_ps(dst + f),
+                                              _mm256_mul_ps(_mm256_loadu_ps(src + f),
+                                                            _mm256_loadu_ps(gain + f))));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+      _mm256_storeu_ps(dst + f * 2, _mm256_add_ps(_mm256_loadu_ps(dst + f * 2),
+                                                  _mm256_mul_ps(_mm256_loadu_ps(src + f * 2),
+                                                                LoadGain2(gain + f))));
+  }
+  else
+  {
+    for (; f < frames; f++)
+      MulAdd(dst + f * channels, src + f * channels, gain[f], channels);
+  }
+
+  for (; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      dst[f * channels + c] += src[f * channels + c] * gain[f];
+}
+
+void PeakFrames(float* peak, const float* data, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 8 <= frames; f += 8)
+      _mm256_storeu_ps(peak + f,
+                       _mm256_max_ps(_mm256_loadu_ps(peak + f), Abs(_mm256_loadu_ps(data + f))));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 8 <= frames; f += 8)
+    {
+      const __m256 a = Abs(_mm256_loadu_ps(data + f * 2));
+      const __m256 b = Abs(_mm256_loadu_ps(data + f * 2 + 8));
+      // shuffles work per 128 bit lane, the frames end up as 0 1 4 5 2 3 6 7
+      const __m256 max = _mm256_max_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                                       _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+      const __m256 ordered =
+          _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(max), _MM_SHUFFLE(3, 1, 2, 0)));
+      _mm256_storeu_ps(peak + f, _mm256_max_ps(_mm256_loadu_ps(peak + f), ordered));
+    }
+  }
+
+  for (; f < frames; f++)
+  {
+    for (unsigned int c = 0; c < channels; c++)
+    {
+      const float sample = Abs(data[f * channels + c]);
+      if (sample > peak[f])
+        peak[f] = sample;
+    }
+  }
+}
+
+float MaxAbs(const float* data, unsigned int count)
+{
+  __m256 peak8 = _mm256_setzero_ps();
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    peak8 = _mm256_max_ps(peak8, Abs(_mm256_loadu_ps(data + i)));
+
+  __m128 peak = _mm_max_ps(_mm256_castps256_ps128(peak8), _mm256_extractf128_ps(peak8, 1));
+  peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+  peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, _MM_SHUFFLE(1, 1, 1, 1)));
+  float result = _mm_cvtss_f32(peak);
+
+  for (; i < count; i++)
+  {
+    const float sample = Abs(data[i]);
+    if (sample > result)
+      result = sample;
+  }
+  return result;
+}
+
+inline __m256i ToS32(__m256 v, __m256 scale, __m256 min, __m256 max)
+{
+  return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v, scale), min), max));
+}
+
+void FloatToS16(int16_t* dst, const float* src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(S16_SCALE);
+  const __m256 min = _mm256_set1_ps(-S16_SCALE);
+  const __m256 max = _mm256_set1_ps(S16_MAX);
+  unsigned int i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m256i lo = ToS32(_mm256_loadu_ps(src + i), scale, min, max);
+    const __m256i hi = ToS32(_mm256_loadu_ps(src + i + 8), scale, min, max);
+    // packs works per lane, put the quarters back in order
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+  }
+  for (; i < count; i++)
+    dst[i] = static_cast<int16_t>(Round(src[i] * S16_SCALE, -S16_SCALE, S16_MAX));
+}
+
+void FloatToS32(int32_t* dst, const float* src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(S32_SCALE);
+  const __m256 min = _mm256_set1_ps(-S32_SCALE);
+  const __m256 max = _mm256_set1_ps(S32_MAX);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        ToS32(_mm256_loadu_ps(src + i), scale, min, max));
+  for (; i < count; i++)
+    dst[i] = Round(src[i] * S32_SCALE, -S32_SCALE, S32_MAX);
+}
+
+void S16ToFloat(float* dst, const int16_t* src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(1.0f / S16_SCALE);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v)), scale));
+  }
+  for (; i < count; i++)
+    dst[i] = static_cast<float>(src[i]) * (1.0f / S16_SCALE);
+}
+
+void S32ToFloat(float* dst, const int32_t* src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(1.0f / S32_SCALE);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(
+                                                reinterpret_cast<const __m256i*>(src + i))),
+                                            scale));
+  for (; i < count; i++)
+    dst[i] = static_cast<float>(src[i]) * (1.0f / S32_SCALE);
+}
+
+void SwapBytes16(uint8_t* dst, const uint8_t* src, unsigned int count)
+{
+  const __m256i shuffle = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                           1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  unsigned int i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_shuffle_epi8(v, shuffle));
+  }
+  for (; i < count; i++)
+  {
+    const uint8_t first = src[i * 2];
+    dst[i * 2] = src[i * 2 + 1];
+    dst[i * 2 + 1] = first;
+  }
+}
+} // namespace
+
+void AEKernelsSetupAVX2(AEKernels& kernels)
+{
+  // interleaving and the sync search are bound by memory, the SSE2 versions are kept
+  kernels.Mul = Mul;
+  kernels.MulAdd = MulAdd;
+  kernels.MulFrames = MulFrames;
+  kernels.MulAddFrames = MulAddFrames;
+  kernels.PeakFrames = PeakFrames;
+  kernels.MaxAbs = MaxAbs;
+  kernels.FloatToS16 = FloatToS16;
+  kernels.FloatToS32 = FloatToS32;
+  kernels.S16ToFloat = S16ToFloat;
+  kernels.S32ToFloat = S32ToFloat;
+  kernels.SwapBytes16 = SwapBytes16;
+}
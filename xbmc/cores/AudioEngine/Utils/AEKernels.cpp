@@ -0,0 +1,522 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <math.h>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// implemented in AEKernels.avx2.cpp and AEKernels.neon.cpp, which are built with the flags
+// of their instruction set and replace the kernels they have a faster version of
+#if defined(HAVE_AEKERNELS_AVX2)
+void AEKernelsSetupAVX2(AEKernels& kernels);
+#endif
+#if defined(HAVE_AEKERNELS_NEON)
+void AEKernelsSetupNEON(AEKernels& kernels);
+#endif
+
+namespace
+{
+constexpr float S16_SCALE = 32768.0f;
+constexpr float S16_MAX = 32767.0f;
+constexpr float S32_SCALE = 2147483648.0f;
+// largest float below 2^31, INT32_MAX itself isn't representable
+constexpr float S32_MAX = 2147483520.0f;
+
+namespace SCALAR
+{
+void Mul(float* data, float mul, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    data[i] *= mul;
+}
+
+void MulAdd(float* dst, const float* src, float mul, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    dst[i] += src[i] * mul;
+}
+
+void MulFrames(float* data, const float* gain, unsigned int frames, unsigned int channels)
+{
+  for (unsigned int f = 0; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      *data++ *= gain[f];
+}
+
+void MulAddFrames(
+    float* dst, const float* src, const float* gain, unsigned int frames, unsigned int channels)
+{
+  for (unsigned int f = 0; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      *dst++ += *src++ * gain[f];
+}
+
+void PeakFrames(float* peak, const float* data, unsigned int frames, unsigned int channels)
+{
+  for (unsigned int f = 0; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      peak[f] = std::max(peak[f], fabsf(*data++));
+}
+
+float MaxAbs(const float* data, unsigned int count)
+{
+  float peak = 0.0f;
+  for (unsigned int i = 0; i < count; i++)
+    peak = std::max(peak, fabsf(data[i]));
+  return peak;
+}
+
+void Interleave(float* dst, const float* const* src, unsigned int frames, unsigned int channels)
+{
+  for (unsigned int f = 0; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      *dst++ = src[c][f];
+}
+
+void Deinterleave(float* const* dst, const float* src, unsigned int frames, unsigned int channels)
+{
+  for (unsigned int f = 0; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      dst[c][f] = *src++;
+}
+
+void FloatToS16(int16_t* dst, const float* src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    dst[i] = static_cast<int16_t>(lrintf(std::min(std::max(src[i] * S16_SCALE, -S16_SCALE), S16_MAX)));
+}
+
+void FloatToS32(int32_t* dst, const float* src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    dst[i] = static_cast<int32_t>(lrintf(std::min(std::max(src[i] * S32_SCALE, -S32_SCALE), S32_MAX)));
+}
+
+void S16ToFloat(float* dst, const int16_t* src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    dst[i] = static_cast<float>(src[i]) * (1.0f / S16_SCALE);
+}
+
+void S32ToFloat(float* dst, const int32_t* src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    dst[i] = static_cast<float>(src[i]) * (1.0f / S32_SCALE);
+}
+
+void SwapBytes16(uint8_t* dst, const uint8_t* src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++, dst += 2, src += 2)
+  {
+    const uint8_t first = src[0];
+    dst[0] = src[1];
+    dst[1] = first;
+  }
+}
+
+unsigned int FindSync(const uint8_t* data, unsigned int size)
+{
+  for (unsigned int i = 0; i + 1 < size; i++)
+  {
+    switch (data[i] << 8 | data[i + 1])
+    {
+      case 0x0B77:
+      case 0x7FFE:
+      case 0xFE7F:
+      case 0x1FFF:
+      case 0xFF1F:
+      case 0xF872:
+        return i;
+    }
+  }
+  return size ? size - 1 : 0;
+}
+} // namespace SCALAR
+
+const AEKernels kernelsScalar = {
+    "scalar",
+    SCALAR::Mul,
+    SCALAR::MulAdd,
+    SCALAR::MulFrames,
+    SCALAR::MulAddFrames,
+    SCALAR::PeakFrames,
+    SCALAR::MaxAbs,
+    SCALAR::Interleave,
+    SCALAR::Deinterleave,
+    SCALAR::FloatToS16,
+    SCALAR::FloatToS32,
+    SCALAR::S16ToFloat,
+    SCALAR::S32ToFloat,
+    SCALAR::SwapBytes16,
+    SCALAR::FindSync,
+};
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+namespace SSE2
+{
+inline __m128 Abs(__m128 v)
+{
+  return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+}
+
+void Mul(float* data, float mul, unsigned int count)
+{
+  const __m128 m = _mm_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), m));
+  SCALAR::Mul(data + i, mul, count - i);
+}
+
+void MulAdd(float* dst, const float* src, float mul, unsigned int count)
+{
+  const __m128 m = _mm_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), m)));
+  SCALAR::MulAdd(dst + i, src + i, mul, count - i);
+}
+
+void MulFrames(float* data, const float* gain, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 4 <= frames; f += 4)
+      _mm_storeu_ps(data + f, _mm_mul_ps(_mm_loadu_ps(data + f), _mm_loadu_ps(gain + f)));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const __m128 g = _mm_loadu_ps(gain + f);
+      float* p = data + f * 2;
+      _mm_storeu_ps(p, _mm_mul_ps(_mm_loadu_ps(p), _mm_unpacklo_ps(g, g)));
+      _mm_storeu_ps(p + 4, _mm_mul_ps(_mm_loadu_ps(p + 4), _mm_unpackhi_ps(g, g)));
+    }
+  }
+  else
+  {
+    for (; f < frames; f++)
+    {
+      const __m128 g = _mm_set1_ps(gain[f]);
+      float* p = data + f * channels;
+      unsigned int c = 0;
+      for (; c + 4 <= channels; c += 4)
+        _mm_storeu_ps(p + c, _mm_mul_ps(_mm_loadu_ps(p + c), g));
+      SCALAR::Mul(p + c, gain[f], channels - c);
+    }
+  }
+  SCALAR::MulFrames(data + f * channels, gain + f, frames - f, channels);
+}
+
+void MulAddFrames(
+    float* dst, const float* src, const float* gain, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 4 <= frames; f += 4)
+      _mm_storeu_ps(dst + f, _mm_add_ps(_mm_loadu_ps(dst + f),
+                                        _mm_mul_ps(_mm_loadu_ps(src + f), _mm_loadu_ps(gain + f))));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const __m128 g = _mm_loadu_ps(gain + f);
+      float* d = dst + f * 2;
+      const float* s = src + f * 2;
+      _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), _mm_mul_ps(_mm_loadu_ps(s), _mm_unpacklo_ps(g, g))));
+      _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4),
+                                      _mm_mul_ps(_mm_loadu_ps(s + 4), _mm_unpackhi_ps(g, g))));
+    }
+  }
+  else
+  {
+    for (; f < frames; f++)
+      MulAdd(dst + f * channels, src + f * channels, gain[f], channels);
+  }
+  SCALAR::MulAddFrames(dst + f * channels, src + f * channels, gain + f, frames - f, channels);
+}
+
+void PeakFrames(float* peak, const float* data, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 4 <= frames; f += 4)
+      _mm_storeu_ps(peak + f, _mm_max_ps(_mm_loadu_ps(peak + f), Abs(_mm_loadu_ps(data + f))));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const __m128 a = Abs(_mm_loadu_ps(data + f * 2));
+      const __m128 b = Abs(_mm_loadu_ps(data + f * 2 + 4));
+      const __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+      const __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+      _mm_storeu_ps(peak + f, _mm_max_ps(_mm_loadu_ps(peak + f), _mm_max_ps(left, right)));
+    }
+  }
+  SCALAR::PeakFrames(peak + f, data + f * channels, frames - f, channels);
+}
+
+float MaxAbs(const float* data, unsigned int count)
+{
+  __m128 peak = _mm_setzero_ps();
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    peak = _mm_max_ps(peak, Abs(_mm_loadu_ps(data + i)));
+  peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+  peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, _MM_SHUFFLE(1, 1, 1, 1)));
+  return std::max(_mm_cvtss_f32(peak), SCALAR::MaxAbs(data + i, count - i));
+}
+
+void Interleave(float* dst, const float* const* src, unsigned int frames, unsigned int channels)
+{
+  if (channels != 2)
+  {
+    SCALAR::Interleave(dst, src, frames, channels);
+    return;
+  }
+
+  unsigned int f = 0;
+  for (; f + 4 <= frames; f += 4)
+  {
+    const __m128 l = _mm_loadu_ps(src[0] + f);
+    const __m128 r = _mm_loadu_ps(src[1] + f);
+    _mm_storeu_ps(dst + f * 2, _mm_unpacklo_ps(l, r));
+    _mm_storeu_ps(dst + f * 2 + 4, _mm_unpackhi_ps(l, r));
+  }
+  const float* const tail[] = {src[0] + f, src[1] + f};
+  SCALAR::Interleave(dst + f * 2, tail, frames - f, 2);
+}
+
+void Deinterleave(float* const* dst, const float* src, unsigned int frames, unsigned int channels)
+{
+  if (channels != 2)
+  {
+    SCALAR::Deinterleave(dst, src, frames, channels);
+    return;
+  }
+
+  unsigned int f = 0;
+  for (; f + 4 <= frames; f += 4)
+  {
+    const __m128 a = _mm_loadu_ps(src + f * 2);
+    const __m128 b = _mm_loadu_ps(src + f * 2 + 4);
+    _mm_storeu_ps(dst[0] + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(dst[1] + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+  float* const tail[] = {dst[0] + f, dst[1] + f};
+  SCALAR::Deinterleave(tail, src + f * 2, frames - f, 2);
+}
+
+inline __m128i ToS32(__m128 v, __m128 scale, __m128 min, __m128 max)
+{
+  // cvtps2dq rounds to nearest even like lrintf in the default rounding mode
+  return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(v, scale), min), max));
+}
+
+void FloatToS16(int16_t* dst, const float* src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(S16_SCALE);
+  const __m128 min = _mm_set1_ps(-S16_SCALE);
+  const __m128 max = _mm_set1_ps(S16_MAX);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i lo = ToS32(_mm_loadu_ps(src + i), scale, min, max);
+    const __m128i hi = ToS32(_mm_loadu_ps(src + i + 4), scale, min, max);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+  }
+  SCALAR::FloatToS16(dst + i, src + i, count - i);
+}
+
+void FloatToS32(int32_t* dst, const float* src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(S32_SCALE);
+  const __m128 min = _mm_set1_ps(-S32_SCALE);
+  const __m128 max = _mm_set1_ps(S32_MAX);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     ToS32(_mm_loadu_ps(src + i), scale, min, max));
+  SCALAR::FloatToS32(dst + i, src + i, count - i);
+}
+
+void S16ToFloat(float* dst, const int16_t* src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(1.0f / S16_SCALE);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    // sign extend by placing the samples in the upper half and shifting down
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+  SCALAR::S16ToFloat(dst + i, src + i, count - i);
+}
+
+void S32ToFloat(float* dst, const int32_t* src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(1.0f / S32_SCALE);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(dst + i,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(
+                                 reinterpret_cast<const __m128i*>(src + i))),
+                             scale));
+  SCALAR::S32ToFloat(dst + i, src + i, count - i);
+}
+
+void SwapBytes16(uint8_t* dst, const uint8_t* src, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2),
+                     _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+  }
+  SCALAR::SwapBytes16(dst + i * 2, src + i * 2, count - i);
+}
+
+inline __m128i MatchPair(__m128i first, __m128i second, uint8_t a, uint8_t b)
+{
+  return _mm_and_si128(_mm_cmpeq_epi8(first, _mm_set1_epi8(static_cast<char>(a))),
+                       _mm_cmpeq_epi8(second, _mm_set1_epi8(static_cast<char>(b))));
+}
+
+unsigned int FindSync(const uint8_t* data, unsigned int size)
+{
+  // compare 16 pairs at once, the scalar version finds the exact offset in a hit
+  unsigned int i = 0;
+  for (; i + 17 <= size; i += 16)
+  {
+    const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1));
+    __m128i match = MatchPair(first, second, 0x0B, 0x77);
+    match = _mm_or_si128(match, MatchPair(first, second, 0x7F, 0xFE));
+    match = _mm_or_si128(match, MatchPair(first, second, 0xFE, 0x7F));
+    match = _mm_or_si128(match, MatchPair(first, second, 0x1F, 0xFF));
+    match = _mm_or_si128(match, MatchPair(first, second, 0xFF, 0x1F));
+    match = _mm_or_si128(match, MatchPair(first, second, 0xF8, 0x72));
+    if (_mm_movemask_epi8(match))
+      return i + SCALAR::FindSync(data + i, 17);
+  }
+  return i + SCALAR::FindSync(data + i, size - i);
+}
+} // namespace SSE2
+
+const AEKernels kernelsSSE2 = {
+    "SSE2",
+    SSE2::Mul,
+    SSE2::MulAdd,
+    SSE2::MulFrames,
+    SSE2::MulAddFrames,
+    SSE2::PeakFrames,
+    SSE2::MaxAbs,
+    SSE2::Interleave,
+    SSE2::Deinterleave,
+    SSE2::FloatToS16,
+    SSE2::FloatToS32,
+    SSE2::S16ToFloat,
+    SSE2::S32ToFloat,
+    SSE2::SwapBytes16,
+    SSE2::FindSync,
+};
+#endif
+
+#if defined(HAVE_AEKERNELS_AVX2)
+bool HasAVX2()
+{
+#if defined(__GNUC__)
+  // CPUInfo doesn't know about avx2, ask the compiler runtime
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+#endif
+
+#if defined(HAVE_AEKERNELS_NEON)
+bool HasNEON()
+{
+#if defined(__aarch64__)
+  return true;
+#else
+  const auto cpuInfo = CServiceBroker::GetCPUInfo();
+  return cpuInfo && (cpuInfo->GetCPUFeatures() & CPU_FEATURE_NEON) == CPU_FEATURE_NEON;
+#endif
+}
+#endif
+} // namespace
+
+const AEKernels& AEKernels::GetScalar()
+{
+  return kernelsScalar;
+}
+
+std::vector<const AEKernels*> AEKernels::GetAvailable()
+{
+  std::vector<const AEKernels*> available = {&kernelsScalar};
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  available.push_back(&kernelsSSE2);
+
+#if defined(HAVE_AEKERNELS_AVX2)
+  static const AEKernels kernelsAVX2 = [] {
+    AEKernels kernels = kernelsSSE2;
+    kernels.name = "AVX2";
+    AEKernelsSetupAVX2(kernels);
+    return kernels;
+  }();
+  if (HasAVX2())
+    available.push_back(&kernelsAVX2);
+#endif
+#endif
+
+#if defined(HAVE_AEKERNELS_NEON)
+  static const AEKernels kernelsNEON = [] {
+    AEKernels kernels = kernelsScalar;
+    kernels.name = "NEON";
+    AEKernelsSetupNEON(kernels);
+    return kernels;
+  }();
+  if (HasNEON())
+    available.push_back(&kernelsNEON);
+#endif
+
+  return available;
+}
+
+const AEKernels& AEKernels::Get()
+{
+  static const AEKernels* kernels = [] {
+    const AEKernels* best = GetAvailable().back();
+    CLog::Log(LOGDEBUG, "AEKernels: using {} kernels", best->name);
+    return best;
+  }();
+  return *kernels;
+}
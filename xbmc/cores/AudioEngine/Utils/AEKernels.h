@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+/*!
+ * \brief Sample processing kernels used by the engine for mixing, volume and limiting,
+ * and for packing and parsing passthrough bitstreams.
+ *
+ * Every instruction set the build supports provides a table of these, Get() returns the
+ * best one the cpu can run. All sets produce the same output as the scalar one, apart
+ * from float rounding where a compiler fuses the scalar multiply-add.
+ *
+ * Counts are in samples unless named frames. A frame is channels consecutive samples,
+ * planar data is handled by calling the frame kernels per plane with one channel.
+ * Integer conversions saturate and round to nearest even.
+ */
+struct AEKernels
+{
+  const char* name;
+
+  //! data[i] *= mul
+  void (*Mul)(float* data, float mul, unsigned int count);
+  //! dst[i] += src[i] * mul
+  void (*MulAdd)(float* dst, const float* src, float mul, unsigned int count);
+  //! every sample of frame f is multiplied by gain[f]
+  void (*MulFrames)(float* data, const float* gain, unsigned int frames, unsigned int channels);
+  //! dst += src * gain[f] for every sample of frame f
+  void (*MulAddFrames)(
+      float* dst, const float* src, const float* gain, unsigned int frames, unsigned int channels);
+  //! peak[f] = max(peak[f], |sample|) over the samples of frame f
+  void (*PeakFrames)(float* peak, const float* data, unsigned int frames, unsigned int channels);
+  //! largest absolute sample value
+  float (*MaxAbs)(const float* data, unsigned int count);
+
+  void (*Interleave)(float* dst, const float* const* src, unsigned int frames, unsigned int channels);
+  void (*Deinterleave)(float* const* dst, const float* src, unsigned int frames, unsigned int channels);
+
+  void (*FloatToS16)(int16_t* dst, const float* src, unsigned int count);
+  void (*FloatToS32)(int32_t* dst, const float* src, unsigned int count);
+  void (*S16ToFloat)(float* dst, const int16_t* src, unsigned int count);
+  void (*S32ToFloat)(float* dst, const int32_t* src, unsigned int count);
+
+  //! swap the bytes of count 16 bit words, dst may equal src
+  void (*SwapBytes16)(uint8_t* dst, const uint8_t* src, unsigned int count);
+  /*!
+   * \brief Offset of the first byte pair that starts an AC3/E-AC3, DTS or TrueHD sync word.
+   *
+   * These are 0B77, 7FFE, FE7F, 1FFF, FF1F and the F872 of the TrueHD major sync, which
+   * sits 4 bytes into the unit. Returns size - 1 if there is none, the last byte could
+   * start one that continues past the end.
+   */
+  unsigned int (*FindSync)(const uint8_t* data, unsigned int size);
+
+  /*!
+   * \brief The fastest set the running cpu supports, chosen on first use.
+   */
+  static const AEKernels& Get();
+
+  /*!
+   * \brief The scalar reference set.
+   */
+  static const AEKernels& GetScalar();
+
+  /*!
+   * \brief All sets the running cpu supports, scalar first.
+   */
+  static std::vector<const AEKernels*> GetAvailable();
+};
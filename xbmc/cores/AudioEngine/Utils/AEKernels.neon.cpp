@@ -0,0 +1,352 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#include <arm_neon.h>
+
+// On 32 bit arm this file is built with -mfpu=neon and only called after a cpu check.
+// It must not instantiate inline functions or templates of other headers, the linker
+// could pick this copy for callers that run on any cpu.
+
+namespace
+{
+constexpr float S16_SCALE = 32768.0f;
+constexpr float S16_MAX = 32767.0f;
+constexpr float S32_SCALE = 2147483648.0f;
+constexpr float S32_MAX = 2147483520.0f;
+
+inline float Abs(float v)
+{
+  return v < 0.0f ? -v : v;
+}
+
+inline float HorizontalMax(float32x4_t v)
+{
+#if defined(__aarch64__)
+  return vmaxvq_f32(v);
+#else
+  float32x2_t max = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+  max = vpmax_f32(max, max);
+  return vget_lane_f32(max, 0);
+#endif
+}
+
+void Mul(float* data, float mul, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), mul));
+  for (; i < count; i++)
+    data[i] *= mul;
+}
+
+void MulAdd(float* dst, const float* src, float mul, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), mul));
+  for (; i < count; i++)
+    dst[i] += src[i] * mul;
+}
+
+void MulFrames(float* data, const float* gain, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 4 <= frames; f += 4)
+      vst1q_f32(data + f, vmulq_f32(vld1q_f32(data + f), vld1q_f32(gain + f)));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const float32x4_t g = vld1q_f32(gain + f);
+      float32x4x2_t v = vld2q_f32(data + f * 2);
+      v.val[0] = vmulq_f32(v.val[0], g);
+      v.val[1] = vmulq_f32(v.val[1], g);
+      vst2q_f32(data + f * 2, v);
+    }
+  }
+  else
+  {
+    for (; f < frames; f++)
+      Mul(data + f * channels, gain[f], channels);
+  }
+
+  for (; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      data[f * channels + c] *= gain[f];
+}
+
+void MulAddFrames(
+    float* dst, const float* src, const float* gain, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 4 <= frames; f += 4)
+      vst1q_f32(dst + f, vmlaq_f32(vld1q_f32(dst + f), vld1q_f32(src + f), vld1q_f32(gain + f)));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const float32x4_t g = vld1q_f32(gain + f);
+      const float32x4x2_t s = vld2q_f32(src + f * 2);
+      float32x4x2_t d = vld2q_f32(dst + f * 2);
+      d.val[0] = vmlaq_f32(d.val[0], s.val[0], g);
+      d.val[1] = vmlaq_f32(d.val[1], s.val[1], g);
+      vst2q_f32(dst + f * 2, d);
+    }
+  }
+  else
+  {
+    for (; f < frames; f++)
+      MulAdd(dst + f * channels, src + f * channels, gain[f], channels);
+  }
+
+  for (; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      dst[f * channels + c] += src[f * channels + c] * gain[f];
+}
+
+void PeakFrames(float* peak, const float* data, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 1)
+  {
+    for (; f + 4 <= frames; f += 4)
+      vst1q_f32(peak + f, vmaxq_f32(vld1q_f32(peak + f), vabsq_f32(vld1q_f32(data + f))));
+  }
+  else if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const float32x4x2_t v = vld2q_f32(data + f * 2);
+      const float32x4_t max = vmaxq_f32(vabsq_f32(v.val[0]), vabsq_f32(v.val[1]));
+      vst1q_f32(peak + f, vmaxq_f32(vld1q_f32(peak + f), max));
+    }
+  }
+
+  for (; f < frames; f++)
+  {
+    for (unsigned int c = 0; c < channels; c++)
+    {
+      const float sample = Abs(data[f * channels + c]);
+      if (sample > peak[f])
+        peak[f] = sample;
+    }
+  }
+}
+
+float MaxAbs(const float* data, unsigned int count)
+{
+  float32x4_t peak = vdupq_n_f32(0.0f);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(data + i)));
+
+  float result = HorizontalMax(peak);
+  for (; i < count; i++)
+  {
+    const float sample = Abs(data[i]);
+    if (sample > result)
+      result = sample;
+  }
+  return result;
+}
+
+void Interleave(float* dst, const float* const* src, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      float32x4x2_t v;
+      v.val[0] = vld1q_f32(src[0] + f);
+      v.val[1] = vld1q_f32(src[1] + f);
+      vst2q_f32(dst + f * 2, v);
+    }
+  }
+
+  for (; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      dst[f * channels + c] = src[c][f];
+}
+
+void Deinterleave(float* const* dst, const float* src, unsigned int frames, unsigned int channels)
+{
+  unsigned int f = 0;
+  if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4)
+    {
+      const float32x4x2_t v = vld2q_f32(src + f * 2);
+      vst1q_f32(dst[0] + f, v.val[0]);
+      vst1q_f32(dst[1] + f, v.val[1]);
+    }
+  }
+
+  for (; f < frames; f++)
+    for (unsigned int c = 0; c < channels; c++)
+      dst[c][f] = src[f * channels + c];
+}
+
+void S16ToFloat(float* dst, const int16_t* src, unsigned int count)
+{
+  const float scale = 1.0f / S16_SCALE;
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t v = vld1q_s16(src + i);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+  }
+  for (; i < count; i++)
+    dst[i] = static_cast<float>(src[i]) * scale;
+}
+
+void S32ToFloat(float* dst, const int32_t* src, unsigned int count)
+{
+  const float scale = 1.0f / S32_SCALE;
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src + i)), scale));
+  for (; i < count; i++)
+    dst[i] = static_cast<float>(src[i]) * scale;
+}
+
+void SwapBytes16(uint8_t* dst, const uint8_t* src, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    vst1q_u8(dst + i * 2, vrev16q_u8(vld1q_u8(src + i * 2)));
+  for (; i < count; i++)
+  {
+    const uint8_t first = src[i * 2];
+    dst[i * 2] = src[i * 2 + 1];
+    dst[i * 2 + 1] = first;
+  }
+}
+
+inline uint8x16_t MatchPair(uint8x16_t first, uint8x16_t second, uint8_t a, uint8_t b)
+{
+  return vandq_u8(vceqq_u8(first, vdupq_n_u8(a)), vceqq_u8(second, vdupq_n_u8(b)));
+}
+
+inline bool Any(uint8x16_t v)
+{
+#if defined(__aarch64__)
+  return vmaxvq_u8(v) != 0;
+#else
+  const uint32x2_t max = vreinterpret_u32_u8(vorr_u8(vget_low_u8(v), vget_high_u8(v)));
+  return (vget_lane_u32(max, 0) | vget_lane_u32(max, 1)) != 0;
+#endif
+}
+
+unsigned int FindSyncTail(const uint8_t* data, unsigned int size)
+{
+  for (unsigned int i = 0; i + 1 < size; i++)
+  {
+    switch (data[i] << 8 | data[i + 1])
+    {
+      case 0x0B77:
+      case 0x7FFE:
+      case 0xFE7F:
+      case 0x1FFF:
+      case 0xFF1F:
+      case 0xF872:
+        return i;
+    }
+  }
+  return size ? size - 1 : 0;
+}
+
+unsigned int FindSync(const uint8_t* data, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; i + 17 <= size; i += 16)
+  {
+    const uint8x16_t first = vld1q_u8(data + i);
+    const uint8x16_t second = vld1q_u8(data + i + 1);
+    uint8x16_t match = MatchPair(first, second, 0x0B, 0x77);
+    match = vorrq_u8(match, MatchPair(first, second, 0x7F, 0xFE));
+    match = vorrq_u8(match, MatchPair(first, second, 0xFE, 0x7F));
+    match = vorrq_u8(match, MatchPair(first, second, 0x1F, 0xFF));
+    match = vorrq_u8(match, MatchPair(first, second, 0xFF, 0x1F));
+    match = vorrq_u8(match, MatchPair(first, second, 0xF8, 0x72));
+    if (Any(match))
+      return i + FindSyncTail(data + i, 17);
+  }
+  return i + FindSyncTail(data + i, size - i);
+}
+
+#if defined(__aarch64__)
+// armv7 neon only converts to integer by truncation, there the scalar versions are kept
+inline int32_t Round(float v, float min, float max)
+{
+  v = v < min ? min : v;
+  v = v > max ? max : v;
+  return vgetq_lane_s32(vcvtnq_s32_f32(vdupq_n_f32(v)), 0);
+}
+
+inline int32x4_t ToS32(float32x4_t v, float scale, float32x4_t min, float32x4_t max)
+{
+  return vcvtnq_s32_f32(vminq_f32(vmaxq_f32(vmulq_n_f32(v, scale), min), max));
+}
+
+void FloatToS16(int16_t* dst, const float* src, unsigned int count)
+{
+  const float32x4_t min = vdupq_n_f32(-S16_SCALE);
+  const float32x4_t max = vdupq_n_f32(S16_MAX);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x4_t lo = vqmovn_s32(ToS32(vld1q_f32(src + i), S16_SCALE, min, max));
+    const int16x4_t hi = vqmovn_s32(ToS32(vld1q_f32(src + i + 4), S16_SCALE, min, max));
+    vst1q_s16(dst + i, vcombine_s16(lo, hi));
+  }
+  for (; i < count; i++)
+    dst[i] = static_cast<int16_t>(Round(src[i] * S16_SCALE, -S16_SCALE, S16_MAX));
+}
+
+void FloatToS32(int32_t* dst, const float* src, unsigned int count)
+{
+  const float32x4_t min = vdupq_n_f32(-S32_SCALE);
+  const float32x4_t max = vdupq_n_f32(S32_MAX);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_s32(dst + i, ToS32(vld1q_f32(src + i), S32_SCALE, min, max));
+  for (; i < count; i++)
+    dst[i] = Round(src[i] * S32_SCALE, -S32_SCALE, S32_MAX);
+}
+#endif
+} // namespace
+
+void AEKernelsSetupNEON(AEKernels& kernels)
+{
+  kernels.Mul = Mul;
+  kernels.MulAdd = MulAdd;
+  kernels.MulFrames = MulFrames;
+  kernels.MulAddFrames = MulAddFrames;
+  kernels.PeakFrames = PeakFrames;
+  kernels.MaxAbs = MaxAbs;
+  kernels.Interleave = Interleave;
+  kernels.Deinterleave = Deinterleave;
+  kernels.S16ToFloat = S16ToFloat;
+  kernels.S32ToFloat = S32ToFloat;
+  kernels.SwapBytes16 = SwapBytes16;
+  kernels.FindSync = FindSync;
+#if defined(__aarch64__)
+  kernels.FloatToS16 = FloatToS16;
+  kernels.FloatToS32 = FloatToS32;
+#endif
+}
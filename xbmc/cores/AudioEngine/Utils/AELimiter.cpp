@@ -8,6 +8,7 @@
 
 #include "AELimiter.h"
 
+#include "AEKernels.h"
 #include "ServiceBroker.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -43,6 +44,30 @@ float CAELimiter::Run(float* frame[AE_CH_MAX], int channels, int offset /*= 0*/,
     }
   }
 
+  return Step(highest);
+}
+
+void CAELimiter::RunFrames(float* frame[AE_CH_MAX], int channels, int frames, bool planar, float* gain)
+{
+  const AEKernels& kernels = AEKernels::Get();
+
+  std::fill_n(gain, frames, 0.0f);
+  if (!planar)
+  {
+    kernels.PeakFrames(gain, frame[0], frames, channels);
+  }
+  else
+  {
+    for (int i = 0; i < channels; i++)
+      kernels.PeakFrames(gain, frame[i], frames, 1);
+  }
+
+  for (int i = 0; i < frames; i++)
+    gain[i] = Step(gain[i]);
+}
+
+float CAELimiter::Step(float highest)
+{
   float sample = highest * m_amplify;
   if (sample * m_attenuation > 1.0f)
   {
@@ -40,4 +40,13 @@ class CAELimiter
     }
 
     float Run(float* frame[AE_CH_MAX], int channels, int offset = 0, bool planar = false);
+
+    /*!
+     * \brief Run the limiter over a block of frames.
+     * \param gain receives the gain of every frame, same as calling Run() per frame
+     */
+    void RunFrames(float* frame[AE_CH_MAX], int channels, int frames, bool planar, float* gain);
+
+  private:
+    float Step(float highest);
 };
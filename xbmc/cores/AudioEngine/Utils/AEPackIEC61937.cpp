@@ -8,16 +8,17 @@
 
 #include "AEPackIEC61937.h"
 
+#include "AEKernels.h"
+
 #include <cassert>
 #include <string.h>
 
 #define IEC61937_PREAMBLE1  0xF872
 #define IEC61937_PREAMBLE2  0x4E1F
 
-inline void SwapEndian(uint16_t *dst, uint16_t *src, unsigned int size)
+inline void SwapEndian(uint8_t* dst, const uint8_t* src, unsigned int size)
 {
-  for (unsigned int i = 0; i < size; ++i, ++dst, ++src)
-    *dst = ((*src & 0xFF00) >> 8) | ((*src & 0x00FF) << 8);
+  AEKernels::Get().SwapBytes16(dst, src, size);
 }
 
 int CAEPackIEC61937::PackAC3(uint8_t *data, unsigned int size, uint8_t *dest)
@@ -40,7 +41,7 @@ int CAEPackIEC61937::PackAC3(uint8_t *data, unsigned int size, uint8_t *dest)
   packet->m_type      = IEC61937_TYPE_AC3 | (bitstream_mode << 8);
 
   size += size & 0x1;
-  SwapEndian((uint16_t*)packet->m_data, (uint16_t*)data, size >> 1);
+  SwapEndian(packet->m_data, data, size >> 1);
 #endif
 
   memset(packet->m_data + size, 0, OUT_FRAMESTOBYTES(AC3_FRAME_SIZE) - IEC61937_DATA_OFFSET - size);
@@ -64,7 +65,7 @@ int CAEPackIEC61937::PackEAC3(uint8_t *data, unsigned int size, uint8_t *dest)
     memcpy(packet->m_data, data, size);
 #else
   size += size & 0x1;
-  SwapEndian((uint16_t*)packet->m_data, (uint16_t*)data, size >> 1);
+  SwapEndian(packet->m_data, data, size >> 1);
 #endif
 
   memset(packet->m_data + size, 0, OUT_FRAMESTOBYTES(EAC3_FRAME_SIZE) - IEC61937_DATA_OFFSET - size);
@@ -105,7 +106,7 @@ int CAEPackIEC61937::PackTrueHD(uint8_t *data, unsigned int size, uint8_t *dest)
     memcpy(packet->m_data, data, size);
 #else
   size += size & 0x1;
-  SwapEndian((uint16_t*)packet->m_data, (uint16_t*)data, size >> 1);
+  SwapEndian(packet->m_data, data, size >> 1);
 #endif
 
   memset(packet->m_data + size, 0, OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE) - IEC61937_DATA_OFFSET - size);
@@ -144,7 +145,7 @@ int CAEPackIEC61937::PackDTSHD(uint8_t *data, unsigned int size, uint8_t *dest,
     memcpy(packet->m_data, data, size);
 #else
   size += size & 0x1;
-  SwapEndian((uint16_t*)packet->m_data, (uint16_t*)data, size >> 1);
+  SwapEndian(packet->m_data, data, size >> 1);
 #endif
 
   unsigned int burstsize = period << 2;
@@ -197,7 +198,7 @@ int CAEPackIEC61937::PackDTS(uint8_t *data, unsigned int size, uint8_t *dest, bo
   if (byteSwapNeeded)
   {
     size += size & 0x1;
-    SwapEndian((uint16_t*)dataTo, (uint16_t*)data, size >> 1);
+    SwapEndian(dataTo, data, size >> 1);
   }
 
   if (size != frameSize)
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AESpectrum.h"
+
+#include <algorithm>
+#include <cmath>
+
+CAESpectrum::CAESpectrum(unsigned int size)
+  : m_size(size),
+    m_left(size),
+    m_right(size),
+    m_leftOut(size / 2 + 1),
+    m_rightOut(size / 2 + 1),
+    m_magnitudes(size)
+{
+  m_cfg = kiss_fftr_alloc(m_size, 0, nullptr, nullptr);
+
+  // log spaced from the first bin above DC, each band at least one bin wide while
+  // there are bins left
+  const unsigned int bins = m_size / 2;
+  m_bandEdges[0] = 1;
+  for (unsigned int band = 1; band <= BANDS; band++)
+  {
+    const unsigned int edge = static_cast<unsigned int>(
+        std::lround(std::pow(static_cast<double>(bins), static_cast<double>(band) / BANDS)));
+    m_bandEdges[band] = std::min(std::max(edge, m_bandEdges[band - 1] + 1), bins);
+  }
+  m_bandEdges[BANDS] = bins;
+  m_bands.fill(0.0f);
+}
+
+CAESpectrum::~CAESpectrum()
+{
+  // see RFFT, kiss_fftr_free ignores SIMD allocations
+  KISS_FFT_FREE(m_cfg);
+}
+
+void CAESpectrum::Calculate(const float* data, unsigned int length)
+{
+  const unsigned int frames = std::min(length / 2, m_size);
+  for (unsigned int i = 0; i < frames; i++)
+  {
+    m_left[i] = data[2 * i];
+    m_right[i] = data[2 * i + 1];
+  }
+  std::fill(m_left.begin() + frames, m_left.end(), 0.0f);
+  std::fill(m_right.begin() + frames, m_right.end(), 0.0f);
+
+  kiss_fftr(m_cfg, m_left.data(), m_leftOut.data());
+  kiss_fftr(m_cfg, m_right.data(), m_rightOut.data());
+
+  const float scale = 2.0f / m_size;
+  const unsigned int bins = m_size / 2;
+  for (unsigned int i = 0; i < bins; i++)
+  {
+    const kiss_fft_cpx& l = m_leftOut[i];
+    const kiss_fft_cpx& r = m_rightOut[i];
+    m_magnitudes[2 * i] = std::sqrt(l.r * l.r + l.i * l.i) * scale;
+    m_magnitudes[2 * i + 1] = std::sqrt(r.r * r.r + r.i * r.i) * scale;
+  }
+
+  for (unsigned int band = 0; band < BANDS; band++)
+  {
+    const unsigned int start = m_bandEdges[band];
+    const unsigned int end = m_bandEdges[band + 1];
+    if (start >= end)
+    {
+      m_bands[band] = 0.0f;
+      continue;
+    }
+
+    // energy of the band, averaged over the channels
+    float power = 0.0f;
+    for (unsigned int i = 2 * start; i < 2 * end; i++)
+      power += m_magnitudes[i] * m_magnitudes[i];
+    power /= 2;
+
+    const float db = 10.0f * std::log10(std::max(power, 1e-12f));
+    m_bands[band] = std::min(std::max((db - FLOOR_DB) / -FLOOR_DB, 0.0f), 1.0f);
+  }
+}
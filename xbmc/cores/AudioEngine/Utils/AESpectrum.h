@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <kissfft/kiss_fftr.h>
+
+/*!
+ * \brief Spectrum of blocks of interleaved stereo audio, computed once by the engine
+ * for all visualizations.
+ *
+ * The magnitudes use the layout and scale of RFFT without a window, so they can be
+ * passed to visualization addons as they are. Work buffers are allocated once and the
+ * channels are transformed from planar copies.
+ */
+class CAESpectrum
+{
+public:
+  static constexpr unsigned int BANDS = 16;
+  //! range of GetBands(), a band at the given level or below reads 0
+  static constexpr float FLOOR_DB = -60.0f;
+
+  /*!
+   * \param size samples per channel of a transform, a power of 2
+   */
+  explicit CAESpectrum(unsigned int size);
+  ~CAESpectrum();
+
+  CAESpectrum(const CAESpectrum&) = delete;
+  CAESpectrum& operator=(const CAESpectrum&) = delete;
+
+  /*!
+   * \brief Analyse the start of a block.
+   * \param data interleaved stereo samples, blocks shorter than a transform are zero padded
+   * \param length number of samples in data, not frames
+   */
+  void Calculate(const float* data, unsigned int length);
+
+  unsigned int GetSize() const { return m_size; }
+
+  /*!
+   * \brief Magnitudes of left and right interleaved, GetSize() values for the lower
+   * GetSize() / 2 bins. A full scale sine on a bin reads 1.
+   */
+  const float* GetMagnitudes() const { return m_magnitudes.data(); }
+
+  /*!
+   * \brief Energy of both channels in log spaced bands from the first bin up, 0 at
+   * FLOOR_DB and 1 at full scale. A full scale sine reads 1 in its band.
+   */
+  const std::array<float, BANDS>& GetBands() const { return m_bands; }
+
+private:
+  unsigned int m_size;
+  kiss_fftr_cfg m_cfg;
+  std::vector<kiss_fft_scalar> m_left;
+  std::vector<kiss_fft_scalar> m_right;
+  std::vector<kiss_fft_cpx> m_leftOut;
+  std::vector<kiss_fft_cpx> m_rightOut;
+  std::vector<float> m_magnitudes;
+  std::array<unsigned int, BANDS + 1> m_bandEdges;
+  std::array<float, BANDS> m_bands;
+};
@@ -8,6 +8,7 @@
 
 #include "AEStreamInfo.h"
 
+#include "AEKernels.h"
 #include "utils/log.h"
 
 #include <algorithm>
@@ -267,9 +268,22 @@ unsigned int CAEStreamParser::DetectType(uint8_t *data, unsigned int size)
 {
   unsigned int skipped  = 0;
   unsigned int possible = 0;
+  const AEKernels& kernels = AEKernels::Get();
 
   while (size > 8)
   {
+    /* jump to the next byte pair that could start a sync word, TrueHD's is 4 bytes in */
+    unsigned int jump = kernels.FindSync(data, size);
+    jump = std::min(jump > 4 ? jump - 4 : 0, size - 8);
+    if (jump)
+    {
+      size -= jump;
+      skipped += jump;
+      data += jump;
+      if (size == 8)
+        break;
+    }
+
     /* if it could be DTS */
     unsigned int header = data[0] << 24 | data[1] << 16 | data[2] << 8 | data[3];
     if (header == DTS_PREAMBLE_14LE ||
@@ -467,9 +481,15 @@ bool CAEStreamParser::TrySyncAC3(uint8_t *data, unsigned int size, bool resyncin
 unsigned int CAEStreamParser::SyncAC3(uint8_t *data, unsigned int size)
 {
   unsigned int skip = 0;
+  const AEKernels& kernels = AEKernels::Get();
 
   for (; size - skip > 7; ++skip, ++data)
   {
+    /* jump to the next possible sync word */
+    unsigned int jump = std::min(kernels.FindSync(data, size - skip), size - skip - 8);
+    skip += jump;
+    data += jump;
+
     bool resyncing = (skip != 0);
     if (TrySyncAC3(data, size - skip, resyncing, /*wantEAC3dependent*/ false))
       return skip;
@@ -491,8 +511,14 @@ unsigned int CAEStreamParser::SyncDTS(uint8_t *data, unsigned int size)
   }
 
   unsigned int skip = 0;
+  const AEKernels& kernels = AEKernels::Get();
   for (; size - skip > 13; ++skip, ++data)
   {
+    /* jump to the next possible sync word */
+    unsigned int jump = std::min(kernels.FindSync(data, size - skip), size - skip - 14);
+    skip += jump;
+    data += jump;
+
     unsigned int header = data[0] << 24 | data[1] << 16 | data[2] << 8 | data[3];
     unsigned int hd_sync = 0;
     unsigned int dtsBlocks;
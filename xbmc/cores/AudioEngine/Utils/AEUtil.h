@@ -160,10 +160,6 @@ public:
     return 20*log10(scale);
   }
 
-  #if defined(HAVE_SSE) && defined(__SSE__)
-  static void SSEMulArray     (float *data, const float mul, uint32_t count);
-  static void SSEMulAddArray  (float *data, float *add, const float mul, uint32_t count);
-  #endif
   static void ClampArray(float *data, uint32_t count);
 
   static bool S16NeedsByteSwap(AEDataFormat in, AEDataFormat out);
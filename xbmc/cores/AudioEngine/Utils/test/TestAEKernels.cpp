@@ -0,0 +1,352 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// odd sizes so every kernel has to handle a tail after its vector loop
+constexpr unsigned int FRAMES = 1027;
+constexpr unsigned int CHANNELS[] = {1, 2, 6};
+
+std::vector<float> MakeSamples(unsigned int count, float range, unsigned int seed)
+{
+  std::vector<float> samples(count);
+  uint32_t state = seed * 2654435761u + 1;
+  for (auto& sample : samples)
+  {
+    state = state * 1664525u + 1013904223u;
+    sample = range * (static_cast<float>(state >> 8) / (1 << 23) - 1.0f);
+  }
+  return samples;
+}
+
+// the scalar multiply-add may be fused by the compiler, the vector one isn't
+void ExpectNear(const std::vector<float>& expected, const std::vector<float>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    ASSERT_NEAR(expected[i], actual[i], 1e-6f * std::max(1.0f, std::fabs(expected[i]))) << i;
+}
+} // namespace
+
+class TestAEKernels : public testing::Test
+{
+protected:
+  const AEKernels& m_scalar = AEKernels::GetScalar();
+  const std::vector<const AEKernels*> m_available = AEKernels::GetAvailable();
+};
+
+TEST_F(TestAEKernels, SelectsAvailableSet)
+{
+  ASSERT_FALSE(m_available.empty());
+  EXPECT_EQ(&m_scalar, m_available.front());
+  EXPECT_EQ(m_available.back()->name, AEKernels::Get().name);
+}
+
+TEST_F(TestAEKernels, Mul)
+{
+  const std::vector<float> input = MakeSamples(FRAMES, 1.5f, 1);
+  std::vector<float> expected = input;
+  m_scalar.Mul(expected.data(), 0.7f, FRAMES);
+
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    std::vector<float> actual = input;
+    kernels->Mul(actual.data(), 0.7f, FRAMES);
+    EXPECT_EQ(expected, actual);
+
+    // unaligned start
+    std::vector<float> offset = input;
+    kernels->Mul(offset.data() + 1, 0.7f, FRAMES - 1);
+    EXPECT_EQ(input[0], offset[0]);
+    EXPECT_EQ(std::vector<float>(expected.begin() + 1, expected.end()),
+              std::vector<float>(offset.begin() + 1, offset.end()));
+  }
+}
+
+TEST_F(TestAEKernels, MulAdd)
+{
+  const std::vector<float> dst = MakeSamples(FRAMES, 1.0f, 2);
+  const std::vector<float> src = MakeSamples(FRAMES, 1.0f, 3);
+  std::vector<float> expected = dst;
+  m_scalar.MulAdd(expected.data(), src.data(), 0.3f, FRAMES);
+
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    std::vector<float> actual = dst;
+    kernels->MulAdd(actual.data(), src.data(), 0.3f, FRAMES);
+    ExpectNear(expected, actual);
+  }
+}
+
+TEST_F(TestAEKernels, MulFrames)
+{
+  const std::vector<float> gain = MakeSamples(FRAMES, 1.0f, 4);
+  for (unsigned int channels : CHANNELS)
+  {
+    const std::vector<float> input = MakeSamples(FRAMES * channels, 1.0f, 5);
+    std::vector<float> expected = input;
+    m_scalar.MulFrames(expected.data(), gain.data(), FRAMES, channels);
+
+    for (const AEKernels* kernels : m_available)
+    {
+      SCOPED_TRACE(std::string(kernels->name) + " " + std::to_string(channels));
+      std::vector<float> actual = input;
+      kernels->MulFrames(actual.data(), gain.data(), FRAMES, channels);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST_F(TestAEKernels, MulAddFrames)
+{
+  const std::vector<float> gain = MakeSamples(FRAMES, 1.0f, 6);
+  for (unsigned int channels : CHANNELS)
+  {
+    const std::vector<float> dst = MakeSamples(FRAMES * channels, 1.0f, 7);
+    const std::vector<float> src = MakeSamples(FRAMES * channels, 1.0f, 8);
+    std::vector<float> expected = dst;
+    m_scalar.MulAddFrames(expected.data(), src.data(), gain.data(), FRAMES, channels);
+
+    for (const AEKernels* kernels : m_available)
+    {
+      SCOPED_TRACE(std::string(kernels->name) + " " + std::to_string(channels));
+      std::vector<float> actual = dst;
+      kernels->MulAddFrames(actual.data(), src.data(), gain.data(), FRAMES, channels);
+      ExpectNear(expected, actual);
+    }
+  }
+}
+
+TEST_F(TestAEKernels, PeakFrames)
+{
+  const std::vector<float> initial = MakeSamples(FRAMES, 0.5f, 9);
+  for (unsigned int channels : CHANNELS)
+  {
+    const std::vector<float> input = MakeSamples(FRAMES * channels, 1.5f, 10);
+    std::vector<float> expected(initial.size());
+    for (size_t i = 0; i < expected.size(); i++)
+      expected[i] = std::fabs(initial[i]);
+    const std::vector<float> start = expected;
+    m_scalar.PeakFrames(expected.data(), input.data(), FRAMES, channels);
+
+    for (const AEKernels* kernels : m_available)
+    {
+      SCOPED_TRACE(std::string(kernels->name) + " " + std::to_string(channels));
+      std::vector<float> actual = start;
+      kernels->PeakFrames(actual.data(), input.data(), FRAMES, channels);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST_F(TestAEKernels, MaxAbs)
+{
+  std::vector<float> input = MakeSamples(FRAMES, 1.0f, 11);
+  input[FRAMES - 1] = -1.25f; // in the tail
+  input[17] = 1.125f;
+
+  EXPECT_EQ(1.25f, m_scalar.MaxAbs(input.data(), FRAMES));
+  EXPECT_EQ(0.0f, m_scalar.MaxAbs(input.data(), 0));
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    EXPECT_EQ(1.25f, kernels->MaxAbs(input.data(), FRAMES));
+    EXPECT_EQ(1.125f, kernels->MaxAbs(input.data(), FRAMES - 1));
+    EXPECT_EQ(0.0f, kernels->MaxAbs(input.data(), 0));
+  }
+}
+
+TEST_F(TestAEKernels, InterleaveRoundTrip)
+{
+  for (unsigned int channels : CHANNELS)
+  {
+    std::vector<std::vector<float>> planes;
+    std::vector<const float*> src;
+    for (unsigned int c = 0; c < channels; c++)
+    {
+      planes.push_back(MakeSamples(FRAMES, 1.0f, 12 + c));
+      src.push_back(planes.back().data());
+    }
+    std::vector<float> expected(FRAMES * channels);
+    m_scalar.Interleave(expected.data(), src.data(), FRAMES, channels);
+    EXPECT_EQ(planes[channels - 1][5], expected[5 * channels + channels - 1]);
+
+    for (const AEKernels* kernels : m_available)
+    {
+      SCOPED_TRACE(std::string(kernels->name) + " " + std::to_string(channels));
+      std::vector<float> interleaved(FRAMES * channels);
+      kernels->Interleave(interleaved.data(), src.data(), FRAMES, channels);
+      EXPECT_EQ(expected, interleaved);
+
+      std::vector<std::vector<float>> result(channels, std::vector<float>(FRAMES));
+      std::vector<float*> dst;
+      for (auto& plane : result)
+        dst.push_back(plane.data());
+      kernels->Deinterleave(dst.data(), interleaved.data(), FRAMES, channels);
+      EXPECT_EQ(planes, result);
+    }
+  }
+}
+
+TEST_F(TestAEKernels, FloatToS16)
+{
+  std::vector<float> input = MakeSamples(FRAMES, 1.2f, 20);
+  const float edges[] = {0.0f, 1.0f, -1.0f, 2.0f, -2.0f, 0.5f / 32768, 1.5f / 32768, -0.5f / 32768,
+                         32767.5f / 32768};
+  std::copy(std::begin(edges), std::end(edges), input.begin());
+  std::copy(std::begin(edges), std::end(edges), input.end() - std::size(edges));
+
+  std::vector<int16_t> expected(FRAMES);
+  m_scalar.FloatToS16(expected.data(), input.data(), FRAMES);
+  EXPECT_EQ(0, expected[0]);
+  EXPECT_EQ(32767, expected[1]);
+  EXPECT_EQ(-32768, expected[2]);
+  EXPECT_EQ(32767, expected[3]);
+  EXPECT_EQ(-32768, expected[4]);
+  EXPECT_EQ(0, expected[5]); // ties round to even
+  EXPECT_EQ(2, expected[6]);
+
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    std::vector<int16_t> actual(FRAMES);
+    kernels->FloatToS16(actual.data(), input.data(), FRAMES);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST_F(TestAEKernels, FloatToS32)
+{
+  std::vector<float> input = MakeSamples(FRAMES, 1.2f, 21);
+  const float edges[] = {0.0f, 1.0f, -1.0f, 2.0f, -2.0f, 0.99999994f};
+  std::copy(std::begin(edges), std::end(edges), input.begin());
+  std::copy(std::begin(edges), std::end(edges), input.end() - std::size(edges));
+
+  std::vector<int32_t> expected(FRAMES);
+  m_scalar.FloatToS32(expected.data(), input.data(), FRAMES);
+  EXPECT_EQ(0, expected[0]);
+  EXPECT_EQ(2147483520, expected[1]);
+  EXPECT_EQ(INT32_MIN, expected[2]);
+  EXPECT_EQ(2147483520, expected[3]);
+  EXPECT_EQ(INT32_MIN, expected[4]);
+
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    std::vector<int32_t> actual(FRAMES);
+    kernels->FloatToS32(actual.data(), input.data(), FRAMES);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST_F(TestAEKernels, IntToFloat)
+{
+  std::vector<int16_t> s16(FRAMES);
+  std::vector<int32_t> s32(FRAMES);
+  for (unsigned int i = 0; i < FRAMES; i++)
+  {
+    s16[i] = static_cast<int16_t>(i * 7919);
+    s32[i] = static_cast<int32_t>(i * 2654435761u);
+  }
+  s16[0] = INT16_MIN;
+  s16[1] = INT16_MAX;
+  s32[0] = INT32_MIN;
+  s32[1] = INT32_MAX;
+
+  std::vector<float> expected16(FRAMES);
+  std::vector<float> expected32(FRAMES);
+  m_scalar.S16ToFloat(expected16.data(), s16.data(), FRAMES);
+  m_scalar.S32ToFloat(expected32.data(), s32.data(), FRAMES);
+  EXPECT_EQ(-1.0f, expected16[0]);
+  EXPECT_EQ(-1.0f, expected32[0]);
+
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    std::vector<float> actual(FRAMES);
+    kernels->S16ToFloat(actual.data(), s16.data(), FRAMES);
+    EXPECT_EQ(expected16, actual);
+    kernels->S32ToFloat(actual.data(), s32.data(), FRAMES);
+    EXPECT_EQ(expected32, actual);
+
+    // converting back is lossless for s16
+    std::vector<int16_t> back(FRAMES);
+    kernels->FloatToS16(back.data(), expected16.data(), FRAMES);
+    EXPECT_EQ(s16, back);
+  }
+}
+
+TEST_F(TestAEKernels, SwapBytes16)
+{
+  std::vector<uint8_t> input(FRAMES * 2);
+  for (size_t i = 0; i < input.size(); i++)
+    input[i] = static_cast<uint8_t>(i * 7);
+
+  std::vector<uint8_t> expected(input.size());
+  m_scalar.SwapBytes16(expected.data(), input.data(), FRAMES);
+  EXPECT_EQ(input[1], expected[0]);
+  EXPECT_EQ(input[0], expected[1]);
+
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    std::vector<uint8_t> actual(input.size());
+    kernels->SwapBytes16(actual.data(), input.data(), FRAMES);
+    EXPECT_EQ(expected, actual);
+
+    // in place
+    actual = input;
+    kernels->SwapBytes16(actual.data(), actual.data(), FRAMES);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST_F(TestAEKernels, FindSync)
+{
+  const std::vector<std::pair<uint8_t, uint8_t>> syncs = {
+      {0x0B, 0x77}, {0x7F, 0xFE}, {0xFE, 0x7F}, {0x1F, 0xFF}, {0xFF, 0x1F}, {0xF8, 0x72}};
+
+  // halves of sync words that must not match on their own
+  std::vector<uint8_t> noise(FRAMES);
+  for (size_t i = 0; i < noise.size(); i++)
+    noise[i] = (i % 3) ? 0x0B : 0x72;
+  EXPECT_EQ(FRAMES - 1, m_scalar.FindSync(noise.data(), FRAMES));
+
+  for (const AEKernels* kernels : m_available)
+  {
+    SCOPED_TRACE(kernels->name);
+    EXPECT_EQ(FRAMES - 1, kernels->FindSync(noise.data(), FRAMES));
+    EXPECT_EQ(0u, kernels->FindSync(noise.data(), 0));
+
+    for (const auto& sync : syncs)
+    {
+      // every position, including across the vector blocks and the last pair
+      for (unsigned int pos : {0u, 1u, 15u, 16u, 17u, 31u, 500u, FRAMES - 17, FRAMES - 2})
+      {
+        std::vector<uint8_t> data = noise;
+        data[pos] = sync.first;
+        data[pos + 1] = sync.second;
+        EXPECT_EQ(pos, kernels->FindSync(data.data(), FRAMES)) << pos;
+        EXPECT_EQ(pos, m_scalar.FindSync(data.data(), FRAMES)) << pos;
+      }
+    }
+  }
+}
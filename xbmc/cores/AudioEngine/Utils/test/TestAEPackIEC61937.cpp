@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEPackIEC61937.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// the packets are written in host order, these are the little endian ones
+#ifndef __BIG_ENDIAN__
+
+namespace
+{
+std::vector<uint8_t> MakeFrame(unsigned int size)
+{
+  std::vector<uint8_t> frame(size);
+  for (unsigned int i = 0; i < size; i++)
+    frame[i] = static_cast<uint8_t>(i * 13 + 1);
+  return frame;
+}
+
+void ExpectSwapped(const std::vector<uint8_t>& frame, const uint8_t* payload)
+{
+  for (size_t i = 0; i + 1 < frame.size(); i += 2)
+  {
+    ASSERT_EQ(frame[i + 1], payload[i]) << i;
+    ASSERT_EQ(frame[i], payload[i + 1]) << i;
+  }
+}
+
+void ExpectZero(const uint8_t* data, size_t size)
+{
+  for (size_t i = 0; i < size; i++)
+    ASSERT_EQ(0, data[i]) << i;
+}
+} // namespace
+
+TEST(TestAEPackIEC61937, AC3)
+{
+  // odd sized, the packer reads one byte of padding past the frame
+  std::vector<uint8_t> frame = {0x0B, 0x77, 0x01, 0x02, 0x03, 0x45, 0x06, 0x07, 0x08, 0x00};
+  std::vector<uint8_t> packet(OUT_FRAMESTOBYTES(AC3_FRAME_SIZE), 0xAA);
+
+  ASSERT_EQ(OUT_FRAMESTOBYTES(AC3_FRAME_SIZE),
+            CAEPackIEC61937::PackAC3(frame.data(), 9, packet.data()));
+
+  const std::vector<uint8_t> golden = {0x72, 0xF8, 0x1F, 0x4E, 0x01, 0x05, 0x48, 0x00,
+                                       0x77, 0x0B, 0x02, 0x01, 0x45, 0x03, 0x07, 0x06,
+                                       0x00, 0x08};
+  EXPECT_EQ(golden, std::vector<uint8_t>(packet.begin(), packet.begin() + golden.size()));
+  ExpectZero(packet.data() + golden.size(), packet.size() - golden.size());
+}
+
+TEST(TestAEPackIEC61937, DTS)
+{
+  const std::vector<uint8_t> frame = MakeFrame(1000);
+  std::vector<uint8_t> packet(OUT_FRAMESTOBYTES(DTS1_FRAME_SIZE), 0xAA);
+
+  // big endian input is swapped
+  ASSERT_EQ(OUT_FRAMESTOBYTES(DTS1_FRAME_SIZE),
+            CAEPackIEC61937::PackDTS_512(const_cast<uint8_t*>(frame.data()), frame.size(),
+                                         packet.data(), false));
+  const std::vector<uint8_t> header = {0x72, 0xF8, 0x1F, 0x4E, 0x0B, 0x00, 0x40, 0x1F};
+  EXPECT_EQ(header, std::vector<uint8_t>(packet.begin(), packet.begin() + 8));
+  ExpectSwapped(frame, packet.data() + 8);
+  ExpectZero(packet.data() + 8 + frame.size(), packet.size() - 8 - frame.size());
+
+  // little endian input is copied
+  ASSERT_EQ(OUT_FRAMESTOBYTES(DTS1_FRAME_SIZE),
+            CAEPackIEC61937::PackDTS_512(const_cast<uint8_t*>(frame.data()), frame.size(),
+                                         packet.data(), true));
+  EXPECT_EQ(frame, std::vector<uint8_t>(packet.begin() + 8, packet.begin() + 8 + frame.size()));
+}
+
+TEST(TestAEPackIEC61937, TrueHDInPlace)
+{
+  // large enough for every vector width, with an odd tail
+  const std::vector<uint8_t> frame = MakeFrame(61000 - 7);
+  std::vector<uint8_t> packet(OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE), 0);
+  std::copy(frame.begin(), frame.end(), packet.begin() + 8);
+
+  ASSERT_EQ(OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE),
+            CAEPackIEC61937::PackTrueHD(nullptr, frame.size(), packet.data()));
+
+  const std::vector<uint8_t> header = {0x72, 0xF8, 0x1F, 0x4E, 0x16, 0x00, 0x41, 0xEE};
+  EXPECT_EQ(header, std::vector<uint8_t>(packet.begin(), packet.begin() + 8));
+  ExpectSwapped(frame, packet.data() + 8);
+  // the odd last byte is swapped with the padding
+  EXPECT_EQ(0, packet[8 + frame.size() - 1]);
+  EXPECT_EQ(frame.back(), packet[8 + frame.size()]);
+}
+
+#endif
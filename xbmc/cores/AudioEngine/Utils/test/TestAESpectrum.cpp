@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AESpectrum.h"
+#include "utils/rfft.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr unsigned int SIZE = 256;
+
+std::vector<float> Sine(unsigned int bin, float left, float right)
+{
+  std::vector<float> data(2 * SIZE);
+  for (unsigned int i = 0; i < SIZE; i++)
+  {
+    const float value = std::sin(2.0f * static_cast<float>(M_PI) * bin * i / SIZE);
+    data[2 * i] = left * value;
+    data[2 * i + 1] = right * value;
+  }
+  return data;
+}
+} // namespace
+
+TEST(TestAESpectrum, SameAsRFFT)
+{
+  std::vector<float> data = Sine(10, 0.5f, 0.25f);
+  for (unsigned int i = 0; i < data.size(); i++)
+    data[i] += 0.1f * std::cos(0.37f * i);
+
+  RFFT rfft(SIZE, false);
+  std::vector<float> expected(SIZE);
+  rfft.calc(data.data(), expected.data());
+
+  CAESpectrum spectrum(SIZE);
+  spectrum.Calculate(data.data(), data.size());
+  for (unsigned int i = 0; i < SIZE; i++)
+    EXPECT_NEAR(expected[i], spectrum.GetMagnitudes()[i], 1e-5f) << i;
+
+  EXPECT_NEAR(0.5f, spectrum.GetMagnitudes()[20], 1e-3f);
+  EXPECT_NEAR(0.25f, spectrum.GetMagnitudes()[21], 1e-3f);
+}
+
+TEST(TestAESpectrum, Bands)
+{
+  CAESpectrum spectrum(SIZE);
+  for (unsigned int bin : {1u, 5u, 40u, 127u})
+  {
+    const std::vector<float> data = Sine(bin, 1.0f, 1.0f);
+    spectrum.Calculate(data.data(), data.size());
+
+    unsigned int loudest = 0;
+    for (unsigned int band = 0; band < CAESpectrum::BANDS; band++)
+    {
+      if (spectrum.GetBands()[band] > spectrum.GetBands()[loudest])
+        loudest = band;
+    }
+    EXPECT_NEAR(1.0f, spectrum.GetBands()[loudest], 1e-3f) << bin;
+    for (unsigned int band = 0; band < CAESpectrum::BANDS; band++)
+    {
+      if (band != loudest)
+      {
+        EXPECT_EQ(0.0f, spectrum.GetBands()[band]) << bin << " " << band;
+      }
+    }
+    // the first and last bins land in the outer bands
+    if (bin == 1)
+    {
+      EXPECT_EQ(0u, loudest);
+    }
+    else if (bin == 127)
+    {
+      EXPECT_EQ(CAESpectrum::BANDS - 1, loudest);
+    }
+  }
+}
+
+TEST(TestAESpectrum, ShortBlock)
+{
+  // a block shorter than a transform is padded, silence reads 0 everywhere
+  const std::vector<float> data(20, 0.0f);
+  CAESpectrum spectrum(SIZE);
+  spectrum.Calculate(data.data(), data.size());
+  for (unsigned int i = 0; i < SIZE; i++)
+    EXPECT_EQ(0.0f, spectrum.GetMagnitudes()[i]);
+  for (float band : spectrum.GetBands())
+    EXPECT_EQ(0.0f, band);
+}
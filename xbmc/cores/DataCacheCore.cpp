@@ -339,6 +339,8 @@ void CDataCacheCore::SetSpeed(float tempo, float speed)
 {
   CSingleLock lock(m_stateSection);
 
+  if (m_stateInfo.m_tempo != tempo || m_stateInfo.m_speed != speed)
+    m_playerStateChanged = true;
   m_stateInfo.m_tempo = tempo;
   m_stateInfo.m_speed = speed;
 }
@@ -92,6 +92,13 @@ public:
   virtual bool OpenFile(const CFileItem& file, const CPlayerOptions& options){ return false;}
   virtual bool QueueNextFile(const CFileItem &file) { return false; }
   virtual void OnNothingToQueueNotify() {}
+
+  /*!
+   \brief Hint that file is likely to be opened next, e.g. the next playlist item or stack part.
+   Unlike QueueNextFile() the player doesn't take over the transition, it may only prepare
+   the file in the background so the following OpenFile() is quicker.
+   */
+  virtual void PrefetchNextFile(const CFileItem& file) {}
   virtual bool CloseFile(bool reopen = false) = 0;
   virtual bool IsPlaying() const { return false;}
   virtual bool CanPause() { return true; }
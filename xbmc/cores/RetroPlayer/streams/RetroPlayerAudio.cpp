@@ -12,6 +12,7 @@
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/AEStream.h"
 #include "cores/AudioEngine/Utils/AEChannelInfo.h"
+#include "cores/AudioEngine/Utils/AEStreamData.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/RetroPlayer/audio/AudioTranslator.h"
 #include "cores/RetroPlayer/process/RPProcessInfo.h"
@@ -90,7 +91,8 @@ bool CRetroPlayerAudio::OpenStream(const StreamProperties& properties)
   audioFormat.m_dataFormat = pcmFormat;
   audioFormat.m_sampleRate = iSampleRate;
   audioFormat.m_channelLayout = channelLayout;
-  m_pAudioStream = audioEngine->MakeStream(audioFormat);
+  // games react to input, their sound must not lag behind
+  m_pAudioStream = audioEngine->MakeStream(audioFormat, AESTREAM_LOW_LATENCY);
 
   if (m_pAudioStream == nullptr)
   {
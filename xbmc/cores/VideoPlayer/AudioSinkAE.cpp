@@ -156,6 +156,19 @@ unsigned int CAudioSinkAE::AddPackets(const DVDAudioFrame &audioframe)
   return total - frames;
 }
 
+bool CAudioSinkAE::CanAddPackets(const DVDAudioFrame &audioframe)
+{
+  CSingleLock lock (m_critSection);
+  if (!m_pAudioStream)
+    return true;
+
+  unsigned int space = m_pAudioStream->GetSpace();
+  if (audioframe.passthrough)
+    return space > 0;
+
+  return space >= (audioframe.nb_frames - audioframe.framesOut) * audioframe.framesize;
+}
+
 void CAudioSinkAE::Drain()
 {
   CSingleLock lock (m_critSection);
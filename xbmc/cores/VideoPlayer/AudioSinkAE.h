@@ -40,6 +40,10 @@ public:
   bool IsValidFormat(const DVDAudioFrame &audioframe);
   void Destroy(bool finish);
   unsigned int AddPackets(const DVDAudioFrame &audioframe);
+  /*!
+   * \brief Returns true if AddPackets takes the rest of the frame without waiting
+   */
+  bool CanAddPackets(const DVDAudioFrame &audioframe);
   double GetPlayingPts();
   double GetCacheTime();
   double GetCacheTotal(); // returns total time a stream can buffer
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FrameBufferPool.h"
+
+#include "threads/SingleLock.h"
+#include "utils/MemUtils.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace
+{
+// matches the alignment and padding of FFmpeg's own frame pool
+constexpr size_t BUFFER_ALIGN = 64;
+constexpr size_t BUFFER_PADDING = 16 + BUFFER_ALIGN - 1;
+
+// a size nobody asked for during this many requests belongs to a previous stream
+// configuration, a few seconds of playback at three planes per frame
+constexpr uint64_t STALE_REQUESTS = 512;
+constexpr uint64_t STALE_CHECK_INTERVAL = 64;
+} // namespace
+
+CFrameBufferPool::~CFrameBufferPool()
+{
+  Clear();
+}
+
+bool CFrameBufferPool::IsSupported(const AVCodecContext* avctx, AVPixelFormat format)
+{
+  if (!avctx->codec || !(avctx->codec->capabilities & AV_CODEC_CAP_DR1))
+    return false;
+
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  return desc && !(desc->flags & (AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_PAL |
+                                  AV_PIX_FMT_FLAG_BITSTREAM));
+}
+
+int CFrameBufferPool::GetFrameBuffers(AVCodecContext* avctx, AVFrame* frame)
+{
+  const AVPixelFormat format = static_cast<AVPixelFormat>(frame->format);
+  if (!IsSupported(avctx, format) || frame->width <= 0 || frame->height <= 0)
+    return AVERROR(EINVAL);
+
+  int width = frame->width;
+  int height = frame->height;
+  int strideAlign[AV_NUM_DATA_POINTERS];
+  avcodec_align_dimensions2(avctx, &width, &height, strideAlign);
+
+  // widen until every plane's line size meets the codec's alignment, like FFmpeg does
+  int linesize[4];
+  bool unaligned;
+  do
+  {
+    int ret = av_image_fill_linesizes(linesize, format, width);
+    if (ret < 0)
+      return ret;
+    width += width & ~(width - 1);
+    unaligned = false;
+    for (int i = 0; i < 4; i++)
+      unaligned |= strideAlign[i] && linesize[i] % strideAlign[i] != 0;
+  } while (unaligned);
+
+  ptrdiff_t linesizes[4];
+  for (int i = 0; i < 4; i++)
+    linesizes[i] = linesize[i];
+
+  size_t sizes[4];
+  int ret = av_image_fill_plane_sizes(sizes, format, height, linesizes);
+  if (ret < 0)
+    return ret;
+
+  for (int i = 0; i < 4 && sizes[i] > 0; i++)
+  {
+    frame->buf[i] = Get(sizes[i] + BUFFER_PADDING);
+    if (!frame->buf[i])
+    {
+      av_frame_unref(frame);
+      return AVERROR(ENOMEM);
+    }
+    frame->data[i] = frame->buf[i]->data;
+    frame->linesize[i] = linesize[i];
+  }
+  frame->extended_data = frame->data;
+
+  return 0;
+}
+
+AVBufferRef* CFrameBufferPool::Get(size_t size)
+{
+  Buffer* buffer = nullptr;
+  {
+    CSingleLock lock(m_section);
+
+    m_requests++;
+    if (m_requests % STALE_CHECK_INTERVAL == 0)
+      ReleaseStale();
+
+    SizeClass& sizeClass = m_sizes[size];
+    sizeClass.lastUse = m_requests;
+    if (!sizeClass.free.empty())
+    {
+      buffer = sizeClass.free.back();
+      sizeClass.free.pop_back();
+    }
+  }
+
+  if (!buffer)
+  {
+    uint8_t* data = static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(size, BUFFER_ALIGN));
+    if (!data)
+      return nullptr;
+    buffer = new Buffer{weak_from_this(), data, size};
+  }
+
+  AVBufferRef* ref = av_buffer_create(buffer->data, buffer->size, FreeBuffer, buffer, 0);
+  if (!ref)
+    Return(buffer);
+  return ref;
+}
+
+void CFrameBufferPool::Clear()
+{
+  CSingleLock lock(m_section);
+
+  for (auto& size : m_sizes)
+  {
+    for (auto buffer : size.second.free)
+      Destroy(buffer);
+  }
+  m_sizes.clear();
+}
+
+void CFrameBufferPool::FreeBuffer(void* opaque, uint8_t* data)
+{
+  Buffer* buffer = static_cast<Buffer*>(opaque);
+
+  // frames may still be held by the renderer after the pool is gone
+  std::shared_ptr<CFrameBufferPool> pool = buffer->pool.lock();
+  if (pool)
+    pool->Return(buffer);
+  else
+    Destroy(buffer);
+}
+
+void CFrameBufferPool::Return(Buffer* buffer)
+{
+  CSingleLock lock(m_section);
+
+  auto it = m_sizes.find(buffer->size);
+  if (it == m_sizes.end() || m_requests - it->second.lastUse > STALE_REQUESTS)
+  {
+    Destroy(buffer);
+    return;
+  }
+  it->second.free.push_back(buffer);
+}
+
+void CFrameBufferPool::ReleaseStale()
+{
+  for (auto it = m_sizes.begin(); it != m_sizes.end();)
+  {
+    if (m_requests - it->second.lastUse > STALE_REQUESTS)
+    {
+      for (auto buffer : it->second.free)
+        Destroy(buffer);
+      it = m_sizes.erase(it);
+    }
+    else
+      ++it;
+  }
+}
+
+void CFrameBufferPool::Destroy(Buffer* buffer)
+{
+  KODI::MEMORY::AlignedFree(buffer->data);
+  delete buffer;
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+/*!
+ * \brief Pool of plane buffers for software decoded frames, keyed by buffer size.
+ *
+ * FFmpeg keeps its frame pool in the codec context, so it is dropped whenever the decoder
+ * is reopened or the frame size changes, and the freshly allocated planes page fault on
+ * first write. This pool is owned by CProcessInfo and therefore outlives codec instances
+ * within a playback. Buffers of sizes that were not asked for in a while are released.
+ */
+class CFrameBufferPool : public std::enable_shared_from_this<CFrameBufferPool>
+{
+public:
+  CFrameBufferPool() = default;
+  ~CFrameBufferPool();
+
+  /*!
+   * \brief Allocate the planes of a software frame, for use from a get_buffer2 callback.
+   * \return 0 on success, an AVERROR if the format can't be handled by the pool
+   */
+  int GetFrameBuffers(AVCodecContext* avctx, AVFrame* frame);
+
+  /*!
+   * \brief Whether GetFrameBuffers() can allocate frames of the given format.
+   */
+  static bool IsSupported(const AVCodecContext* avctx, AVPixelFormat format);
+
+  /*!
+   * \brief Get a reference counted buffer of at least size bytes.
+   */
+  AVBufferRef* Get(size_t size);
+
+  /*!
+   * \brief Release all buffers not in use.
+   */
+  void Clear();
+
+private:
+  struct Buffer
+  {
+    std::weak_ptr<CFrameBufferPool> pool;
+    uint8_t* data;
+    size_t size;
+  };
+
+  struct SizeClass
+  {
+    std::vector<Buffer*> free;
+    uint64_t lastUse = 0;
+  };
+
+  static void FreeBuffer(void* opaque, uint8_t* data);
+  void Return(Buffer* buffer);
+  void ReleaseStale();
+  static void Destroy(Buffer* buffer);
+
+  CCriticalSection m_section;
+  std::map<size_t, SizeClass> m_sizes;
+  uint64_t m_requests = 0;
+};
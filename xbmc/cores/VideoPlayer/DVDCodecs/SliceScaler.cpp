@@ -0,0 +1,310 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SliceScaler.h"
+
+#include "ServiceBroker.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "utils/MemUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+namespace
+{
+// don't bother splitting below this, context setup and job dispatch would dominate
+constexpr int MIN_SLICE_ROWS = 64;
+constexpr int MIN_PARALLEL_PIXELS = 320 * 240;
+constexpr int MAX_PLANES = 4;
+
+// source and destination rows the band's context converts, and the destination rows it owns.
+// the converted rows reach past the owned ones by the vertical filter's length, so rows at
+// the band edges are filtered from the same source rows as in a conversion in one piece.
+struct Band
+{
+  int srcY;
+  int srcH;
+  int dstY;
+  int dstH;
+  int outY;
+  int outH;
+};
+
+template<typename T>
+T* OffsetRows(T* plane, int stride, int y)
+{
+  return plane ? plane + static_cast<ptrdiff_t>(y) * stride : nullptr;
+}
+
+class CSliceJob
+{
+public:
+  int srcWidth;
+  AVPixelFormat srcFormat;
+  const uint8_t* src[MAX_PLANES];
+  int srcStride[MAX_PLANES];
+  int srcChromaShift;
+  int dstWidth;
+  AVPixelFormat dstFormat;
+  uint8_t* dst[MAX_PLANES];
+  int dstStride[MAX_PLANES];
+  int dstChromaShift;
+  int flags;
+  std::vector<Band> bands;
+
+  std::atomic<unsigned int> next{0};
+  std::atomic<unsigned int> done{0};
+  std::atomic<bool> failed{false};
+  CEvent finished{true};
+
+  // claim and convert bands until none are left
+  void Run()
+  {
+    unsigned int i;
+    while ((i = next++) < bands.size())
+    {
+      if (!ScaleBand(bands[i]))
+        failed = true;
+      if (++done == bands.size())
+        finished.Set();
+    }
+  }
+
+private:
+  bool ScaleBand(const Band& band) const
+  {
+    SwsContext* context = sws_getContext(srcWidth, band.srcH, srcFormat, dstWidth, band.dstH,
+                                         dstFormat, flags, nullptr, nullptr, nullptr);
+    if (!context)
+      return false;
+
+    const uint8_t* srcBand[MAX_PLANES];
+    for (int p = 0; p < MAX_PLANES; p++)
+    {
+      const bool chroma = p == 1 || p == 2;
+      srcBand[p] =
+          OffsetRows(src[p], srcStride[p], chroma ? band.srcY >> srcChromaShift : band.srcY);
+    }
+
+    bool ok = true;
+    if (band.outY == band.dstY && band.outH == band.dstH)
+    {
+      uint8_t* dstBand[MAX_PLANES];
+      for (int p = 0; p < MAX_PLANES; p++)
+      {
+        const bool chroma = p == 1 || p == 2;
+        dstBand[p] =
+            OffsetRows(dst[p], dstStride[p], chroma ? band.dstY >> dstChromaShift : band.dstY);
+      }
+      sws_scale(context, srcBand, srcStride, 0, band.srcH, dstBand, dstStride);
+    }
+    else
+    {
+      // the extra rows belong to the neighbouring bands, which may be writing them right now
+      uint8_t* tmp[MAX_PLANES] = {};
+      int tmpStride[MAX_PLANES] = {};
+      if (av_image_alloc(tmp, tmpStride, dstWidth, band.dstH, dstFormat,
+                         CSliceScaler::BUFFER_ALIGN) < 0)
+      {
+        ok = false;
+      }
+      else
+      {
+        sws_scale(context, srcBand, srcStride, 0, band.srcH, tmp, tmpStride);
+        for (int p = 0; p < av_pix_fmt_count_planes(dstFormat); p++)
+        {
+          const int shift = (p == 1 || p == 2) ? dstChromaShift : 0;
+          av_image_copy_plane(OffsetRows(dst[p], dstStride[p], band.outY >> shift), dstStride[p],
+                              OffsetRows(tmp[p], tmpStride[p], (band.outY - band.dstY) >> shift),
+                              tmpStride[p], av_image_get_linesize(dstFormat, dstWidth, p),
+                              band.outH >> shift);
+        }
+        av_freep(&tmp[0]);
+      }
+    }
+
+    sws_freeContext(context);
+    return ok;
+  }
+};
+
+bool CanSlice(const AVPixFmtDescriptor* desc)
+{
+  return desc && !(desc->flags & (AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_PAL |
+                                  AV_PIX_FMT_FLAG_BITSTREAM));
+}
+
+// smallest pair of source/destination row counts with the image's scaling ratio that start on
+// chroma rows of both images. band edges placed on multiples of these map onto each other
+// exactly, so every band context steps through the source like the whole image would.
+bool GetBandUnit(
+    int srcHeight, int dstHeight, int srcAlign, int dstAlign, int& srcUnit, int& dstUnit)
+{
+  if (srcHeight % srcAlign || dstHeight % dstAlign)
+    return false;
+
+  const int units = std::gcd(srcHeight, dstHeight);
+  srcUnit = srcHeight / units;
+  dstUnit = dstHeight / units;
+  while (srcUnit % srcAlign || dstUnit % dstAlign)
+  {
+    srcUnit *= 2;
+    dstUnit *= 2;
+  }
+  return srcHeight % srcUnit == 0;
+}
+
+// source rows on either side of a destination row that contribute to it, following the filter
+// sizes picked by swscale's initFilter()
+int GetFilterMargin(int srcHeight, int dstHeight, int flags, int srcChromaShift)
+{
+  int sizeFactor = 20;
+  if (flags & SWS_BICUBIC)
+    sizeFactor = 4;
+  else if (flags & SWS_X)
+    sizeFactor = 8;
+  else if (flags & SWS_AREA)
+    sizeFactor = 1;
+  else if (flags & SWS_GAUSS)
+    sizeFactor = 8;
+  else if (flags & SWS_LANCZOS)
+    sizeFactor = 6;
+  else if (flags & (SWS_SINC | SWS_SPLINE))
+    sizeFactor = 20;
+  else if (flags & SWS_BILINEAR)
+    sizeFactor = 2;
+  else if (flags & SWS_FAST_BILINEAR)
+    sizeFactor = 4;
+  else if (flags & SWS_POINT)
+    sizeFactor = 1;
+
+  // downscaling stretches the filter over the source rows
+  const int ratio = std::max(1, (srcHeight + dstHeight - 1) / dstHeight);
+  const int halfFilter = (1 + sizeFactor * ratio + 1) / 2 + 1;
+
+  // chroma is filtered in chroma rows, plus a little slack for swscale's filter alignment
+  return (halfFilter << srcChromaShift) + 2;
+}
+} // namespace
+
+bool CSliceScaler::Scale(int srcWidth,
+                         int srcHeight,
+                         AVPixelFormat srcFormat,
+                         const uint8_t* const src[],
+                         const int srcStride[],
+                         int dstWidth,
+                         int dstHeight,
+                         AVPixelFormat dstFormat,
+                         uint8_t* const dst[],
+                         const int dstStride[],
+                         int flags,
+                         unsigned int maxSlices /* = 0 */)
+{
+  if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0)
+    return false;
+
+  const AVPixFmtDescriptor* srcDesc = av_pix_fmt_desc_get(srcFormat);
+  const AVPixFmtDescriptor* dstDesc = av_pix_fmt_desc_get(dstFormat);
+
+  if (maxSlices == 0)
+    maxSlices = std::max(1, CServiceBroker::GetCPUInfo()->GetCPUCount());
+
+  unsigned int slices = 1;
+  if (CanSlice(srcDesc) && CanSlice(dstDesc) && dstWidth * dstHeight >= MIN_PARALLEL_PIXELS)
+    slices = std::min(maxSlices, static_cast<unsigned int>(
+                                     std::min(srcHeight, dstHeight) / MIN_SLICE_ROWS));
+
+  auto job = std::make_shared<CSliceJob>();
+  job->srcWidth = srcWidth;
+  job->srcFormat = srcFormat;
+  job->srcChromaShift = srcDesc ? srcDesc->log2_chroma_h : 0;
+  job->dstWidth = dstWidth;
+  job->dstFormat = dstFormat;
+  job->dstChromaShift = dstDesc ? dstDesc->log2_chroma_h : 0;
+  job->flags = flags;
+  for (int p = 0; p < MAX_PLANES; p++)
+  {
+    job->src[p] = src[p];
+    job->srcStride[p] = srcStride[p];
+    job->dst[p] = dst[p];
+    job->dstStride[p] = dstStride[p];
+  }
+
+  int srcUnit = 0;
+  int dstUnit = 0;
+  if (slices > 1 && !GetBandUnit(srcHeight, dstHeight, 1 << job->srcChromaShift,
+                                 1 << job->dstChromaShift, srcUnit, dstUnit))
+    slices = 1;
+
+  if (slices > 1)
+  {
+    const int units = srcHeight / srcUnit;
+    const int margin =
+        (GetFilterMargin(srcHeight, dstHeight, flags, job->srcChromaShift) + srcUnit - 1) /
+        srcUnit;
+    slices = std::min(slices, static_cast<unsigned int>(units));
+    for (unsigned int i = 0; i < slices; i++)
+    {
+      const int begin = static_cast<int>(static_cast<int64_t>(units) * i / slices);
+      const int end = static_cast<int>(static_cast<int64_t>(units) * (i + 1) / slices);
+      const int extBegin = std::max(0, begin - margin);
+      const int extEnd = std::min(units, end + margin);
+      job->bands.push_back({extBegin * srcUnit, (extEnd - extBegin) * srcUnit,
+                            extBegin * dstUnit, (extEnd - extBegin) * dstUnit, begin * dstUnit,
+                            (end - begin) * dstUnit});
+    }
+  }
+  else
+  {
+    job->bands.push_back({0, srcHeight, 0, dstHeight, 0, dstHeight});
+  }
+
+  for (size_t i = 1; i < job->bands.size(); i++)
+    CJobManager::GetInstance().Submit([job]() { job->Run(); }, CJob::PRIORITY_HIGH);
+
+  // the caller works on bands too, so this only waits for bands already in progress
+  job->Run();
+  job->finished.Wait();
+
+  if (job->failed)
+  {
+    CLog::Log(LOGERROR, "CSliceScaler::{} - failed to scale {}x{} {} -> {}x{} {}",
+              __FUNCTION__, srcWidth, srcHeight, av_get_pix_fmt_name(srcFormat), dstWidth,
+              dstHeight, av_get_pix_fmt_name(dstFormat));
+    return false;
+  }
+  return true;
+}
+
+int CSliceScaler::GetAlignedStride(int rowBytes)
+{
+  return (rowBytes + BUFFER_ALIGN - 1) & ~(BUFFER_ALIGN - 1);
+}
+
+uint8_t* CSliceScaler::AllocBuffer(int stride, int height)
+{
+  return static_cast<uint8_t*>(
+      KODI::MEMORY::AlignedMalloc(static_cast<size_t>(stride) * height, BUFFER_ALIGN));
+}
+
+void CSliceScaler::FreeBuffer(uint8_t* buffer)
+{
+  KODI::MEMORY::AlignedFree(buffer);
+}
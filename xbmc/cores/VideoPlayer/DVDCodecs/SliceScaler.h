@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+/*!
+ * \brief Slice-parallel software colour conversion and scaling.
+ *
+ * The destination image is split into horizontal bands, each converted by its own
+ * SwsContext. Band edges sit on rows where source and destination map onto each other
+ * exactly, and each band also converts the source rows its vertical filter reaches into from
+ * the neighbouring bands, so the result matches a conversion in one piece. Bands are handed
+ * out to CJobManager workers and to the calling thread through a shared counter, so the
+ * caller never waits on a band nobody has started. Frames too small to benefit, and heights
+ * without such matching rows, are converted in one piece.
+ */
+class CSliceScaler
+{
+public:
+  /*!
+   * \brief Row alignment in bytes used for buffers from AllocBuffer() and GetAlignedStride().
+   */
+  static constexpr int BUFFER_ALIGN = 64;
+
+  /*!
+   * \brief Convert/scale src into dst, see sws_getContext() and sws_scale() for the parameters.
+   * \param maxSlices upper bound for the number of bands, 0 to use the number of CPUs
+   * \return true on success
+   */
+  static bool Scale(int srcWidth,
+                    int srcHeight,
+                    AVPixelFormat srcFormat,
+                    const uint8_t* const src[],
+                    const int srcStride[],
+                    int dstWidth,
+                    int dstHeight,
+                    AVPixelFormat dstFormat,
+                    uint8_t* const dst[],
+                    const int dstStride[],
+                    int flags,
+                    unsigned int maxSlices = 0);
+
+  /*!
+   * \brief Stride for a row of the given byte size, padded to BUFFER_ALIGN.
+   */
+  static int GetAlignedStride(int rowBytes);
+
+  /*!
+   * \brief Allocate an image buffer aligned to BUFFER_ALIGN, free with FreeBuffer().
+   */
+  static uint8_t* AllocBuffer(int stride, int height);
+  static void FreeBuffer(uint8_t* buffer);
+};
@@ -12,6 +12,7 @@
 #include "DVDCodecs/DVDFactoryCodec.h"
 #include "DVDStreamInfo.h"
 #include "ServiceBroker.h"
+#include "cores/VideoPlayer/Buffers/FrameBufferPool.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "cores/VideoSettings.h"
@@ -268,7 +269,7 @@ enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx
   if (ctx->HasHardware())
   {
     ctx->SetHardware(nullptr);
-    avctx->get_buffer2 = avcodec_default_get_buffer2;
+    avctx->get_buffer2 = GetBuffer;
     avctx->slice_flags = 0;
     av_buffer_unref(&avctx->hw_frames_ctx);
   }
@@ -302,10 +303,25 @@ enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx
   return avcodec_default_get_format(avctx, fmt);
 }
 
+int CDVDVideoCodecFFmpeg::GetBuffer(struct AVCodecContext* avctx, AVFrame* frame, int flags)
+{
+  ICallbackHWAccel* cb = static_cast<ICallbackHWAccel*>(avctx->opaque);
+  CDVDVideoCodecFFmpeg* ctx = dynamic_cast<CDVDVideoCodecFFmpeg*>(cb);
+
+  // planes come from the pool of the player, so they survive flushes and codec reopen
+  if (ctx && ctx->m_framePool &&
+      CFrameBufferPool::IsSupported(avctx, static_cast<AVPixelFormat>(frame->format)) &&
+      ctx->m_framePool->GetFrameBuffers(avctx, frame) == 0)
+    return 0;
+
+  return avcodec_default_get_buffer2(avctx, frame, flags);
+}
+
 CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg(CProcessInfo &processInfo)
 : CDVDVideoCodec(processInfo), m_postProc(processInfo)
 {
   m_videoBufferPool = std::make_shared<CVideoBufferPoolFFmpeg>();
+  m_framePool = processInfo.GetFrameBufferPool();
 
   m_decoderState = STATE_NONE;
 }
@@ -364,6 +380,11 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   m_pCodecContext->debug = 0;
   m_pCodecContext->workaround_bugs = FF_BUG_AUTODETECT;
   m_pCodecContext->get_format = GetFormat;
+  m_pCodecContext->get_buffer2 = GetBuffer;
+#if FF_API_THREAD_SAFE_CALLBACKS
+  // the frame pool is locked, no need to serialize allocations of frame threads
+  m_pCodecContext->thread_safe_callbacks = 1;
+#endif
   m_pCodecContext->codec_tag = hints.codec_tag;
 
   // setup threading model
@@ -25,6 +25,7 @@ extern "C" {
 }
 
 class CVideoBufferPoolFFmpeg;
+class CFrameBufferPool;
 
 class CDVDVideoCodecFFmpeg : public CDVDVideoCodec, public ICallbackHWAccel
 {
@@ -48,6 +49,7 @@ public:
 protected:
   void Dispose();
   static enum AVPixelFormat GetFormat(struct AVCodecContext * avctx, const AVPixelFormat * fmt);
+  static int GetBuffer(struct AVCodecContext* avctx, AVFrame* frame, int flags);
 
   int  FilterOpen(const std::string& filters, bool scale);
   void FilterClose();
@@ -63,6 +65,7 @@ protected:
   AVFrame* m_pDecodedFrame = nullptr;;
   AVCodecContext* m_pCodecContext = nullptr;;
   std::shared_ptr<CVideoBufferPoolFFmpeg> m_videoBufferPool;
+  std::shared_ptr<CFrameBufferPool> m_framePool;
 
   std::string m_filters;
   std::string m_filters_next;
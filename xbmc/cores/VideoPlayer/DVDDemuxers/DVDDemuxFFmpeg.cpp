@@ -670,6 +670,8 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
       return false;
     m_pFormatContext->duration = duration;
   }
+  else
+    InitKeyframeIndex();
 
   return true;
 }
@@ -679,6 +681,11 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
+  if (m_keyframeIndexEnabled && m_pInput)
+    m_keyframeIndex.Save(m_pInput->GetFileName(), m_pInput->GetLength());
+  m_keyframeIndex.Clear();
+  m_keyframeIndexEnabled = false;
+
   if (m_pFormatContext)
   {
     if (m_ioContext && m_pFormatContext->pb && m_pFormatContext->pb != m_ioContext)
@@ -728,6 +735,8 @@ void CDVDDemuxFFmpeg::Flush()
   m_displayTime = 0;
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
   m_seekToKeyFrame = false;
+
+  m_keyframeIndex.Discontinuity();
 }
 
 void CDVDDemuxFFmpeg::Abort()
@@ -1149,6 +1158,9 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
           }
         }
 
+        if (m_keyframeIndexEnabled)
+          AddToKeyframeIndex(m_pkt.pkt, *pPacket);
+
         // used to guess streamlength
         if (pPacket->dts != DVD_NOPTS_VALUE && (pPacket->dts > m_currentPts || m_currentPts == DVD_NOPTS_VALUE))
           m_currentPts = pPacket->dts;
@@ -1287,7 +1299,12 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
   int ret;
   {
     CSingleLock lock(m_critSection);
-    ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
+    m_keyframeIndex.Discontinuity();
+    if (m_keyframeIndexEnabled && SeekKeyframeIndex(time, backwards))
+      ret = 0;
+    else
+      ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts,
+                          backwards ? AVSEEK_FLAG_BACKWARD : 0);
 
     if (ret < 0)
     {
@@ -1347,6 +1364,7 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 {
   CSingleLock lock(m_critSection);
+  m_keyframeIndex.Discontinuity();
   int ret = av_seek_frame(m_pFormatContext, -1, pos, AVSEEK_FLAG_BYTE);
 
   if (ret >= 0)
@@ -1358,6 +1376,58 @@ bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
   return (ret >= 0);
 }
 
+void CDVDDemuxFFmpeg::InitKeyframeIndex()
+{
+  m_keyframeIndex.Clear();
+  m_keyframeIndexEnabled = false;
+
+  // only for containers that are seeked by bisection and can resync after a byte seek,
+  // others either have a proper index or can't resume in the middle of a cluster
+  if (!m_pFormatContext || !m_pFormatContext->iformat ||
+      (m_pFormatContext->iformat->flags & AVFMT_NO_BYTE_SEEK) ||
+      (strcmp(m_pFormatContext->iformat->name, "mpegts") != 0 &&
+       strcmp(m_pFormatContext->iformat->name, "mpeg") != 0))
+    return;
+
+  if (m_pInput->IsRealtime() || m_pInput->GetLength() <= 0 || m_pInput->GetIPosTime() ||
+      std::dynamic_pointer_cast<CDVDInputStream::IMenus>(m_pInput))
+    return;
+
+  m_keyframeIndexStream = av_find_default_stream_index(m_pFormatContext);
+  if (m_keyframeIndexStream < 0)
+    return;
+
+  m_keyframeIndexEnabled = true;
+  m_keyframeIndex.Load(m_pInput->GetFileName(), m_pInput->GetLength());
+}
+
+void CDVDDemuxFFmpeg::AddToKeyframeIndex(const AVPacket& pkt, const DemuxPacket& packet)
+{
+  const int indexStream = m_seekStream >= 0 ? m_seekStream : m_keyframeIndexStream;
+  if (pkt.stream_index != indexStream || !(pkt.flags & AV_PKT_FLAG_KEY) || pkt.pos < 0)
+    return;
+
+  const double pts = packet.pts != DVD_NOPTS_VALUE ? packet.pts : packet.dts;
+  if (pts == DVD_NOPTS_VALUE)
+    return;
+
+  m_keyframeIndex.Add(static_cast<int64_t>(DVD_TIME_TO_MSEC(pts)), pkt.pos);
+}
+
+bool CDVDDemuxFFmpeg::SeekKeyframeIndex(double time, bool backwards)
+{
+  CDemuxKeyframeIndex::Entry keyframe;
+  if (!m_keyframeIndex.Lookup(static_cast<int64_t>(time), backwards, keyframe))
+    return false;
+
+  if (av_seek_frame(m_pFormatContext, -1, keyframe.pos, AVSEEK_FLAG_BYTE) < 0)
+    return false;
+
+  CLog::Log(LOGDEBUG, "{} - seek to {}ms resolved from keyframe index: {}ms at byte {}",
+            __FUNCTION__, static_cast<int64_t>(time), keyframe.time, keyframe.pos);
+  return true;
+}
+
 void CDVDDemuxFFmpeg::UpdateCurrentPTS()
 {
   m_currentPts = DVD_NOPTS_VALUE;
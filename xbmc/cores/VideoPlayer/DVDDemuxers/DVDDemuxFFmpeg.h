@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDDemux.h"
+#include "DemuxKeyframeIndex.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include <map>
@@ -137,6 +138,10 @@ protected:
   std::string GetStereoModeFromMetadata(AVDictionary* pMetadata);
   std::string ConvertCodecToInternalStereoMode(const std::string& mode, const StereoModeConversionMap* conversionMap);
 
+  void InitKeyframeIndex();
+  void AddToKeyframeIndex(const AVPacket& pkt, const DemuxPacket& packet);
+  bool SeekKeyframeIndex(double time, bool backwards);
+
   void GetL16Parameters(int& channels, int& samplerate);
   double SelectAspect(AVStream* st, bool& forced);
 
@@ -175,5 +180,9 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+
+  CDemuxKeyframeIndex m_keyframeIndex;
+  bool m_keyframeIndexEnabled = false;
+  int m_keyframeIndexStream = -1;
 };
 
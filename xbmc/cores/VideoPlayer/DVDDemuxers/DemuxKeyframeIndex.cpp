@@ -0,0 +1,212 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxKeyframeIndex.h"
+
+#include "FileItem.h"
+#include "XBDateTime.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr char CACHE_FOLDER[] = "special://temp/keyframes/";
+constexpr uint32_t CACHE_MAGIC = 0x5846494B; // "KIFX"
+constexpr uint32_t CACHE_VERSION = 1;
+// don't bother persisting an index that can't answer more than a handful of seeks
+constexpr size_t MIN_SAVE_ENTRIES = 16;
+// an hour of video with a keyframe every second takes about 85kB
+constexpr int64_t MAX_CACHE_SIZE = 32 * 1024 * 1024;
+constexpr int MAX_CACHE_AGE_DAYS = 30;
+
+struct CacheHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  int64_t fileSize;
+  uint64_t count;
+};
+
+struct CacheEntry
+{
+  int64_t time;
+  int64_t pos;
+  uint8_t contiguous;
+  uint8_t padding[7];
+};
+
+bool TimeLess(const CDemuxKeyframeIndex::Entry& entry, int64_t time)
+{
+  return entry.time < time;
+}
+} // namespace
+
+void CDemuxKeyframeIndex::Add(int64_t time, int64_t pos)
+{
+  if (time < 0 || pos < 0)
+    return;
+
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), time, TimeLess);
+
+  // only contiguous if the entry before the insertion point is the keyframe we saw last
+  const bool contiguous =
+      m_last >= 0 && m_last < time && it != m_entries.begin() && std::prev(it)->time == m_last;
+  m_last = time;
+
+  if (it != m_entries.end() && it->time == time)
+  {
+    if (contiguous && !it->contiguous)
+    {
+      it->contiguous = true;
+      m_dirty = true;
+    }
+    return;
+  }
+
+  // an entry nobody saw before ends up between two others, which therefore weren't adjacent
+  if (it != m_entries.end())
+    it->contiguous = false;
+
+  m_entries.insert(it, {time, pos, contiguous});
+  m_dirty = true;
+}
+
+bool CDemuxKeyframeIndex::Lookup(int64_t time, bool backwards, Entry& entry) const
+{
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), time, TimeLess);
+
+  if (it != m_entries.end() && it->time == time)
+  {
+    entry = *it;
+    return true;
+  }
+
+  // it is the first keyframe after time, which is only meaningful if its predecessor
+  // was read in the same go, i.e. there is no unknown keyframe in between
+  if (it == m_entries.end() || it == m_entries.begin() || !it->contiguous)
+    return false;
+
+  entry = backwards ? *std::prev(it) : *it;
+  return true;
+}
+
+void CDemuxKeyframeIndex::Clear()
+{
+  m_entries.clear();
+  m_last = -1;
+  m_dirty = false;
+}
+
+std::string CDemuxKeyframeIndex::GetCachePath(const std::string& path)
+{
+  return StringUtils::Format("{}{:08x}.kfi", CACHE_FOLDER, Crc32::Compute(path));
+}
+
+bool CDemuxKeyframeIndex::Load(const std::string& path, int64_t fileSize)
+{
+  Clear();
+
+  XFILE::CFile file;
+  if (!file.Open(GetCachePath(path)))
+    return false;
+
+  CacheHeader header;
+  if (file.Read(&header, sizeof(header)) != sizeof(header) || header.magic != CACHE_MAGIC ||
+      header.version != CACHE_VERSION || header.fileSize != fileSize ||
+      static_cast<int64_t>(sizeof(header) + header.count * sizeof(CacheEntry)) !=
+          file.GetLength())
+    return false;
+
+  std::vector<CacheEntry> entries(header.count);
+  const size_t size = entries.size() * sizeof(CacheEntry);
+  if (file.Read(entries.data(), size) != static_cast<ssize_t>(size))
+    return false;
+
+  m_entries.reserve(entries.size());
+  for (const auto& entry : entries)
+  {
+    if (!m_entries.empty() && m_entries.back().time >= entry.time)
+    {
+      CLog::Log(LOGWARNING, "CDemuxKeyframeIndex::{} - ignoring corrupt index {}", __FUNCTION__,
+                GetCachePath(path));
+      Clear();
+      return false;
+    }
+    m_entries.push_back({entry.time, entry.pos, entry.contiguous != 0});
+  }
+
+  CLog::Log(LOGDEBUG, "CDemuxKeyframeIndex::{} - loaded {} keyframes", __FUNCTION__,
+            m_entries.size());
+  return true;
+}
+
+bool CDemuxKeyframeIndex::Save(const std::string& path, int64_t fileSize)
+{
+  if (!m_dirty || m_entries.size() < MIN_SAVE_ENTRIES)
+    return false;
+
+  if (!XFILE::CDirectory::Exists(CACHE_FOLDER))
+    XFILE::CDirectory::Create(CACHE_FOLDER);
+
+  std::vector<CacheEntry> entries;
+  entries.reserve(m_entries.size());
+  for (const auto& entry : m_entries)
+    entries.push_back({entry.time, entry.pos, entry.contiguous, {}});
+
+  CacheHeader header{CACHE_MAGIC, CACHE_VERSION, fileSize, entries.size()};
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(GetCachePath(path), true))
+    return false;
+
+  const size_t size = entries.size() * sizeof(CacheEntry);
+  if (file.Write(&header, sizeof(header)) != sizeof(header) ||
+      file.Write(entries.data(), size) != static_cast<ssize_t>(size))
+  {
+    file.Close();
+    XFILE::CFile::Delete(GetCachePath(path));
+    return false;
+  }
+  file.Close();
+
+  m_dirty = false;
+  PruneCache();
+  return true;
+}
+
+void CDemuxKeyframeIndex::PruneCache()
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(CACHE_FOLDER, items, ".kfi", XFILE::DIR_FLAG_NO_FILE_DIRS))
+    return;
+
+  // newest first, the total size is counted from there
+  items.Sort(SortByDate, SortOrderDescending);
+
+  const CDateTime oldest =
+      CDateTime::GetCurrentDateTime() - CDateTimeSpan(MAX_CACHE_AGE_DAYS, 0, 0, 0);
+  int64_t size = 0;
+  for (const auto& item : items)
+  {
+    if (item->m_bIsFolder)
+      continue;
+
+    size += item->m_dwSize;
+    if (size > MAX_CACHE_SIZE || (item->m_dateTime.IsValid() && item->m_dateTime < oldest))
+    {
+      CLog::Log(LOGDEBUG, "CDemuxKeyframeIndex::{} - deleting {}", __FUNCTION__, item->GetPath());
+      XFILE::CFile::Delete(item->GetPath());
+      size -= item->m_dwSize;
+    }
+  }
+}
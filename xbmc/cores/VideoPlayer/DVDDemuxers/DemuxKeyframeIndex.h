@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Keyframe index (time -> byte offset) built while packets are demuxed.
+ *
+ * Containers without a usable index (MPEG-TS, MPEG-PS) are seeked by bisection, which
+ * costs several reads per seek. Keyframes seen during playback are recorded here, and a
+ * keyframe is only trusted as "the keyframe before time x" if it was followed by its
+ * direct successor in one uninterrupted read, so a lookup never returns a keyframe that
+ * skips over one that was never seen. The index can be stored next to the other caches
+ * so seeks on the next playback of the same file are resolved from it directly.
+ */
+class CDemuxKeyframeIndex
+{
+public:
+  struct Entry
+  {
+    int64_t time; ///< presentation time in ms
+    int64_t pos; ///< byte offset of the packet in the input
+    bool contiguous; ///< previous entry is the keyframe directly preceding this one
+  };
+
+  /*!
+   * \brief Record a keyframe.
+   * \param time presentation time in ms
+   * \param pos byte offset of the packet
+   */
+  void Add(int64_t time, int64_t pos);
+
+  /*!
+   * \brief The next Add() does not follow the previous one in the stream, call on seek/flush.
+   */
+  void Discontinuity() { m_last = -1; }
+
+  /*!
+   * \brief Find the keyframe to seek to for time.
+   * \param backwards the last keyframe at or before time, otherwise the first at or after it
+   * \return false if the index cannot answer this exactly
+   */
+  bool Lookup(int64_t time, bool backwards, Entry& entry) const;
+
+  void Clear();
+  size_t Size() const { return m_entries.size(); }
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+  /*!
+   * \brief Load a previously saved index for path, the index is left empty if the cached one
+   *        does not exist or was saved for a file of different size.
+   */
+  bool Load(const std::string& path, int64_t fileSize);
+
+  /*!
+   * \brief Save the index for path if it changed since Load(), then prune the cache.
+   */
+  bool Save(const std::string& path, int64_t fileSize);
+
+  static std::string GetCachePath(const std::string& path);
+
+  /*!
+   * \brief Delete cached indexes not written for a month, then the oldest ones until the
+   *        cache is below its size limit.
+   */
+  static void PruneCache();
+
+private:
+  std::vector<Entry> m_entries;
+  int64_t m_last = -1; ///< time of the entry added last, -1 after a discontinuity
+  bool m_dirty = false;
+};
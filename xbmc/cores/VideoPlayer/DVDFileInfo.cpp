@@ -27,6 +27,7 @@
 #include "DVDDemuxers/DVDDemuxUtils.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
 #include "DVDCodecs/DVDFactoryCodec.h"
+#include "DVDCodecs/SliceScaler.h"
 #include "DVDCodecs/Video/DVDVideoCodec.h"
 #include "DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
@@ -40,6 +41,8 @@
 #include "Util.h"
 #include "utils/LangCodeExpander.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
 
@@ -89,23 +92,52 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
                                 CTextureDetails &details,
                                 CStreamDetails *pStreamDetails,
                                 int64_t pos)
+{
+  std::vector<ThumbRequest> requests(1);
+  requests[0].pos = pos;
+  requests[0].details = &details;
+  return ExtractThumbs(fileItem, requests, pStreamDetails) == 1;
+}
+
+namespace
+{
+struct ThumbRequestContext
+{
+  CDVDDemux* demuxer;
+  CDVDVideoCodec* codec;
+  const CDVDStreamInfo& hint;
+  int videoStream;
+  const std::string& redactPath;
+  int& packetsTried;
+};
+
+bool DecodeThumb(const ThumbRequestContext& ctx, CDVDFileInfo::ThumbRequest& request);
+} // namespace
+
+unsigned int CDVDFileInfo::ExtractThumbs(const CFileItem& fileItem,
+                                         std::vector<ThumbRequest>& requests,
+                                         CStreamDetails* pStreamDetails,
+                                         const std::function<bool(const ThumbRequest&)>& progress)
 {
   const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
   auto start = std::chrono::steady_clock::now();
 
+  for (auto& request : requests)
+    request.extracted = false;
+
   CFileItem item(fileItem);
   item.SetMimeTypeForInternetFile();
   auto pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
   if (!pInputStream)
   {
     CLog::Log(LOGERROR, "InputStream: Error creating stream for {}", redactPath);
-    return false;
+    return 0;
   }
 
   if (!pInputStream->Open())
   {
     CLog::Log(LOGERROR, "InputStream: Error opening, {}", redactPath);
-    return false;
+    return 0;
   }
 
   CDVDDemux *pDemuxer = NULL;
@@ -116,7 +148,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if(!pDemuxer)
     {
       CLog::Log(LOGERROR, "{} - Error creating demuxer", __FUNCTION__);
-      return false;
+      return 0;
     }
   }
   catch(...)
@@ -125,7 +157,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if (pDemuxer)
       delete pDemuxer;
 
-    return false;
+    return 0;
   }
 
   if (pStreamDetails)
@@ -180,8 +212,9 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
-  bool bOk = false;
+  unsigned int extracted = 0;
   int packetsTried = 0;
+  bool decoding = false;
 
   if (nVideoStream != -1)
   {
@@ -198,113 +231,178 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
 
     if (pVideoCodec)
     {
-      int nTotalLen = pDemuxer->GetStreamLength();
-      int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
-
-      CLog::Log(LOGDEBUG, "{} - seeking to pos {}ms (total: {}ms) in {}", __FUNCTION__, nSeekTo,
-                nTotalLen, redactPath);
-
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+      decoding = true;
+
+      // we only need the first picture after each seek, which is a keyframe,
+      // so don't waste time on non-reference frames
+      pVideoCodec->SetCodecControl(DVD_CODEC_CTRL_DROP_ANY);
+
+      const int nTotalLen = pDemuxer->GetStreamLength();
+      ThumbRequestContext ctx{pDemuxer, pVideoCodec.get(), hint, nVideoStream, redactPath,
+                              packetsTried};
+
+      // visit the positions in file order so the demuxer mostly seeks forward
+      std::vector<size_t> order(requests.size());
+      for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+      auto seekPos = [&requests, nTotalLen](size_t i) {
+        return requests[i].pos == -1 ? nTotalLen / 3 : requests[i].pos;
+      };
+      std::stable_sort(order.begin(), order.end(),
+                       [&seekPos](size_t a, size_t b) { return seekPos(a) < seekPos(b); });
+
+      bool first = true;
+      for (size_t i : order)
       {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
+        ThumbRequest& request = requests[i];
+        auto requestStart = std::chrono::steady_clock::now();
+        const int64_t nSeekTo = seekPos(i);
 
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
-        {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
+        CLog::Log(LOGDEBUG, "{} - seeking to pos {}ms (total: {}ms) in {}", __FUNCTION__, nSeekTo,
+                  nTotalLen, redactPath);
 
-          if (!pPacket)
-            break;
+        if (!first)
+          pVideoCodec->Reset();
+        first = false;
 
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
+        request.attempted = true;
+        if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+          request.extracted = DecodeThumb(ctx, request);
 
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+        if (request.extracted)
+          extracted++;
 
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
+        request.latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - requestStart);
+        CLog::Log(LOGDEBUG, "{} - image at {}ms of {} {} in {} ms", __FUNCTION__, nSeekTo,
+                  redactPath, request.extracted ? "extracted" : "failed",
+                  request.latency.count());
 
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
-          {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
-          }
-
-        } while (abort_index--);
-
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
-          {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
-            int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
-            uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
-          }
-        }
-        else
-        {
-          CLog::Log(LOGDEBUG, "{} - decode failed in {} after {} packets.", __FUNCTION__,
-                    redactPath, packetsTried);
-        }
+        if (progress && !progress(request))
+          break;
       }
     }
   }
 
+  if (!decoding)
+  {
+    // no picture can be had from this file at all
+    for (auto& request : requests)
+      request.attempted = true;
+  }
+
   if (pDemuxer)
     delete pDemuxer;
 
-  if(!bOk)
+  for (auto& request : requests)
   {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
+    if (request.attempted && !request.extracted && request.details)
+    {
+      XFILE::CFile file;
+      if (file.OpenForWrite(CTextureCache::GetCachedPath(request.details->file)))
+        file.Close();
+    }
   }
 
   auto end = std::chrono::steady_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-  CLog::Log(LOGDEBUG, "{} - measured {} ms to extract thumb from file <{}> in {} packets. ",
-            __FUNCTION__, duration.count(), redactPath, packetsTried);
+  CLog::Log(LOGDEBUG,
+            "{} - measured {} ms to extract {} of {} thumbs from file <{}> in {} packets. ",
+            __FUNCTION__, duration.count(), extracted, requests.size(), redactPath, packetsTried);
+
+  return extracted;
+}
+
+namespace
+{
+bool DecodeThumb(const ThumbRequestContext& ctx, CDVDFileInfo::ThumbRequest& request)
+{
+  CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+  VideoPicture picture = {};
+  int packetsTried = 0;
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = ctx.demuxer->GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = ctx.demuxer->Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != ctx.videoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    ctx.codec->AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
+    {
+      iDecoderState = ctx.codec->GetPicture(&picture);
+    }
+
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    {
+      if(!(picture.iFlags & DVP_FLAG_DROPPED))
+        break;
+    }
+
+  } while (abort_index--);
+
+  ctx.packetsTried += packetsTried;
+
+  bool bOk = false;
+  if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
+  {
+    unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+    double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+    if(ctx.hint.forced_aspect && ctx.hint.aspect != 0)
+      aspect = ctx.hint.aspect;
+    unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+    // rows are padded so every band of the parallel scaler starts SIMD aligned
+    int dstPitch = CSliceScaler::GetAlignedStride(nWidth * 4);
+    uint8_t* pOutBuf = CSliceScaler::AllocBuffer(dstPitch, nHeight);
+    if (pOutBuf)
+    {
+      uint8_t *planes[YuvImage::MAX_PLANES];
+      int stride[YuvImage::MAX_PLANES];
+      picture.videoBuffer->GetPlanes(planes);
+      picture.videoBuffer->GetStrides(stride);
+      const uint8_t* src[4] = {planes[0], planes[1], planes[2], nullptr};
+      int srcStride[] = { stride[0], stride[1], stride[2], 0 };
+      uint8_t* dst[] = {pOutBuf, nullptr, nullptr, nullptr};
+      int dstStride[] = {dstPitch, 0, 0, 0};
+      int orientation = DegreeToOrientation(ctx.hint.orientation);
+
+      if (CSliceScaler::Scale(picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P, src,
+                              srcStride, nWidth, nHeight, AV_PIX_FMT_BGRA, dst, dstStride,
+                              SWS_FAST_BILINEAR))
+      {
+        CTextureDetails& details = *request.details;
+        details.width = nWidth;
+        details.height = nHeight;
+        CPicture::CacheTexture(pOutBuf, nWidth, nHeight, dstPitch, orientation, nWidth,
+                               nHeight, CTextureCache::GetCachedPath(details.file));
+        bOk = true;
+      }
+      CSliceScaler::FreeBuffer(pOutBuf);
+    }
+  }
+  else
+  {
+    CLog::Log(LOGDEBUG, "{} - decode failed in {} after {} packets.", __FUNCTION__,
+              ctx.redactPath, packetsTried);
+  }
 
   return bOk;
 }
+} // namespace
 
 /**
  * \brief Open the item pointed to by pItem and extract streamdetails
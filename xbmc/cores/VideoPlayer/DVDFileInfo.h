@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +30,28 @@ public:
                            CStreamDetails *pStreamDetails,
                            int64_t pos);
 
+  /*! \brief A single image to extract with ExtractThumbs() */
+  struct ThumbRequest
+  {
+    int64_t pos = -1; ///< position in ms, -1 to pick a third into the file
+    CTextureDetails* details = nullptr; ///< details->file is the cache target, size is filled in
+    bool extracted = false; ///< set when the image was decoded and cached
+    bool attempted = false; ///< set once the image was tried, false if aborted before
+    std::chrono::milliseconds latency{0}; ///< time spent seeking and decoding this image
+  };
+
+  /*! \brief Extract several images from one file, opening input, demuxer and codec only once.
+   *  Positions are visited in ascending order regardless of their order in requests.
+   *  \param progress optional, called after each request was handled, return false to abort
+   *  Requests that were tried and failed get an empty cache file, so they aren't tried again,
+   *  the ones skipped by an abort are left alone.
+   *  \return number of images extracted
+   */
+  static unsigned int ExtractThumbs(const CFileItem& fileItem,
+                                    std::vector<ThumbRequest>& requests,
+                                    CStreamDetails* pStreamDetails = nullptr,
+                                    const std::function<bool(const ThumbRequest&)>& progress = {});
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(const std::shared_ptr<CDVDInputStream>& pInputStream,
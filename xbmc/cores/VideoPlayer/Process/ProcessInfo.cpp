@@ -10,6 +10,7 @@
 
 #include "ServiceBroker.h"
 #include "cores/DataCacheCore.h"
+#include "cores/VideoPlayer/Buffers/FrameBufferPool.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
@@ -41,6 +42,7 @@ CProcessInfo* CProcessInfo::CreateInstance()
 
 CProcessInfo::CProcessInfo()
 {
+  m_frameBufferPool = std::make_shared<CFrameBufferPool>();
   m_videoSettingsLocked.reset(new CVideoSettingsLocked(m_videoSettings, m_settingsSection));
 }
 
@@ -298,6 +300,11 @@ CVideoBufferManager& CProcessInfo::GetVideoBufferManager()
   return m_videoBufferManager;
 }
 
+std::shared_ptr<CFrameBufferPool> CProcessInfo::GetFrameBufferPool()
+{
+  return m_frameBufferPool;
+}
+
 std::vector<AVPixelFormat> CProcessInfo::GetPixFormats()
 {
   CSingleLock lock(m_videoCodecSection);
@@ -497,6 +504,20 @@ bool CProcessInfo::IsRealtimeStream()
   return m_realTimeStream;
 }
 
+void CProcessInfo::SetStateNetworkStream(bool state)
+{
+  CSingleLock lock(m_stateSection);
+
+  m_networkStream = state;
+}
+
+bool CProcessInfo::IsNetworkStream()
+{
+  CSingleLock lock(m_stateSection);
+
+  return m_networkStream;
+}
+
 void CProcessInfo::SetSpeed(float speed)
 {
   CSingleLock lock(m_stateSection);
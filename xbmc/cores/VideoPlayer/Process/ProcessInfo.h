@@ -16,10 +16,12 @@
 #include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 
 class CProcessInfo;
 class CDataCacheCore;
+class CFrameBufferPool;
 
 using CreateProcessControl = CProcessInfo* (*)();
 
@@ -57,6 +59,7 @@ public:
   void SetDeinterlacingMethodDefault(EINTERLACEMETHOD method);
   EINTERLACEMETHOD GetDeinterlacingMethodDefault();
   CVideoBufferManager& GetVideoBufferManager();
+  std::shared_ptr<CFrameBufferPool> GetFrameBufferPool();
   std::vector<AVPixelFormat> GetPixFormats();
   void SetPixFormats(std::vector<AVPixelFormat> &formats);
 
@@ -86,6 +89,8 @@ public:
   bool IsSeeking();
   void SetStateRealtime(bool state);
   bool IsRealtimeStream();
+  void SetStateNetworkStream(bool state);
+  bool IsNetworkStream();
   void SetSpeed(float speed);
   void SetNewSpeed(float speed);
   float GetNewSpeed();
@@ -132,6 +137,7 @@ protected:
   EINTERLACEMETHOD m_deintMethodDefault;
   CCriticalSection m_videoCodecSection;
   CVideoBufferManager m_videoBufferManager;
+  std::shared_ptr<CFrameBufferPool> m_frameBufferPool;
   std::vector<AVPixelFormat> m_pixFormats;
 
   // player audio info
@@ -165,6 +171,7 @@ protected:
   int64_t m_timeMax;
   int64_t m_timeMin;
   bool m_realTimeStream;
+  bool m_networkStream = false;
 
   // settings
   CCriticalSection m_settingsSection;
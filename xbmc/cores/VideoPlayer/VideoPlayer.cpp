@@ -695,6 +695,8 @@ bool CVideoPlayer::CloseFile(bool reopen)
 {
   CLog::Log(LOGINFO, "CVideoPlayer::CloseFile()");
 
+  m_prefetch.Clear();
+
   // set the abort request so that other threads can finish up
   m_bAbortRequest = true;
   m_bCloseRequest = true;
@@ -733,6 +735,13 @@ bool CVideoPlayer::CloseFile(bool reopen)
   return true;
 }
 
+void CVideoPlayer::PrefetchNextFile(const CFileItem& file)
+{
+  CFileItem item(file);
+  item.SetMimeTypeForInternetFile();
+  m_prefetch.Prefetch(item);
+}
+
 bool CVideoPlayer::IsPlaying() const
 {
   return !m_bStop;
@@ -765,21 +774,34 @@ bool CVideoPlayer::OpenInputStream()
     m_item.SetPath(CServiceBroker::GetMediaManager().TranslateDevicePath(""));
   }
 
-  m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
-  if (m_pInputStream == nullptr)
+  m_pPrefetchedDemuxer.reset();
+  if (m_prefetch.Take(m_item, m_pInputStream, m_pPrefetchedDemuxer))
   {
-    CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - unable to create input stream for [{}]",
+    CLog::Log(LOGINFO, "CVideoPlayer::OpenInputStream - using prefetched input for [{}]",
               CURL::GetRedacted(m_item.GetPath()));
-    return false;
   }
-
-  if (!m_pInputStream->Open())
+  else
   {
-    CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - error opening [{}]",
-              CURL::GetRedacted(m_item.GetPath()));
-    return false;
+    m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
+    if (m_pInputStream == nullptr)
+    {
+      CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - unable to create input stream for [{}]",
+                CURL::GetRedacted(m_item.GetPath()));
+      return false;
+    }
+
+    if (!m_pInputStream->Open())
+    {
+      CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - error opening [{}]",
+                CURL::GetRedacted(m_item.GetPath()));
+      return false;
+    }
   }
 
+  // sources that may stall, audio is decoded ahead for them
+  m_processInfo->SetStateNetworkStream(m_item.IsInternetStream() ||
+                                       URIUtils::IsRemote(m_item.GetDynPath()));
+
   // find any available external subtitles for non dvd files
   if (!m_pInputStream->IsStreamType(DVDSTREAM_TYPE_DVD) &&
       !m_pInputStream->IsStreamType(DVDSTREAM_TYPE_PVRMANAGER))
@@ -824,7 +846,14 @@ bool CVideoPlayer::OpenDemuxStream()
 
   CLog::Log(LOGINFO, "Creating Demuxer");
 
+  // demuxer of a prefetched input stream has probed the streams already
   int attempts = 10;
+  if (m_pPrefetchedDemuxer)
+  {
+    m_pDemuxer = std::move(m_pPrefetchedDemuxer);
+    attempts = 0;
+  }
+
   while (!m_bStop && attempts-- > 0)
   {
     m_pDemuxer.reset(CDVDFactoryDemuxer::CreateDemuxer(m_pInputStream));
@@ -2503,6 +2532,7 @@ void CVideoPlayer::OnExit()
 
   // destroy objects
   m_pDemuxer.reset();
+  m_pPrefetchedDemuxer.reset();
   m_pSubtitleDemuxer.reset();
   m_subtitleDemuxerMap.clear();
   m_pCCDemuxer.reset();
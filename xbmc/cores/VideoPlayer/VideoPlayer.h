@@ -16,6 +16,7 @@
 #include "VideoPlayerRadioRDS.h"
 #include "VideoPlayerSubtitle.h"
 #include "VideoPlayerTeletext.h"
+#include "VideoPlayerPrefetch.h"
 #include "VideoPlayerVideo.h"
 #include "cores/IPlayer.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
@@ -246,6 +247,7 @@ public:
   ~CVideoPlayer() override;
   bool OpenFile(const CFileItem& file, const CPlayerOptions &options) override;
   bool CloseFile(bool reopen = false) override;
+  void PrefetchNextFile(const CFileItem& file) override;
   bool IsPlaying() const override;
   void Pause() override;
   bool HasVideo() const override;
@@ -502,6 +504,8 @@ protected:
 
   std::shared_ptr<CDVDInputStream> m_pInputStream;
   std::unique_ptr<CDVDDemux> m_pDemuxer;
+  std::unique_ptr<CDVDDemux> m_pPrefetchedDemuxer;
+  CVideoPlayerPrefetch m_prefetch;
   std::shared_ptr<CDVDDemux> m_pSubtitleDemuxer;
   std::unordered_map<int64_t, std::shared_ptr<CDVDDemux>> m_subtitleDemuxerMap;
   std::unique_ptr<CDVDDemuxCC> m_pCCDemuxer;
@@ -14,6 +14,7 @@
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
@@ -127,6 +128,16 @@ void CVideoPlayerAudio::OpenStream(CDVDStreamInfo& hints, std::unique_ptr<CDVDAu
   m_audioClock = 0;
   m_stalled = m_messageQueue.GetPacketCount(CDVDMsg::DEMUXER_PACKET) == 0;
 
+  // audio of the previous stream
+  m_reserve.Flush();
+
+  // only network and live input stall long enough for the reserve to pay off
+  if (m_processInfo.IsNetworkStream() || m_processInfo.IsRealtimeStream())
+    m_reserve.SetMaxTime(DVD_MSEC_TO_TIME(
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioDecodeAheadMs));
+  else
+    m_reserve.SetMaxTime(0.0);
+
   m_prevsynctype = -1;
   m_synctype = SYNC_DISCON;
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_VIDEOPLAYER_USEDISPLAYASCLOCK))
@@ -148,8 +159,16 @@ void CVideoPlayerAudio::CloseStream(bool bWaitForBuffers)
 
   // wait until buffers are empty
   if (bWait)
+  {
     m_messageQueue.WaitUntilEmpty();
 
+    // the thread plays what was decoded ahead once there are no packets left
+    XbmcThreads::EndTime<> timer(1s + std::chrono::milliseconds(static_cast<int>(
+                                          DVD_TIME_TO_MSEC(m_reserve.GetMaxTime()))));
+    while (!m_reserve.IsEmpty() && !timer.IsTimePast())
+      CThread::Sleep(10ms);
+  }
+
   // send abort message to the audio queue
   m_messageQueue.Abort();
 
@@ -199,6 +218,9 @@ void CVideoPlayerAudio::UpdatePlayerInfo()
   if (m_synctype == SYNC_RESAMPLE)
     s << ", rr:" << std::fixed << std::setprecision(5) << 1.0 / m_audioSink.GetResampleRatio();
 
+  if (m_reserve.IsEnabled())
+    s << ", ra:" << std::setw(4) << DVD_TIME_TO_MSEC(m_reserve.GetTime()) << "ms";
+
   SInfo info;
   info.info        = s.str();
   info.pts         = m_audioSink.GetPlayingPts();
@@ -313,6 +335,7 @@ void CVideoPlayerAudio::Process()
     {
       if (m_pAudioCodec)
         m_pAudioCodec->Reset();
+      m_reserve.Flush();
       m_audioSink.Flush();
       m_stalled = true;
       m_audioClock = 0;
@@ -322,6 +345,7 @@ void CVideoPlayerAudio::Process()
     else if (pMsg->IsType(CDVDMsg::GENERAL_FLUSH))
     {
       bool sync = std::static_pointer_cast<CDVDMsgBool>(pMsg)->m_value;
+      m_reserve.Flush();
       m_audioSink.Flush();
       m_stalled = true;
       m_audioClock = 0;
@@ -389,6 +413,7 @@ void CVideoPlayerAudio::Process()
       {
         if (m_syncState != IDVDStreamPlayer::SYNC_STARTING)
         {
+          m_reserve.Flush();
           m_audioSink.Drain();
           m_audioSink.Flush();
           audioframe.nb_frames = 0;
@@ -427,11 +452,17 @@ void CVideoPlayerAudio::Process()
 
 bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
 {
+  if (m_reserve.IsEnabled())
+    FillReserve();
+
   if (audioframe.nb_frames <= audioframe.framesOut)
   {
     audioframe.hasDownmix = false;
 
-    m_pAudioCodec->GetData(audioframe);
+    if (!m_reserve.IsEnabled())
+      m_pAudioCodec->GetData(audioframe);
+    else if (!m_reserve.Get(audioframe))
+      audioframe.nb_frames = 0;
 
     if (audioframe.nb_frames == 0)
     {
@@ -529,6 +560,14 @@ bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
     }
   }
 
+  // rather than wait for the sink, decode the queued packets ahead while there is room,
+  // the reserve then covers for the demuxer when it stalls
+  if (m_reserve.IsEnabled() && !m_reserve.IsFull() &&
+      m_syncState == IDVDStreamPlayer::SYNC_INSYNC &&
+      m_messageQueue.GetPacketCount(CDVDMsg::DEMUXER_PACKET) > 0 &&
+      !m_audioSink.CanAddPackets(audioframe))
+    return false;
+
   int framesOutput = m_audioSink.AddPackets(audioframe);
 
   // guess next pts
@@ -564,6 +603,19 @@ bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
   return true;
 }
 
+void CVideoPlayerAudio::FillReserve()
+{
+  while (!m_reserve.IsFull())
+  {
+    DVDAudioFrame frame{};
+    m_pAudioCodec->GetData(frame);
+    if (frame.nb_frames == 0)
+      break;
+
+    m_reserve.Add(frame);
+  }
+}
+
 void CVideoPlayerAudio::SetSyncType(bool passthrough)
 {
   if (passthrough && m_synctype == SYNC_RESAMPLE)
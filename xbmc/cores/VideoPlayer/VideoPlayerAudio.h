@@ -12,6 +12,7 @@
 #include "DVDClock.h"
 #include "DVDMessageQueue.h"
 #include "DVDStreamInfo.h"
+#include "VideoPlayerAudioReserve.h"
 #include "IVideoPlayer.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "threads/SystemClock.h"
@@ -67,6 +68,8 @@ protected:
   void Process() override;
 
   bool ProcessDecoderOutput(DVDAudioFrame &audioframe);
+  //! Move decoded frames from the codec to the reserve until it is full.
+  void FillReserve();
   void UpdatePlayerInfo();
   void OpenStream(CDVDStreamInfo& hints, std::unique_ptr<CDVDAudioCodec> codec);
   //! Switch codec if needed. Called when the sample rate gotten from the
@@ -85,6 +88,7 @@ protected:
   CAudioSinkAE m_audioSink; // audio output device
   CDVDClock* m_pClock; // dvd master clock
   std::unique_ptr<CDVDAudioCodec> m_pAudioCodec; // audio codec
+  CVideoPlayerAudioReserve m_reserve; // decoded audio ahead of the sink
   BitstreamStats m_audioStats;
 
   int m_speed;
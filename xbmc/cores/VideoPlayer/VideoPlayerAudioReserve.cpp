@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlayerAudioReserve.h"
+
+#include <algorithm>
+#include <cstring>
+
+void CVideoPlayerAudioReserve::Add(const DVDAudioFrame& frame)
+{
+  std::unique_ptr<Entry> entry;
+  if (m_free.empty())
+    entry.reset(new Entry);
+  else
+  {
+    entry = std::move(m_free.back());
+    m_free.pop_back();
+  }
+
+  // passthrough frames count bytes and don't set a frame size
+  size_t planeSize = frame.nb_frames;
+  if (!frame.passthrough)
+    planeSize = frame.planes ? planeSize * frame.framesize / frame.planes : 0;
+  if (entry->buffer.size() < planeSize * frame.planes)
+    entry->buffer.resize(planeSize * frame.planes);
+
+  entry->frame = frame;
+  for (unsigned int i = 0; i < frame.planes; i++)
+  {
+    entry->frame.data[i] = entry->buffer.data() + i * planeSize;
+    std::memcpy(entry->frame.data[i], frame.data[i], planeSize);
+  }
+  entry->frame.framesOut = 0;
+
+  m_time = m_time + frame.duration;
+  m_frames.push_back(std::move(entry));
+  m_count++;
+}
+
+bool CVideoPlayerAudioReserve::Get(DVDAudioFrame& frame)
+{
+  if (m_current)
+    m_free.push_back(std::move(m_current));
+
+  if (m_frames.empty())
+    return false;
+
+  m_current = std::move(m_frames.front());
+  m_frames.pop_front();
+  m_count--;
+  m_time = std::max(m_time - m_current->frame.duration, 0.0);
+
+  frame = m_current->frame;
+  return true;
+}
+
+void CVideoPlayerAudioReserve::Flush()
+{
+  for (auto& entry : m_frames)
+    m_free.push_back(std::move(entry));
+  m_frames.clear();
+  m_count = 0;
+  m_time = 0.0;
+}
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DVDCodecs/Audio/DVDAudioCodec.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+/*!
+ * \brief Decoded audio kept between the audio codec and the audio sink.
+ *
+ * The audio player decodes ahead into the reserve while packets are queued and the sink
+ * is full, and plays from it when the demuxer stalls, so short network stalls don't
+ * starve the sink. Frames keep their timestamps and are handed out in decode order, the
+ * sample buffers are pooled and only grow.
+ */
+class CVideoPlayerAudioReserve
+{
+public:
+  CVideoPlayerAudioReserve() = default;
+
+  /*!
+   * \brief Duration of audio to decode ahead, 0 disables the reserve.
+   * \param time in DVD_TIME_BASE units
+   */
+  void SetMaxTime(double time) { m_maxTime = time; }
+  double GetMaxTime() const { return m_maxTime; }
+  bool IsEnabled() const { return m_maxTime > 0; }
+  bool IsFull() const { return m_time >= m_maxTime; }
+
+  //! true if no frame is waiting to be handed out, safe to call from any thread
+  bool IsEmpty() const { return m_count == 0; }
+
+  //! duration of the frames waiting, in DVD_TIME_BASE units, safe to call from any thread
+  double GetTime() const { return m_time; }
+
+  /*!
+   * \brief Copy a frame the codec returned.
+   */
+  void Add(const DVDAudioFrame& frame);
+
+  /*!
+   * \brief Hand out the oldest frame, its data stays valid until the next call.
+   * \return false if there was no frame
+   */
+  bool Get(DVDAudioFrame& frame);
+
+  /*!
+   * \brief Drop all waiting frames, the frame handed out last stays valid.
+   */
+  void Flush();
+
+private:
+  struct Entry
+  {
+    DVDAudioFrame frame;
+    std::vector<uint8_t> buffer;
+  };
+
+  std::deque<std::unique_ptr<Entry>> m_frames;
+  std::vector<std::unique_ptr<Entry>> m_free;
+  std::unique_ptr<Entry> m_current; //!< handed out last
+  std::atomic<double> m_maxTime{0.0};
+  std::atomic<double> m_time{0.0}; //!< only changed by the audio thread
+  std::atomic<unsigned int> m_count{0};
+};
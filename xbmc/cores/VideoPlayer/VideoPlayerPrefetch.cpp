@@ -0,0 +1,175 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlayerPrefetch.h"
+
+#include "DVDDemuxers/DVDDemux.h"
+#include "DVDDemuxers/DVDFactoryDemuxer.h"
+#include "DVDInputStreams/DVDFactoryInputStream.h"
+#include "DVDInputStreams/DVDInputStream.h"
+#include "FileItem.h"
+#include "URL.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// a prefetch still running when the player wants the file is waited for at most this
+// long, after that the player opens the file on its own
+constexpr auto TAKE_TIMEOUT = 10s;
+} // namespace
+
+class CVideoPlayerPrefetch::CState
+{
+public:
+  explicit CState(const CFileItem& item) : m_item(item), m_path(item.GetDynPath()) {}
+
+  void Open()
+  {
+    auto start = std::chrono::steady_clock::now();
+    const std::string redactPath = CURL::GetRedacted(m_path);
+
+    std::shared_ptr<CDVDInputStream> input =
+        CDVDFactoryInputStream::CreateInputStream(nullptr, m_item, true);
+    if (!input || !input->IsStreamType(DVDSTREAM_TYPE_FILE))
+    {
+      CLog::Log(LOGDEBUG, "CVideoPlayerPrefetch: not prefetching {}", redactPath);
+      m_done.Set();
+      return;
+    }
+
+    {
+      CSingleLock lock(m_section);
+      if (m_aborted)
+      {
+        m_done.Set();
+        return;
+      }
+      m_input = input;
+    }
+
+    std::unique_ptr<CDVDDemux> demuxer;
+    if (input->Open() && !input->IsRealtime())
+      demuxer.reset(CDVDFactoryDemuxer::CreateDemuxer(input));
+
+    CSingleLock lock(m_section);
+    if (!demuxer || m_aborted)
+    {
+      m_input.reset();
+      m_done.Set();
+      return;
+    }
+    m_demuxer = std::move(demuxer);
+    m_done.Set();
+
+    CLog::Log(LOGDEBUG, "CVideoPlayerPrefetch: {} ready after {} ms", redactPath,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count());
+  }
+
+  void Abort()
+  {
+    CSingleLock lock(m_section);
+    m_aborted = true;
+    if (m_input && !m_demuxer)
+      m_input->Abort();
+    m_demuxer.reset();
+    m_input.reset();
+  }
+
+  bool Take(std::shared_ptr<CDVDInputStream>& input, std::unique_ptr<CDVDDemux>& demuxer)
+  {
+    if (!m_done.Wait(TAKE_TIMEOUT))
+    {
+      Abort();
+      return false;
+    }
+
+    CSingleLock lock(m_section);
+    if (!m_demuxer)
+      return false;
+
+    input = std::move(m_input);
+    demuxer = std::move(m_demuxer);
+    return true;
+  }
+
+  const std::string& GetPath() const { return m_path; }
+
+private:
+  const CFileItem m_item;
+  const std::string m_path;
+
+  CCriticalSection m_section;
+  CEvent m_done{true};
+  bool m_aborted = false;
+  std::shared_ptr<CDVDInputStream> m_input;
+  std::unique_ptr<CDVDDemux> m_demuxer;
+};
+
+CVideoPlayerPrefetch::~CVideoPlayerPrefetch()
+{
+  Clear();
+}
+
+void CVideoPlayerPrefetch::Prefetch(const CFileItem& item)
+{
+  CSingleLock lock(m_section);
+  if (m_state && m_state->GetPath() == item.GetDynPath())
+    return;
+
+  if (m_state)
+    m_state->Abort();
+
+  CLog::Log(LOGDEBUG, "CVideoPlayerPrefetch: prefetching {}", CURL::GetRedacted(item.GetDynPath()));
+
+  auto state = std::make_shared<CState>(item);
+  m_state = state;
+  CJobManager::GetInstance().Submit([state]() { state->Open(); }, CJob::PRIORITY_NORMAL);
+}
+
+bool CVideoPlayerPrefetch::Take(const CFileItem& item,
+                                std::shared_ptr<CDVDInputStream>& input,
+                                std::unique_ptr<CDVDDemux>& demuxer)
+{
+  std::shared_ptr<CState> state;
+  {
+    CSingleLock lock(m_section);
+    state = std::move(m_state);
+  }
+
+  if (!state)
+    return false;
+
+  if (state->GetPath() != item.GetDynPath())
+  {
+    state->Abort();
+    return false;
+  }
+
+  return state->Take(input, demuxer);
+}
+
+void CVideoPlayerPrefetch::Clear()
+{
+  std::shared_ptr<CState> state;
+  {
+    CSingleLock lock(m_section);
+    state = std::move(m_state);
+  }
+
+  if (state)
+    state->Abort();
+}
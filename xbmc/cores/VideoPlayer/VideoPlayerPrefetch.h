@@ -0,0 +1,60 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <memory>
+#include <string>
+
+class CDVDDemux;
+class CDVDInputStream;
+class CFileItem;
+
+/*!
+ * \brief Opens the input stream and demuxer of the item that will be played next.
+ *
+ * Opening a file over the network and probing its streams takes seconds, which shows as
+ * a black gap between playlist items or stack parts. The application hints the next item
+ * shortly before the current one ends, the prefetch opens it in the background, and
+ * CVideoPlayer takes the ready input stream and demuxer instead of opening them again.
+ * Only plain file input streams are prefetched, stateful inputs (discs, PVR, addons) are
+ * always opened by the player itself.
+ */
+class CVideoPlayerPrefetch
+{
+public:
+  CVideoPlayerPrefetch() = default;
+  ~CVideoPlayerPrefetch();
+
+  /*!
+   * \brief Start opening item in the background, replaces any previous prefetch.
+   */
+  void Prefetch(const CFileItem& item);
+
+  /*!
+   * \brief Hand over the prefetched input stream and demuxer if they belong to item.
+   *        Waits for a prefetch of item that is still in progress.
+   * \return true if both input and demuxer were taken over
+   */
+  bool Take(const CFileItem& item,
+            std::shared_ptr<CDVDInputStream>& input,
+            std::unique_ptr<CDVDDemux>& demuxer);
+
+  /*!
+   * \brief Abort and drop any prefetch.
+   */
+  void Clear();
+
+private:
+  class CState;
+
+  CCriticalSection m_section;
+  std::shared_ptr<CState> m_state;
+};
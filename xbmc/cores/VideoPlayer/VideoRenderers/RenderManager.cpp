@@ -15,6 +15,7 @@
 #include "ServiceBroker.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "messaging/ApplicationMessenger.h"
+#include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/MediaSettings.h"
 #include "settings/Settings.h"
@@ -700,6 +701,9 @@ RESOLUTION CRenderManager::GetResolution()
 
 void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
 {
+  // gui textures queued so far are below the video
+  CServiceBroker::GetRenderSystem()->FlushGUIBatch();
+
   CSingleExit exitLock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   {
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDClock.h"
+#include "cores/VideoPlayer/VideoPlayerAudioReserve.h"
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+DVDAudioFrame MakePCMFrame(std::vector<uint8_t> (&planes)[2], unsigned int count)
+{
+  DVDAudioFrame frame{};
+  frame.nb_frames = 256;
+  frame.planes = count;
+  // two channels of 16 bit samples, split over the planes
+  frame.framesize = 4;
+  frame.bits_per_sample = 16;
+  frame.duration = DVD_MSEC_TO_TIME(5);
+  frame.pts = DVD_MSEC_TO_TIME(100);
+  for (unsigned int i = 0; i < count; i++)
+  {
+    planes[i].resize(frame.nb_frames * frame.framesize / count);
+    for (size_t j = 0; j < planes[i].size(); j++)
+      planes[i][j] = static_cast<uint8_t>(j + i * 7);
+    frame.data[i] = planes[i].data();
+  }
+  return frame;
+}
+} // namespace
+
+TEST(TestVideoPlayerAudioReserve, Disabled)
+{
+  CVideoPlayerAudioReserve reserve;
+  EXPECT_FALSE(reserve.IsEnabled());
+  EXPECT_TRUE(reserve.IsEmpty());
+
+  DVDAudioFrame frame;
+  EXPECT_FALSE(reserve.Get(frame));
+}
+
+TEST(TestVideoPlayerAudioReserve, PCMPacked)
+{
+  CVideoPlayerAudioReserve reserve;
+  reserve.SetMaxTime(DVD_MSEC_TO_TIME(10));
+
+  std::vector<uint8_t> planes[2];
+  DVDAudioFrame frame = MakePCMFrame(planes, 1);
+  frame.framesOut = 12;
+  reserve.Add(frame);
+  EXPECT_FALSE(reserve.IsEmpty());
+  EXPECT_FALSE(reserve.IsFull());
+  EXPECT_DOUBLE_EQ(reserve.GetTime(), frame.duration);
+
+  // the reserve owns a copy
+  std::vector<uint8_t> expected = planes[0];
+  std::memset(planes[0].data(), 0, planes[0].size());
+
+  DVDAudioFrame out;
+  ASSERT_TRUE(reserve.Get(out));
+  EXPECT_TRUE(reserve.IsEmpty());
+  EXPECT_DOUBLE_EQ(reserve.GetTime(), 0.0);
+  EXPECT_EQ(out.nb_frames, frame.nb_frames);
+  EXPECT_EQ(out.framesOut, 0u);
+  EXPECT_DOUBLE_EQ(out.pts, frame.pts);
+  EXPECT_NE(out.data[0], planes[0].data());
+  EXPECT_EQ(std::memcmp(out.data[0], expected.data(), expected.size()), 0);
+}
+
+TEST(TestVideoPlayerAudioReserve, PCMPlanar)
+{
+  CVideoPlayerAudioReserve reserve;
+  reserve.SetMaxTime(DVD_MSEC_TO_TIME(10));
+
+  std::vector<uint8_t> planes[2];
+  DVDAudioFrame frame = MakePCMFrame(planes, 2);
+  reserve.Add(frame);
+  reserve.Add(frame);
+  EXPECT_TRUE(reserve.IsFull());
+
+  for (int n = 0; n < 2; n++)
+  {
+    DVDAudioFrame out;
+    ASSERT_TRUE(reserve.Get(out));
+    ASSERT_EQ(out.planes, 2u);
+    for (unsigned int i = 0; i < out.planes; i++)
+    {
+      EXPECT_NE(out.data[i], planes[i].data());
+      EXPECT_EQ(std::memcmp(out.data[i], planes[i].data(), planes[i].size()), 0);
+    }
+  }
+  EXPECT_TRUE(reserve.IsEmpty());
+}
+
+TEST(TestVideoPlayerAudioReserve, Passthrough)
+{
+  CVideoPlayerAudioReserve reserve;
+  reserve.SetMaxTime(DVD_MSEC_TO_TIME(100));
+
+  // what the passthrough codec hands out, nb_frames is the size in bytes
+  std::vector<uint8_t> packet(6144);
+  for (size_t i = 0; i < packet.size(); i++)
+    packet[i] = static_cast<uint8_t>(i * 13);
+
+  DVDAudioFrame frame{};
+  frame.passthrough = true;
+  frame.nb_frames = static_cast<unsigned int>(packet.size());
+  frame.planes = 1;
+  frame.bits_per_sample = 8;
+  frame.duration = DVD_MSEC_TO_TIME(32);
+  frame.data[0] = packet.data();
+  reserve.Add(frame);
+
+  DVDAudioFrame out;
+  ASSERT_TRUE(reserve.Get(out));
+  EXPECT_TRUE(out.passthrough);
+  EXPECT_EQ(out.nb_frames, frame.nb_frames);
+  EXPECT_NE(out.data[0], packet.data());
+  EXPECT_EQ(std::memcmp(out.data[0], packet.data(), packet.size()), 0);
+}
+
+TEST(TestVideoPlayerAudioReserve, Flush)
+{
+  CVideoPlayerAudioReserve reserve;
+  reserve.SetMaxTime(DVD_MSEC_TO_TIME(100));
+
+  std::vector<uint8_t> planes[2];
+  DVDAudioFrame frame = MakePCMFrame(planes, 1);
+  reserve.Add(frame);
+  reserve.Add(frame);
+
+  DVDAudioFrame out;
+  ASSERT_TRUE(reserve.Get(out));
+  reserve.Flush();
+  EXPECT_TRUE(reserve.IsEmpty());
+  EXPECT_DOUBLE_EQ(reserve.GetTime(), 0.0);
+
+  // the frame handed out last is still valid
+  EXPECT_EQ(std::memcmp(out.data[0], planes[0].data(), planes[0].size()), 0);
+  EXPECT_FALSE(reserve.Get(out));
+}
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/SliceScaler.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <libswscale/swscale.h>
+}
+
+namespace
+{
+class CImage
+{
+public:
+  CImage(int rowBytes, int height) : m_rowBytes(rowBytes), m_height(height)
+  {
+    m_stride = CSliceScaler::GetAlignedStride(rowBytes);
+    m_data = CSliceScaler::AllocBuffer(m_stride, height);
+  }
+  ~CImage() { CSliceScaler::FreeBuffer(m_data); }
+
+  uint8_t* Row(int y) const { return m_data + static_cast<ptrdiff_t>(y) * m_stride; }
+  int Stride() const { return m_stride; }
+
+  // gradients with hard edges every few rows, so a seam between bands would show
+  void Fill()
+  {
+    for (int y = 0; y < m_height; y++)
+      for (int x = 0; x < m_rowBytes; x++)
+        Row(y)[x] = static_cast<uint8_t>((x * 3 + y * 7) ^ ((y / 5) % 2 ? 0xff : 0));
+  }
+
+  int MaxDiff(const CImage& other) const
+  {
+    int maxDiff = 0;
+    for (int y = 0; y < m_height; y++)
+      for (int x = 0; x < m_rowBytes; x++)
+        maxDiff = std::max(maxDiff, std::abs(Row(y)[x] - other.Row(y)[x]));
+    return maxDiff;
+  }
+
+private:
+  int m_rowBytes;
+  int m_height;
+  int m_stride;
+  uint8_t* m_data;
+};
+
+constexpr unsigned int SLICES = 4;
+} // namespace
+
+TEST(TestSliceScaler, BandedYUVDownscaleMatchesSingle)
+{
+  constexpr int srcWidth = 1920;
+  constexpr int srcHeight = 1080;
+  constexpr int dstWidth = 480;
+  constexpr int dstHeight = 270;
+
+  CImage y(srcWidth, srcHeight);
+  CImage u(srcWidth / 2, srcHeight / 2);
+  CImage v(srcWidth / 2, srcHeight / 2);
+  y.Fill();
+  u.Fill();
+  v.Fill();
+  const uint8_t* src[] = {y.Row(0), u.Row(0), v.Row(0), nullptr};
+  const int srcStride[] = {y.Stride(), u.Stride(), v.Stride(), 0};
+
+  CImage single(dstWidth * 4, dstHeight);
+  CImage banded(dstWidth * 4, dstHeight);
+  uint8_t* singleDst[] = {single.Row(0), nullptr, nullptr, nullptr};
+  uint8_t* bandedDst[] = {banded.Row(0), nullptr, nullptr, nullptr};
+  const int dstStride[] = {single.Stride(), 0, 0, 0};
+
+  ASSERT_TRUE(CSliceScaler::Scale(srcWidth, srcHeight, AV_PIX_FMT_YUV420P, src, srcStride,
+                                  dstWidth, dstHeight, AV_PIX_FMT_BGRA, singleDst, dstStride,
+                                  SWS_BICUBIC, 1));
+  ASSERT_TRUE(CSliceScaler::Scale(srcWidth, srcHeight, AV_PIX_FMT_YUV420P, src, srcStride,
+                                  dstWidth, dstHeight, AV_PIX_FMT_BGRA, bandedDst, dstStride,
+                                  SWS_BICUBIC, SLICES));
+
+  // at most a rounding step apart, a seam would be off by far more
+  EXPECT_LE(banded.MaxDiff(single), 1);
+}
+
+TEST(TestSliceScaler, BandedRGBDownscaleMatchesSingle)
+{
+  constexpr int srcWidth = 1600;
+  constexpr int srcHeight = 1200;
+  constexpr int dstWidth = 720;
+  constexpr int dstHeight = 540;
+
+  CImage image(srcWidth * 4, srcHeight);
+  image.Fill();
+  const uint8_t* src[] = {image.Row(0), nullptr, nullptr, nullptr};
+  const int srcStride[] = {image.Stride(), 0, 0, 0};
+
+  CImage single(dstWidth * 4, dstHeight);
+  CImage banded(dstWidth * 4, dstHeight);
+  uint8_t* singleDst[] = {single.Row(0), nullptr, nullptr, nullptr};
+  uint8_t* bandedDst[] = {banded.Row(0), nullptr, nullptr, nullptr};
+  const int dstStride[] = {single.Stride(), 0, 0, 0};
+
+  ASSERT_TRUE(CSliceScaler::Scale(srcWidth, srcHeight, AV_PIX_FMT_BGRA, src, srcStride, dstWidth,
+                                  dstHeight, AV_PIX_FMT_BGRA, singleDst, dstStride, SWS_LANCZOS,
+                                  1));
+  ASSERT_TRUE(CSliceScaler::Scale(srcWidth, srcHeight, AV_PIX_FMT_BGRA, src, srcStride, dstWidth,
+                                  dstHeight, AV_PIX_FMT_BGRA, bandedDst, dstStride, SWS_LANCZOS,
+                                  SLICES));
+
+  EXPECT_LE(banded.MaxDiff(single), 1);
+}
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxKeyframeIndex.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestDemuxKeyframeIndex, LookupContiguous)
+{
+  CDemuxKeyframeIndex index;
+  index.Add(0, 0);
+  index.Add(1000, 5000);
+  index.Add(2000, 9000);
+
+  CDemuxKeyframeIndex::Entry entry;
+  EXPECT_TRUE(index.Lookup(1500, true, entry));
+  EXPECT_EQ(entry.time, 1000);
+  EXPECT_EQ(entry.pos, 5000);
+
+  EXPECT_TRUE(index.Lookup(1500, false, entry));
+  EXPECT_EQ(entry.time, 2000);
+
+  EXPECT_TRUE(index.Lookup(2000, true, entry));
+  EXPECT_EQ(entry.pos, 9000);
+
+  // nothing is known beyond the last keyframe
+  EXPECT_FALSE(index.Lookup(2500, true, entry));
+}
+
+TEST(TestDemuxKeyframeIndex, DiscontinuityLeavesGap)
+{
+  CDemuxKeyframeIndex index;
+  index.Add(0, 0);
+  index.Add(1000, 5000);
+  index.Discontinuity();
+  index.Add(10000, 50000);
+  index.Add(11000, 55000);
+
+  CDemuxKeyframeIndex::Entry entry;
+  // there may be unseen keyframes between 1000 and 10000
+  EXPECT_FALSE(index.Lookup(5000, true, entry));
+  EXPECT_FALSE(index.Lookup(5000, false, entry));
+  EXPECT_TRUE(index.Lookup(10500, true, entry));
+  EXPECT_EQ(entry.time, 10000);
+
+  // reading the gap later on closes it
+  index.Discontinuity();
+  index.Add(1000, 5000);
+  index.Add(2000, 9000);
+  EXPECT_TRUE(index.Lookup(1500, true, entry));
+  EXPECT_EQ(entry.time, 1000);
+  EXPECT_FALSE(index.Lookup(5000, true, entry));
+}
+
+TEST(TestDemuxKeyframeIndex, InsertBreaksAdjacency)
+{
+  CDemuxKeyframeIndex index;
+  index.Add(0, 0);
+  index.Add(2000, 9000);
+  index.Discontinuity();
+  index.Add(1000, 5000);
+
+  CDemuxKeyframeIndex::Entry entry;
+  // 2000 was marked as following 0, which was wrong
+  EXPECT_FALSE(index.Lookup(1500, true, entry));
+  EXPECT_EQ(index.Size(), 3u);
+}
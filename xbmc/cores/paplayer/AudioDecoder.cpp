@@ -18,6 +18,7 @@
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <math.h>
 
 CAudioDecoder::CAudioDecoder()
@@ -49,6 +50,9 @@ void CAudioDecoder::Destroy()
   m_status = STATUS_NO_FILE;
 
   m_pcmBuffer.Destroy();
+  m_delayBytes = 0;
+  m_paddingBytes = 0;
+  m_skipBytes = 0;
 
   if ( m_codec )
     delete m_codec;
@@ -57,7 +61,10 @@ void CAudioDecoder::Destroy()
   m_canPlay = false;
 }
 
-bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
+bool CAudioDecoder::Create(const CFileItem& file,
+                           int64_t seekOffset,
+                           unsigned int lookAheadTime,
+                           unsigned int maxLookAheadSize)
 {
   Destroy();
 
@@ -95,8 +102,35 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
     return false;
   }
 
-  /* allocate the pcmBuffer for 2 seconds of audio */
-  m_pcmBuffer.Create(2 * blockSize * m_codec->m_format.m_sampleRate);
+  /* allocate the pcmBuffer for 2 seconds of audio, or more when decoding ahead */
+  const uint64_t defaultSize = 2ULL * blockSize * m_codec->m_format.m_sampleRate;
+  uint64_t bufferSize = static_cast<uint64_t>(lookAheadTime) * blockSize *
+                        m_codec->m_format.m_sampleRate / 1000;
+  if (maxLookAheadSize)
+    bufferSize = std::min<uint64_t>(bufferSize, maxLookAheadSize);
+  bufferSize = std::max(bufferSize - bufferSize % blockSize, defaultSize);
+  m_pcmBuffer.Create(static_cast<unsigned int>(bufferSize));
+
+  // playback may start after the first 2 seconds, the rest keeps filling meanwhile
+  m_queuedSize = static_cast<unsigned int>(defaultSize * 9 / 10);
+
+  if (m_codec->m_format.m_dataFormat != AE_FMT_RAW && !m_codec->HandlesGapless())
+  {
+    int delay = m_codec->m_tag.GetEncoderDelay();
+    int padding = m_codec->m_tag.GetEncoderPadding();
+    if (!delay && !padding && file.HasMusicInfoTag())
+    {
+      delay = file.GetMusicInfoTag()->GetEncoderDelay();
+      padding = file.GetMusicInfoTag()->GetEncoderPadding();
+    }
+    // padding is held back until EOF, it must not take up the buffer
+    m_delayBytes = delay * blockSize;
+    m_paddingBytes = std::min(padding * blockSize, m_pcmBuffer.getSize() / 2);
+    m_paddingBytes -= m_paddingBytes % blockSize;
+    if (delay || padding)
+      CLog::Log(LOGDEBUG, "CAudioDecoder: Trimming {} frames encoder delay and {} frames padding",
+                delay, padding);
+  }
 
   if (file.HasMusicInfoTag())
   {
@@ -125,6 +159,7 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
 
   if (seekOffset)
     m_codec->Seek(seekOffset);
+  m_skipBytes = seekOffset ? 0 : m_delayBytes;
 
   m_status = STATUS_QUEUING;
 
@@ -149,6 +184,7 @@ int64_t CAudioDecoder::Seek(int64_t time)
     return 0;
   if (time < 0) time = 0;
   if (time > m_codec->m_TotalTime) time = m_codec->m_TotalTime;
+  m_skipBytes = time ? 0 : m_delayBytes;
   return m_codec->Seek(time);
 }
 
@@ -165,6 +201,13 @@ int64_t CAudioDecoder::TotalTime()
   return 0;
 }
 
+unsigned int CAudioDecoder::GetReadSize()
+{
+  // the encoder padding at the end of the stream is never handed out
+  unsigned int size = m_pcmBuffer.getMaxReadSize();
+  return size > m_paddingBytes ? size - m_paddingBytes : 0;
+}
+
 unsigned int CAudioDecoder::GetDataSize(bool checkPktSize)
 {
   if (m_status == STATUS_QUEUING || m_status == STATUS_NO_FILE)
@@ -175,12 +218,12 @@ unsigned int CAudioDecoder::GetDataSize(bool checkPktSize)
     // check for end of file and end of buffer
     if (m_status == STATUS_ENDING)
     {
-      if (m_pcmBuffer.getMaxReadSize() == 0)
+      if (GetReadSize() == 0)
         m_status = STATUS_ENDED;
-      else if (checkPktSize && m_pcmBuffer.getMaxReadSize() < PACKET_SIZE)
+      else if (checkPktSize && GetReadSize() < PACKET_SIZE)
         m_status = STATUS_ENDED;
     }
-    return std::min(m_pcmBuffer.getMaxReadSize() / (m_codec->m_bitsPerSample >> 3), (unsigned int)OUTPUT_SAMPLES);
+    return std::min(GetReadSize() / (m_codec->m_bitsPerSample >> 3), (unsigned int)OUTPUT_SAMPLES);
   }
   else
   {
@@ -199,18 +242,18 @@ void *CAudioDecoder::GetData(unsigned int samples)
     return NULL;
   }
 
-  if (size > m_pcmBuffer.getMaxReadSize())
+  if (size > GetReadSize())
   {
     CLog::Log(
         LOGWARNING,
         "CAudioDecoder::GetData() more bytes/samples ({}) requested than we have to give ({})!",
-        size, m_pcmBuffer.getMaxReadSize());
-    size = m_pcmBuffer.getMaxReadSize();
+        size, GetReadSize());
+    size = GetReadSize();
   }
 
   if (m_pcmBuffer.ReadData((char *)m_outputBuffer, size))
   {
-    if (m_status == STATUS_ENDING && m_pcmBuffer.getMaxReadSize() == 0)
+    if (m_status == STATUS_ENDING && GetReadSize() == 0)
       m_status = STATUS_ENDED;
 
     return m_outputBuffer;
@@ -261,11 +304,16 @@ int CAudioDecoder::ReadSamples(int numsamples)
 
       if (result != READ_ERROR && readSize)
       {
+        // drop the encoder delay at the start of the stream
+        size_t skip = std::min<size_t>(m_skipBytes, readSize);
+        m_skipBytes -= skip;
+
         // move it into our buffer
-        m_pcmBuffer.WriteData((char *)m_pcmInputBuffer, readSize);
+        if (readSize > skip)
+          m_pcmBuffer.WriteData((char*)m_pcmInputBuffer + skip, readSize - skip);
 
         // update status
-        if (m_status == STATUS_QUEUING && m_pcmBuffer.getMaxReadSize() > m_pcmBuffer.getSize() * 0.9)
+        if (m_status == STATUS_QUEUING && m_pcmBuffer.getMaxReadSize() > m_queuedSize)
         {
           CLog::Log(LOGINFO, "AudioDecoder: File is queued");
           m_status = STATUS_QUEUED;
@@ -43,7 +43,14 @@ public:
   CAudioDecoder();
   ~CAudioDecoder();
 
-  bool Create(const CFileItem &file, int64_t seekOffset);
+  /*! \brief Open the codec of a file
+   \param lookAheadTime ms of audio to buffer, 0 for the default of 2 seconds
+   \param maxLookAheadSize upper limit of the buffer in bytes, 0 for none
+   */
+  bool Create(const CFileItem& file,
+              int64_t seekOffset,
+              unsigned int lookAheadTime = 0,
+              unsigned int maxLookAheadSize = 0);
   void Destroy();
 
   int ReadSamples(int numsamples);
@@ -72,8 +79,11 @@ public:
   float GetReplayGain(float &peakVal);
 
 private:
+  unsigned int GetReadSize();
+
   // pcm buffer
   CRingBuffer m_pcmBuffer;
+  unsigned int m_queuedSize = 0; // buffered bytes needed to start playing
 
   // output buffer (for transferring data from the Pcm Buffer to the rest of the audio chain)
   float m_outputBuffer[OUTPUT_SAMPLES];
@@ -85,6 +95,11 @@ private:
   uint8_t *m_rawBuffer;
   int m_rawBufferSize;
 
+  // gapless, in bytes of the pcm buffer
+  unsigned int m_delayBytes = 0;
+  unsigned int m_paddingBytes = 0;
+  unsigned int m_skipBytes = 0;
+
   // status
   bool m_eof;
   int m_status;
@@ -70,6 +70,11 @@ public:
   virtual bool IsCaching()    const    {return false;}
   virtual int GetCacheLevel() const    {return -1;}
 
+  // HandlesGapless()
+  // Should return true if the codec removes encoder delay and padding itself.
+  // Otherwise they are trimmed by the decoder according to the tag.
+  virtual bool HandlesGapless() const { return false; }
+
   int64_t m_TotalTime;  // time in ms
   int m_bitRate;
   int m_bitsPerSample;
@@ -27,6 +27,8 @@
 #include "utils/log.h"
 #include "video/Bookmark.h"
 
+#include <algorithm>
+
 using namespace KODI::MESSAGING;
 using namespace std::chrono_literals;
 
@@ -164,6 +166,8 @@ void PAPlayer::SoftStop(bool wait/* = false */, bool close/* = true */)
 
 void PAPlayer::CloseAllStreams(bool fade/* = true */)
 {
+  m_closeCounter++;
+
   if (!fade)
   {
     CSingleLock lock(m_streamsLock);
@@ -211,6 +215,18 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   m_defaultCrossfadeMS = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_MUSICPLAYER_CROSSFADE) * 1000;
   m_fullScreen = options.fullscreen;
 
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  m_lookAheadMS = advancedSettings->m_audioLookAheadSeconds * 1000;
+  m_lookAheadMaxSize = advancedSettings->m_audioLookAheadMaxSize * 1024 * 1024;
+
+  {
+    // a track queued ahead of the one opened now is of no use anymore, even if the current
+    // stream is kept to crossfade from
+    CSingleLock lock(m_streamsLock);
+    m_closeCounter++;
+  }
+
   if (m_streams.size() > 1 || !m_defaultCrossfadeMS || m_isPaused)
   {
     CloseAllStreams(!m_isPaused);
@@ -313,9 +329,30 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     m_currentStream->m_nextFileItem.reset();
   }
 
+  // decode ahead when queued during playback of another track, not for track skips. Leave
+  // TIME_TO_CACHE_NEXT_FILE for preparing the stream before the current one runs out.
+  unsigned int lookAheadTime = 0;
+  const int closeCounter = m_closeCounter;
+  if (fadeIn && m_lookAheadMS && !file.IsCDDA())
+  {
+    CSingleLock lock(m_streamsLock);
+    const StreamInfo* current = m_currentStream;
+    if (current && current->m_audioFormat.m_sampleRate)
+    {
+      int64_t remaining = current->m_decoderTotal;
+      if (current->m_endOffset)
+        remaining = current->m_endOffset - current->m_startOffset;
+      remaining -= static_cast<int64_t>(current->m_framesSent) * 1000 /
+                   current->m_audioFormat.m_sampleRate;
+      remaining -= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS;
+      lookAheadTime = static_cast<unsigned int>(std::clamp<int64_t>(remaining, 0, m_lookAheadMS));
+    }
+  }
+
   StreamInfo *si = new StreamInfo();
   si->m_fileItem = file;
-  if (!si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset))
+  if (!si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset, lookAheadTime,
+                            m_lookAheadMaxSize))
   {
     CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
 
@@ -380,10 +417,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   si->m_prepareNextAtFrame = 0;
   // cd drives don't really like it to be crossfaded or prepared
   if(!file.IsCDDA())
-  {
-    if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-      si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
-  }
+    si->m_prepareNextAtFrame = GetPrepareNextAtFrame(streamTotalTime, si->m_audioFormat.m_sampleRate);
 
   if (m_currentStream && ((m_currentStream->m_audioFormat.m_dataFormat == AE_FMT_RAW) || (si->m_audioFormat.m_dataFormat == AE_FMT_RAW)))
   {
@@ -412,8 +446,29 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     return false;
   }
 
+  /* decode ahead from this job so that slow sources can't stall the transition */
+  if (lookAheadTime)
+  {
+    XbmcThreads::EndTime<> timer{std::chrono::milliseconds(lookAheadTime)};
+    while (closeCounter == m_closeCounter && !timer.IsTimePast())
+    {
+      // sleeps once the buffer is full or at EOF
+      if (si->m_decoder.ReadSamples(PACKET_SIZE) != RET_SUCCESS)
+        break;
+    }
+  }
+
   /* add the stream to the list */
   CSingleLock lock(m_streamsLock);
+  if (closeCounter != m_closeCounter)
+  {
+    // the streams were closed or another file was opened meanwhile
+    CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - Playback moved on, dropping the stream");
+    si->m_stream.reset();
+    si->m_decoder.Destroy();
+    delete si;
+    return false;
+  }
   m_streams.push_back(si);
   //update the current stream to start playing the next track at the correct frame.
   UpdateStreamInfoPlayNextAtFrame(m_currentStream, m_upcomingCrossfadeMS);
@@ -436,6 +491,17 @@ void PAPlayer::UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int cros
   }
 }
 
+int PAPlayer::GetPrepareNextAtFrame(int64_t streamTotalTime, unsigned int sampleRate) const
+{
+  if (streamTotalTime < TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
+    return 0;
+
+  // queue the next file early enough to decode ahead, but not before the first frame
+  int64_t prepareAt =
+      streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_lookAheadMS - m_defaultCrossfadeMS;
+  return std::max(1, static_cast<int>(std::max<int64_t>(prepareAt, 0) * sampleRate / 1000));
+}
+
 inline bool PAPlayer::PrepareStream(StreamInfo *si)
 {
   /* if we have a stream we are already prepared */
@@ -783,9 +849,8 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
         streamTotalTime = si->m_endOffset - si->m_startOffset;
 
       // calculate time when to prepare next stream
-      si->m_prepareNextAtFrame = 0;
-      if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-        si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+      si->m_prepareNextAtFrame =
+          GetPrepareNextAtFrame(streamTotalTime, si->m_audioFormat.m_sampleRate);
 
       si->m_prepareTriggered = false;
       si->m_playNextAtFrame = 0;
@@ -121,6 +121,9 @@ private:
   bool m_fullScreen;
   unsigned int        m_defaultCrossfadeMS;  /* how long the default crossfade is in ms */
   unsigned int        m_upcomingCrossfadeMS; /* how long the upcoming crossfade is in ms */
+  unsigned int m_lookAheadMS = 0; /* how much of the next track is decoded ahead in ms */
+  unsigned int m_lookAheadMaxSize = 0; /* memory limit of the look ahead in bytes */
+  std::atomic_int m_closeCounter{0}; /* drops queued tracks once streams close or a file opens */
   CEvent              m_startEvent;          /* event for playback start */
   StreamInfo* m_currentStream = nullptr;
   IAudioCallback*     m_audioCallback;       /* the viz audio callback */
@@ -145,6 +148,7 @@ private:
   int64_t GetTotalTime64();
   void UpdateCrossfadeTime(const CFileItem& file);
   void UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int crossFadingTime);
+  int GetPrepareNextAtFrame(int64_t streamTotalTime, unsigned int sampleRate) const;
   void UpdateGUIData(StreamInfo *si);
   int64_t GetTimeInternal();
   bool SetTimeInternal(int64_t time);
@@ -30,6 +30,8 @@ public:
   int ReadRaw(uint8_t **pBuffer, int *bufferSize) override;
   bool CanInit() override;
   bool CanSeek() override;
+  // libavformat applies edit lists, LAME headers and Opus pre-skip
+  bool HandlesGapless() const override { return true; }
 
   void DeInit();
   AEAudioFormat GetFormat();
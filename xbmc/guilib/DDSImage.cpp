@@ -13,6 +13,9 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
 #include <string.h>
 using namespace XFILE;
 
@@ -100,6 +103,243 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
   return true;
 }
 
+bool CDDSImage::WriteFile(const std::string &outputFile) const
+{
+  // open the file
+  CFile file;
+  if (!file.OpenForWrite(outputFile, true))
+    return false;
+
+  // write the header, then the data
+  if (file.Write("DDS ", 4) != 4 ||
+      file.Write(&m_desc, sizeof(m_desc)) != sizeof(m_desc) ||
+      file.Write(m_data, m_desc.linearSize) != static_cast<ssize_t>(m_desc.linearSize))
+  {
+    CLog::Log(LOGERROR, "{} - unable to write {}", __FUNCTION__, outputFile);
+    file.Close();
+    CFile::Delete(outputFile);
+    return false;
+  }
+
+  file.Close();
+  return true;
+}
+
+bool CDDSImage::Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga)
+{
+  if (!brga || !width || !height)
+    return false;
+
+  bool hasAlpha = false;
+  for (unsigned int y = 0; y < height && !hasAlpha; y++)
+  {
+    const unsigned char *row = brga + y * pitch;
+    for (unsigned int x = 0; x < width; x++)
+    {
+      if (row[x * 4 + 3] != 0xff)
+      {
+        hasAlpha = true;
+        break;
+      }
+    }
+  }
+
+  Allocate(width, height, hasAlpha ? XB_FMT_DXT5 : XB_FMT_DXT1);
+  if (!m_data)
+    return false;
+
+  // gather each 4x4 block, repeating the last row and column at the edges
+  unsigned char *out = m_data;
+  unsigned char block[16 * 4];
+  for (unsigned int by = 0; by < height; by += 4)
+  {
+    for (unsigned int bx = 0; bx < width; bx += 4)
+    {
+      for (unsigned int y = 0; y < 4; y++)
+      {
+        const unsigned char *row = brga + std::min(by + y, height - 1) * pitch;
+        for (unsigned int x = 0; x < 4; x++)
+          memcpy(block + (y * 4 + x) * 4, row + std::min(bx + x, width - 1) * 4, 4);
+      }
+
+      if (hasAlpha)
+      {
+        CompressAlphaBlock(block, out);
+        out += 8;
+      }
+      CompressColorBlock(block, out);
+      out += 8;
+    }
+  }
+
+  return WriteFile(outputFile);
+}
+
+void CDDSImage::CompressColorBlock(const unsigned char *block, unsigned char *out)
+{
+  // fit a line through the colours along their principal axis
+  float mean[3] = {};
+  for (unsigned int i = 0; i < 16; i++)
+    for (unsigned int c = 0; c < 3; c++)
+      mean[c] += block[i * 4 + c] / 16.0f;
+
+  float cov[6] = {};
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    const float d[3] = {block[i * 4] - mean[0], block[i * 4 + 1] - mean[1], block[i * 4 + 2] - mean[2]};
+    cov[0] += d[0] * d[0];
+    cov[1] += d[0] * d[1];
+    cov[2] += d[0] * d[2];
+    cov[3] += d[1] * d[1];
+    cov[4] += d[1] * d[2];
+    cov[5] += d[2] * d[2];
+  }
+
+  // start from the channel that varies most, a fixed start can be orthogonal to the axis
+  float axis[3] = {};
+  if (cov[0] >= cov[3] && cov[0] >= cov[5])
+    axis[0] = 1.0f;
+  else if (cov[3] >= cov[5])
+    axis[1] = 1.0f;
+  else
+    axis[2] = 1.0f;
+  for (unsigned int iter = 0; iter < 4; iter++)
+  {
+    const float v[3] = {cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                        cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                        cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]};
+    const float len = std::max(std::max(fabsf(v[0]), fabsf(v[1])), fabsf(v[2]));
+    if (len < 1.0f)
+      break; // flat block, keep the axis we have
+    for (unsigned int c = 0; c < 3; c++)
+      axis[c] = v[c] / len;
+  }
+
+  // the extremes along the axis, pulled in a little as they are rarely hit exactly
+  unsigned int minIndex = 0, maxIndex = 0;
+  float minDot = 0.0f, maxDot = 0.0f;
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    const float dot = block[i * 4] * axis[0] + block[i * 4 + 1] * axis[1] + block[i * 4 + 2] * axis[2];
+    if (i == 0 || dot < minDot)
+    {
+      minDot = dot;
+      minIndex = i;
+    }
+    if (i == 0 || dot > maxDot)
+    {
+      maxDot = dot;
+      maxIndex = i;
+    }
+  }
+
+  uint16_t endpoints[2];
+  const unsigned char *extremes[2] = {block + maxIndex * 4, block + minIndex * 4};
+  for (unsigned int e = 0; e < 2; e++)
+  {
+    int bgr[3];
+    for (unsigned int c = 0; c < 3; c++)
+    {
+      const int inset = (extremes[0][c] - extremes[1][c]) / 16;
+      bgr[c] = std::min(std::max(extremes[e][c] + (e ? inset : -inset), 0), 255);
+    }
+    endpoints[e] = static_cast<uint16_t>(((bgr[2] * 31 + 127) / 255) << 11 |
+                                         ((bgr[1] * 63 + 127) / 255) << 5 |
+                                         ((bgr[0] * 31 + 127) / 255));
+  }
+  // four colour mode needs the first endpoint to be the larger
+  if (endpoints[0] < endpoints[1])
+    std::swap(endpoints[0], endpoints[1]);
+
+  int palette[4][3];
+  for (unsigned int e = 0; e < 2; e++)
+  {
+    const int r = (endpoints[e] >> 11) & 31;
+    const int g = (endpoints[e] >> 5) & 63;
+    const int b = endpoints[e] & 31;
+    palette[e][0] = (b << 3) | (b >> 2);
+    palette[e][1] = (g << 2) | (g >> 4);
+    palette[e][2] = (r << 3) | (r >> 2);
+  }
+  for (unsigned int c = 0; c < 3; c++)
+  {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+
+  uint32_t indices = 0;
+  if (endpoints[0] != endpoints[1])
+  {
+    for (unsigned int i = 0; i < 16; i++)
+    {
+      unsigned int best = 0;
+      int bestError = INT_MAX;
+      for (unsigned int p = 0; p < 4; p++)
+      {
+        int error = 0;
+        for (unsigned int c = 0; c < 3; c++)
+        {
+          const int d = block[i * 4 + c] - palette[p][c];
+          error += d * d;
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          best = p;
+        }
+      }
+      indices |= best << (i * 2);
+    }
+  }
+
+  out[0] = endpoints[0] & 0xff;
+  out[1] = endpoints[0] >> 8;
+  out[2] = endpoints[1] & 0xff;
+  out[3] = endpoints[1] >> 8;
+  for (unsigned int i = 0; i < 4; i++)
+    out[4 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+void CDDSImage::CompressAlphaBlock(const unsigned char *block, unsigned char *out)
+{
+  int maxAlpha = 0, minAlpha = 255;
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    maxAlpha = std::max(maxAlpha, static_cast<int>(block[i * 4 + 3]));
+    minAlpha = std::min(minAlpha, static_cast<int>(block[i * 4 + 3]));
+  }
+
+  // eight value mode, the endpoints and six steps in between
+  int palette[8] = {maxAlpha, minAlpha};
+  for (int i = 1; i < 7; i++)
+    palette[i + 1] = ((7 - i) * maxAlpha + i * minAlpha) / 7;
+
+  uint64_t indices = 0;
+  if (maxAlpha != minAlpha)
+  {
+    for (unsigned int i = 0; i < 16; i++)
+    {
+      unsigned int best = 0;
+      int bestError = INT_MAX;
+      for (unsigned int p = 0; p < 8; p++)
+      {
+        const int error = abs(block[i * 4 + 3] - palette[p]);
+        if (error < bestError)
+        {
+          bestError = error;
+          best = p;
+        }
+      }
+      indices |= static_cast<uint64_t>(best) << (i * 3);
+    }
+  }
+
+  out[0] = static_cast<unsigned char>(maxAlpha);
+  out[1] = static_cast<unsigned char>(minAlpha);
+  for (unsigned int i = 0; i < 6; i++)
+    out[2 + i] = (indices >> (i * 8)) & 0xff;
+}
+
 unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format)
 {
   switch (format)
@@ -25,11 +25,26 @@ public:
   unsigned char *GetData() const;
 
   bool ReadFile(const std::string &file);
+  bool WriteFile(const std::string &file) const;
+
+  /*! \brief Compress an image and write it out as a DDS file.
+   Images with transparent pixels are stored as DXT5, opaque ones as DXT1.
+   \param outputFile the file to write to.
+   \param width the width of the image.
+   \param height the height of the image.
+   \param pitch the number of bytes per row of the image.
+   \param brga the pixels of the image, in BGRA order.
+   \return true on success, false otherwise.
+   */
+  bool Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga);
 
 private:
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
   static const char *GetFourCC(unsigned int format);
 
+  static void CompressColorBlock(const unsigned char *block, unsigned char *out);
+  static void CompressAlphaBlock(const unsigned char *block, unsigned char *out);
+
   static unsigned int GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format);
   enum {
     ddsd_caps        = 0x00000001,
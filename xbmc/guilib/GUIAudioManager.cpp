@@ -21,10 +21,27 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/URIUtils.h"
 #include "utils/XBMCTinyXML.h"
 #include "utils/log.h"
 
+#include <functional>
+
+namespace
+{
+// ends a load when the job is done, also if the job manager dropped it before it ran
+class CLoadGuard
+{
+public:
+  explicit CLoadGuard(std::function<void()> done) : m_done(std::move(done)) {}
+  ~CLoadGuard() { m_done(); }
+
+private:
+  std::function<void()> m_done;
+};
+} // namespace
+
 CGUIAudioManager::CGUIAudioManager()
 {
   m_settings = CServiceBroker::GetSettingsComponent()->GetSettings();
@@ -39,6 +56,7 @@ CGUIAudioManager::CGUIAudioManager()
 CGUIAudioManager::~CGUIAudioManager()
 {
   m_settings->UnregisterCallback(this);
+  WaitForLoads();
 }
 
 void CGUIAudioManager::OnSettingChanged(const std::shared_ptr<const CSetting>& setting)
@@ -79,6 +97,8 @@ void CGUIAudioManager::Initialize()
 
 void CGUIAudioManager::DeInitialize()
 {
+  WaitForLoads();
+
   CSingleLock lock(m_cs);
   UnLoad();
 }
@@ -183,6 +203,8 @@ void CGUIAudioManager::PlayPythonSound(const std::string& strFileName, bool useC
 
 void CGUIAudioManager::UnLoad()
 {
+  // sounds of a load still in progress are not wanted anymore
+  m_loadId++;
   m_windowSoundMap.clear();
   m_pythonSounds.clear();
   m_actionSoundMap.clear();
@@ -241,6 +263,9 @@ bool CGUIAudioManager::Load()
     return false;
   }
 
+  std::map<int, std::string> actionFiles;
+  std::map<int, std::pair<std::string, std::string>> windowFiles;
+
   //  Load sounds for actions
   TiXmlElement* pActions = pRoot->FirstChildElement("actions");
   if (pActions)
@@ -262,12 +287,7 @@ bool CGUIAudioManager::Load()
         strFile += pFileNode->FirstChild()->Value();
 
       if (id != ACTION_NONE && !strFile.empty())
-      {
-        std::string filename = URIUtils::AddFileToFolder(m_strMediaDir, strFile);
-        auto sound = LoadSound(filename);
-        if (sound)
-          m_actionSoundMap.emplace(id, std::move(sound));
-      }
+        actionFiles.emplace(id, URIUtils::AddFileToFolder(m_strMediaDir, strFile));
 
       pAction = pAction->NextSibling();
     }
@@ -290,20 +310,91 @@ bool CGUIAudioManager::Load()
           id = CWindowTranslator::TranslateWindow(pIdNode->FirstChild()->Value());
       }
 
-      CWindowSounds sounds;
-      sounds.initSound   = LoadWindowSound(pWindow, "activate"  );
-      sounds.deInitSound = LoadWindowSound(pWindow, "deactivate");
-
       if (id > 0)
-        m_windowSoundMap.insert(std::pair<int, CWindowSounds>(id, sounds));
+        windowFiles.emplace(id, std::make_pair(GetWindowSoundFile(pWindow, "activate"),
+                                               GetWindowSoundFile(pWindow, "deactivate")));
 
       pWindow = pWindow->NextSibling();
     }
   }
 
+  // decoding and converting all sounds takes a while, don't hold up the gui for it
+  const unsigned int loadId = ++m_loadId;
+  m_pendingLoads++;
+  m_loadsDone.Reset();
+  auto guard = std::make_shared<CLoadGuard>([this]() {
+    CSingleLock lock(m_cs);
+    if (--m_pendingLoads == 0)
+    {
+      lock.Leave();
+      m_loadsDone.Set();
+    }
+  });
+  CJobManager::GetInstance().Submit([this, loadId, actionFiles, windowFiles, guard]() {
+    LoadSounds(loadId, actionFiles, windowFiles);
+  });
+
   return true;
 }
 
+void CGUIAudioManager::LoadSounds(
+    unsigned int loadId,
+    const std::map<int, std::string>& actionFiles,
+    const std::map<int, std::pair<std::string, std::string>>& windowFiles)
+{
+  std::map<std::string, std::shared_ptr<IAESound>> sounds;
+  const auto load = [&sounds](const std::string& filename) -> std::shared_ptr<IAESound> {
+    if (filename.empty())
+      return nullptr;
+
+    const auto it = sounds.find(filename);
+    if (it != sounds.end())
+      return it->second;
+
+    std::shared_ptr<IAESound> sound;
+    IAE* ae = CServiceBroker::GetActiveAE();
+    if (ae)
+      sound = ae->MakeSound(filename);
+    sounds.emplace(filename, sound);
+    return sound;
+  };
+
+  actionSoundMap actionSounds;
+  for (const auto& actionFile : actionFiles)
+  {
+    auto sound = load(actionFile.second);
+    if (sound)
+      actionSounds.emplace(actionFile.first, std::move(sound));
+  }
+
+  windowSoundMap windowSounds;
+  for (const auto& windowFile : windowFiles)
+  {
+    CWindowSounds windowSound;
+    windowSound.initSound = load(windowFile.second.first);
+    windowSound.deInitSound = load(windowFile.second.second);
+    windowSounds.emplace(windowFile.first, windowSound);
+  }
+
+  CSingleLock lock(m_cs);
+  if (loadId == m_loadId)
+  {
+    m_actionSoundMap = std::move(actionSounds);
+    m_windowSoundMap = std::move(windowSounds);
+    for (const auto& sound : sounds)
+    {
+      if (sound.second)
+        m_soundCache[sound.first] = sound.second;
+    }
+    CLog::Log(LOGDEBUG, "CGUIAudioManager::{} - loaded {} sounds", __FUNCTION__, sounds.size());
+  }
+}
+
+void CGUIAudioManager::WaitForLoads()
+{
+  m_loadsDone.Wait();
+}
+
 std::shared_ptr<IAESound> CGUIAudioManager::LoadSound(const std::string& filename)
 {
   CSingleLock lock(m_cs);
@@ -330,18 +421,18 @@ std::shared_ptr<IAESound> CGUIAudioManager::LoadSound(const std::string& filenam
   return sound;
 }
 
-// \brief Load a window node of the config file (sounds.xml)
-std::shared_ptr<IAESound> CGUIAudioManager::LoadWindowSound(TiXmlNode* pWindowNode,
-                                                            const std::string& strIdentifier)
+// \brief Get the sound file of a window node of the config file (sounds.xml)
+std::string CGUIAudioManager::GetWindowSoundFile(TiXmlNode* pWindowNode,
+                                                 const std::string& strIdentifier)
 {
   if (!pWindowNode)
-    return NULL;
+    return "";
 
   TiXmlNode* pFileNode = pWindowNode->FirstChild(strIdentifier);
   if (pFileNode && pFileNode->FirstChild())
-    return LoadSound(URIUtils::AddFileToFolder(m_strMediaDir, pFileNode->FirstChild()->Value()));
+    return URIUtils::AddFileToFolder(m_strMediaDir, pFileNode->FirstChild()->Value());
 
-  return NULL;
+  return "";
 }
 
 // \brief Enable/Disable nav sounds
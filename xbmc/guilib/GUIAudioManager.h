@@ -12,6 +12,7 @@
 #include "cores/AudioEngine/Interfaces/AESound.h"
 #include "settings/lib/ISettingCallback.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 
 #include <map>
 #include <memory>
@@ -82,8 +83,20 @@ private:
 
   CCriticalSection    m_cs;
 
+  unsigned int        m_loadId = 0;
+  int                 m_pendingLoads = 0;
+  CEvent              m_loadsDone{true, true};
+
   std::shared_ptr<IAESound> LoadSound(const std::string& filename);
-  std::shared_ptr<IAESound> LoadWindowSound(TiXmlNode* pWindowNode,
-                                            const std::string& strIdentifier);
+  std::string GetWindowSoundFile(TiXmlNode* pWindowNode, const std::string& strIdentifier);
+
+  /*!
+   * \brief Decode the sounds of a sound skin, runs as a job so the gui never waits for it.
+   * The maps are swapped in once all sounds are ready, unless a newer load started.
+   */
+  void LoadSounds(unsigned int loadId,
+                  const std::map<int, std::string>& actionFiles,
+                  const std::map<int, std::pair<std::string, std::string>>& windowFiles);
+  void WaitForLoads();
 };
 
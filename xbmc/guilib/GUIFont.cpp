@@ -275,6 +275,28 @@ float CGUIFont::GetTextWidth(const vecText& text)
   return m_font->GetTextWidthInternal(text) * context.GetGUIScaleX();
 }
 
+void CGUIFont::GetCharWidths(const vecText& text,
+                             std::vector<float>& advances,
+                             std::vector<float>& overhangs)
+{
+  advances.clear();
+  overhangs.clear();
+  CWinSystemBase* const winSystem = CServiceBroker::GetWinSystem();
+  if (!m_font || !winSystem)
+    return;
+
+  CGraphicContext& context = winSystem->GetGfxContext();
+
+  CSingleLock lock(context);
+  m_font->GetCharWidthsInternal(text, advances, overhangs);
+  const float scaleX = context.GetGUIScaleX();
+  for (size_t i = 0; i < advances.size(); i++)
+  {
+    advances[i] *= scaleX;
+    overhangs[i] *= scaleX;
+  }
+}
+
 float CGUIFont::GetCharWidth(character_t ch)
 {
   CWinSystemBase* const winSystem = CServiceBroker::GetWinSystem();
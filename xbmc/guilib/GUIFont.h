@@ -151,6 +151,17 @@ public:
 
   float GetTextWidth(const vecText& text);
   float GetCharWidth(character_t ch);
+
+  /*! \brief Get the width of each character of a single line, to measure parts of it
+   The line is shaped once and not kept in the font's shaped text cache. The width of the
+   characters [start, end) is the sum of their advances plus the overhang of character end - 1.
+   \param text the line to measure
+   \param advances [out] advance of each character
+   \param overhangs [out] extra width of each character when it is the last one measured
+   */
+  void GetCharWidths(const vecText& text,
+                     std::vector<float>& advances,
+                     std::vector<float>& overhangs);
   float GetTextHeight(int numLines) const;
   float GetTextBaseLine() const;
   float GetLineHeight() const;
@@ -335,6 +335,17 @@ void GUIFontManager::FreeFontFile(CGUIFontTTF* pFont)
   }
 }
 
+void GUIFontManager::GetShapedTextStats(unsigned int& hits, unsigned int& misses) const
+{
+  hits = 0;
+  misses = 0;
+  for (const auto& fontFile : m_vecFontFiles)
+  {
+    hits += fontFile->GetShapedTextHits();
+    misses += fontFile->GetShapedTextMisses();
+  }
+}
+
 CGUIFontTTF* GUIFontManager::GetFontFile(const std::string& fontIdent)
 {
   for (const auto& it : m_vecFontFiles)
@@ -97,6 +97,10 @@ public:
   void Clear();
   void FreeFontFile(CGUIFontTTF* pFont);
 
+  /*! \brief Sum of the shaped text cache hits and misses of the loaded font files
+   */
+  void GetShapedTextStats(unsigned int& hits, unsigned int& misses) const;
+
   static void SettingOptionsFontsFiller(const std::shared_ptr<const CSetting>& setting,
                                         std::vector<StringSettingOption>& list,
                                         std::string& current,
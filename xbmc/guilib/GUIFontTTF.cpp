@@ -13,11 +13,15 @@
 #include "ServiceBroker.h"
 #include "Texture.h"
 #include "URL.h"
+#include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
 #include "rendering/RenderSystem.h"
 #include "threads/SystemClock.h"
+#include "utils/Digest.h"
 #include "utils/MathUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -57,6 +61,32 @@ constexpr int CHAR_CHUNK = 64; // 64 chars allocated at a time (1024 bytes)
 constexpr int GLYPH_STRENGTH_BOLD = 24;
 constexpr int GLYPH_STRENGTH_LIGHT = -48;
 constexpr int TAB_SPACE_LENGTH = 4;
+// limits of the shaped text cache of each font, a glyph takes 40 bytes
+constexpr size_t SHAPED_TEXT_MAX_ENTRIES = 1024;
+constexpr size_t SHAPED_TEXT_MAX_GLYPHS = 16384;
+
+// characters cached in earlier runs, so they don't have to be rendered again
+constexpr const char* CHARACTER_CACHE_PATH = "special://profile/fontcache/";
+constexpr uint32_t CHARACTER_CACHE_MAGIC = 0x4643544b; // "KTCF"
+constexpr uint32_t CHARACTER_CACHE_VERSION = 1;
+// common characters cached ahead of their first use, a few each frame
+constexpr unsigned int WARMUP_CHARS_PER_FRAME = 8;
+
+struct CharacterCacheHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t characterSize;
+  uint64_t fontSize;
+  int64_t fontTime;
+  uint32_t textureWidth;
+  uint32_t textureHeight;
+  uint32_t cellHeight;
+  uint32_t cellBaseLine;
+  int32_t posX;
+  int32_t posY;
+  uint32_t numChars;
+};
 } /* namespace */
 
 class CFreeTypeLibrary
@@ -207,6 +237,11 @@ void CGUIFontTTF::ClearCharacterCache()
 
 void CGUIFontTTF::Clear()
 {
+  SaveCharacterCache();
+  m_savedChars = 0;
+  m_warmupLetter = 0;
+  m_fontPath.clear();
+
   m_texture.reset();
   m_texture = nullptr;
   delete[] m_char;
@@ -231,6 +266,8 @@ void CGUIFontTTF::Clear()
   m_vertexTrans.clear();
   m_vertex.clear();
 
+  ClearShapedTextCache();
+
   m_fontFileInMemory.clear();
 }
 
@@ -317,6 +354,10 @@ bool CGUIFontTTF::Load(
   m_posX = m_textureWidth;
   m_posY = -static_cast<int>(GetTextureLineHeight());
 
+  m_fontPath = strFilename;
+  if (!LoadCharacterCache())
+    m_warmupLetter = L' ';
+
   // cache the ellipses width
   Character* ellipse = GetCharacter(L'.', 0);
   if (ellipse)
@@ -327,6 +368,9 @@ bool CGUIFontTTF::Load(
 
 void CGUIFontTTF::Begin()
 {
+  if (m_nestedBeginCount == 0 && m_warmupLetter)
+    WarmupCharacters();
+
   if (m_nestedBeginCount == 0 && m_texture && FirstBegin())
   {
     m_vertexTrans.clear();
@@ -362,7 +406,6 @@ void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
   }
 
   Begin();
-  std::vector<Glyph> glyphs = GetHarfBuzzShapedGlyphs(text);
   uint32_t rawAlignment = alignment;
   bool dirtyCache(false);
   bool hardwareClipping = m_renderSystem->ScissorsCanEffectClipping();
@@ -392,6 +435,8 @@ void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
     m_originX = x;
     m_originY = y;
 
+    const std::vector<Glyph>& glyphs = GetShapedText(text).m_glyphs;
+
     // Check if we will really need to truncate or justify the text
     if (alignment & XBFONT_TRUNCATED)
     {
@@ -570,12 +615,14 @@ void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
 
 float CGUIFontTTF::GetTextWidthInternal(const vecText& text)
 {
-  std::vector<Glyph> glyphs = GetHarfBuzzShapedGlyphs(text);
-  return GetTextWidthInternal(text, glyphs);
+  ShapedText& shaped = GetShapedText(text);
+  if (shaped.m_width < 0.0f)
+    shaped.m_width = GetTextWidthInternal(text, shaped.m_glyphs);
+  return shaped.m_width;
 }
 
 // this routine assumes a single line (i.e. it was called from GUITextLayout)
-float CGUIFontTTF::GetTextWidthInternal(const vecText& text, std::vector<Glyph>& glyphs)
+float CGUIFontTTF::GetTextWidthInternal(const vecText& text, const std::vector<Glyph>& glyphs)
 {
   float width = 0;
   for (auto it = glyphs.begin(); it != glyphs.end(); it++)
@@ -598,6 +645,28 @@ float CGUIFontTTF::GetTextWidthInternal(const vecText& text, std::vector<Glyph>&
   return width;
 }
 
+void CGUIFontTTF::GetCharWidthsInternal(const vecText& text,
+                                        std::vector<float>& advances,
+                                        std::vector<float>& overhangs)
+{
+  advances.assign(text.size(), 0.0f);
+  overhangs.assign(text.size(), 0.0f);
+
+  for (const auto& glyph : GetHarfBuzzShapedGlyphs(text))
+  {
+    const unsigned int cluster = glyph.m_glyphInfo.cluster;
+    Character* c = GetCharacter(text[cluster], glyph.m_glyphInfo.codepoint);
+    if (c)
+    {
+      if ((c->m_letter & 0xffff) == static_cast<character_t>('\t'))
+        advances[cluster] += GetTabSpaceLength();
+      else
+        advances[cluster] += c->m_advance;
+      overhangs[cluster] = std::max(c->m_right - c->m_left + c->m_offsetX - c->m_advance, 0.0f);
+    }
+  }
+}
+
 float CGUIFontTTF::GetCharWidthInternal(character_t ch)
 {
   Character* c = GetCharacter(ch, 0);
@@ -724,6 +793,69 @@ std::vector<CGUIFontTTF::Glyph> CGUIFontTTF::GetHarfBuzzShapedGlyphs(const vecTe
   return glyphs;
 }
 
+size_t CGUIFontTTF::TextHash::operator()(const vecText& text) const
+{
+  size_t hash = text.size();
+  for (const auto& character : text)
+    hash = hash * 31 + character;
+  return hash;
+}
+
+CGUIFontTTF::ShapedText& CGUIFontTTF::GetShapedText(const vecText& text)
+{
+  auto it = m_shapedText.find(text);
+  if (it != m_shapedText.end())
+  {
+    m_shapedTextHits++;
+    m_shapedTextOrder.splice(m_shapedTextOrder.begin(), m_shapedTextOrder, it->second.m_lastUsed);
+    return it->second;
+  }
+
+  m_shapedTextMisses++;
+  std::vector<Glyph> glyphs = GetHarfBuzzShapedGlyphs(text);
+
+  if (glyphs.size() > SHAPED_TEXT_MAX_GLYPHS / 8)
+  {
+    m_uncachedText.m_glyphs = std::move(glyphs);
+    m_uncachedText.m_width = -1.0f;
+    return m_uncachedText;
+  }
+
+  // make room by dropping the texts used longest ago
+  while (!m_shapedTextOrder.empty() &&
+         (m_shapedText.size() >= SHAPED_TEXT_MAX_ENTRIES ||
+          m_shapedTextGlyphs + glyphs.size() > SHAPED_TEXT_MAX_GLYPHS))
+  {
+    auto oldest = m_shapedText.find(*m_shapedTextOrder.back());
+    m_shapedTextOrder.pop_back();
+    m_shapedTextGlyphs -= oldest->second.m_glyphs.size();
+    m_shapedText.erase(oldest);
+  }
+
+  it = m_shapedText.emplace(text, ShapedText()).first;
+  it->second.m_glyphs = std::move(glyphs);
+  m_shapedTextGlyphs += it->second.m_glyphs.size();
+  m_shapedTextOrder.push_front(&it->first);
+  it->second.m_lastUsed = m_shapedTextOrder.begin();
+  return it->second;
+}
+
+void CGUIFontTTF::ClearShapedTextCache()
+{
+  if (m_shapedTextMisses > 0)
+    CLog::Log(LOGDEBUG,
+              "{} - shaped text cache of font {}: {} hits, {} misses, {} texts with {} glyphs",
+              __FUNCTION__, m_fontIdent, m_shapedTextHits, m_shapedTextMisses, m_shapedText.size(),
+              m_shapedTextGlyphs);
+
+  m_shapedText.clear();
+  m_shapedTextOrder.clear();
+  m_uncachedText = ShapedText();
+  m_shapedTextGlyphs = 0;
+  m_shapedTextHits = 0;
+  m_shapedTextMisses = 0;
+}
+
 CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyphIndex)
 {
   wchar_t letter = (wchar_t)(chr & 0xffff);
@@ -804,7 +936,13 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyph
     Begin();
   m_nestedBeginCount = nestedBeginCount;
 
-  // fixup quick access
+  UpdateQuickAccess();
+
+  return m_char + low;
+}
+
+void CGUIFontTTF::UpdateQuickAccess()
+{
   memset(m_charquick, 0, sizeof(m_charquick));
   for (int i = 0; i < m_numChars; i++)
   {
@@ -816,8 +954,178 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyph
         m_charquick[ch] = m_char + i;
     }
   }
+}
 
-  return m_char + low;
+void CGUIFontTTF::WarmupCharacters()
+{
+  const unsigned int frameTime = CTimeUtils::GetFrameTime();
+  if (frameTime != m_warmupFrameTime)
+  {
+    m_warmupFrameTime = frameTime;
+    m_warmupBudget = WARMUP_CHARS_PER_FRAME;
+  }
+
+  // printable ascii and latin-1
+  while (m_warmupLetter && m_warmupBudget > 0)
+  {
+    const wchar_t letter = m_warmupLetter;
+    if (letter == 0x7e)
+      m_warmupLetter = 0xa1;
+    else if (letter == 0xff)
+      m_warmupLetter = 0;
+    else
+      m_warmupLetter++;
+
+    const FT_UInt glyphIndex = FT_Get_Char_Index(m_face, letter);
+    if (!glyphIndex)
+      continue;
+
+    m_warmupBudget--;
+    if (!GetCharacter(letter, glyphIndex))
+      m_warmupLetter = 0;
+  }
+}
+
+std::string CGUIFontTTF::GetCharacterCachePath() const
+{
+  const std::string name = KODI::UTILITY::CDigest::Calculate(KODI::UTILITY::CDigest::Type::MD5,
+                                                             m_fontPath + "|" + m_fontIdent);
+  return URIUtils::AddFileToFolder(CHARACTER_CACHE_PATH, name + ".cache");
+}
+
+bool CGUIFontTTF::LoadCharacterCache()
+{
+#if defined(HAS_GL) || defined(HAS_GLES)
+  struct __stat64 stat;
+  if (XFILE::CFile::Stat(m_fontPath, &stat) != 0)
+    return false;
+
+  XFILE::CFile file;
+  if (!file.Open(GetCharacterCachePath()))
+    return false;
+
+  CharacterCacheHeader header;
+  if (file.Read(&header, sizeof(header)) != sizeof(header) ||
+      header.magic != CHARACTER_CACHE_MAGIC || header.version != CHARACTER_CACHE_VERSION ||
+      header.characterSize != sizeof(Character) ||
+      header.fontSize != static_cast<uint64_t>(stat.st_size) ||
+      header.fontTime != static_cast<int64_t>(stat.st_mtime) ||
+      header.textureWidth != m_textureWidth || header.cellHeight != m_cellHeight ||
+      header.cellBaseLine != m_cellBaseLine || header.numChars == 0 ||
+      header.textureHeight == 0 || header.textureHeight > m_renderSystem->GetMaxTextureSize() ||
+      header.posY < 0 || header.posY + GetTextureLineHeight() > header.textureHeight)
+  {
+    CLog::Log(LOGDEBUG, "CGUIFontTTF::{}: ignoring outdated character cache of font {}", __func__,
+              m_fontIdent);
+    return false;
+  }
+
+  // the counts come from disk, check them against the file before allocating anything
+  const uint64_t charactersSize = static_cast<uint64_t>(header.numChars) * sizeof(Character);
+  const uint64_t pixelsSize = static_cast<uint64_t>(header.textureWidth) * header.textureHeight;
+  if (header.numChars > pixelsSize ||
+      static_cast<uint64_t>(file.GetLength()) != sizeof(header) + charactersSize + pixelsSize)
+  {
+    CLog::Log(LOGDEBUG, "CGUIFontTTF::{}: ignoring damaged character cache of font {}", __func__,
+              m_fontIdent);
+    return false;
+  }
+
+  std::vector<Character> characters(header.numChars);
+  if (file.Read(characters.data(), charactersSize) != static_cast<ssize_t>(charactersSize))
+    return false;
+
+  std::unique_ptr<CTexture> texture =
+      CTexture::CreateTexture(header.textureWidth, header.textureHeight, XB_FMT_A8);
+  if (!texture || !texture->GetPixels())
+    return false;
+
+  for (unsigned int y = 0; y < texture->GetHeight(); y++)
+  {
+    if (file.Read(texture->GetPixels() + y * texture->GetPitch(), header.textureWidth) !=
+        static_cast<ssize_t>(header.textureWidth))
+      return false;
+  }
+
+  // let the texture be copied into one the font can render from
+  m_texture = std::move(texture);
+  unsigned int newHeight = header.textureHeight;
+  std::unique_ptr<CTexture> newTexture = ReallocTexture(newHeight);
+  m_texture = std::move(newTexture);
+  if (!m_texture)
+    return false;
+
+  delete[] m_char;
+  m_maxChars = (header.numChars + CHAR_CHUNK - 1) / CHAR_CHUNK * CHAR_CHUNK;
+  m_char = new Character[m_maxChars];
+  memcpy(m_char, characters.data(), charactersSize);
+  m_numChars = header.numChars;
+  m_posX = header.posX;
+  m_posY = header.posY;
+  UpdateQuickAccess();
+  m_savedChars = m_numChars;
+
+  CLog::Log(LOGDEBUG, "CGUIFontTTF::{}: restored {} characters of font {}", __func__, m_numChars,
+            m_fontIdent);
+  return true;
+#else
+  // the characters are only kept in video memory
+  return false;
+#endif
+}
+
+void CGUIFontTTF::SaveCharacterCache()
+{
+#if defined(HAS_GL) || defined(HAS_GLES)
+  if (m_numChars == m_savedChars || !m_texture || !m_texture->GetPixels() || m_fontPath.empty())
+    return;
+
+  struct __stat64 stat;
+  if (XFILE::CFile::Stat(m_fontPath, &stat) != 0)
+    return;
+
+  CharacterCacheHeader header;
+  header.magic = CHARACTER_CACHE_MAGIC;
+  header.version = CHARACTER_CACHE_VERSION;
+  header.characterSize = sizeof(Character);
+  header.fontSize = stat.st_size;
+  header.fontTime = stat.st_mtime;
+  header.textureWidth = m_textureWidth;
+  header.textureHeight = m_textureHeight;
+  header.cellHeight = m_cellHeight;
+  header.cellBaseLine = m_cellBaseLine;
+  header.posX = m_posX;
+  header.posY = m_posY;
+  header.numChars = m_numChars;
+
+  XFILE::CDirectory::Create(CHARACTER_CACHE_PATH);
+  XFILE::CFile file;
+  if (!file.OpenForWrite(GetCharacterCachePath(), true))
+  {
+    CLog::Log(LOGDEBUG, "CGUIFontTTF::{}: unable to write character cache of font {}", __func__,
+              m_fontIdent);
+    return;
+  }
+
+  const ssize_t charactersSize = m_numChars * sizeof(Character);
+  bool written = file.Write(&header, sizeof(header)) == sizeof(header) &&
+                 file.Write(m_char, charactersSize) == charactersSize;
+  for (unsigned int y = 0; written && y < m_textureHeight; y++)
+    written = file.Write(m_texture->GetPixels() + y * m_texture->GetPitch(), m_textureWidth) ==
+              static_cast<ssize_t>(m_textureWidth);
+  file.Close();
+
+  if (!written)
+  {
+    // don't leave a truncated cache behind
+    CLog::Log(LOGDEBUG, "CGUIFontTTF::{}: unable to write character cache of font {}", __func__,
+              m_fontIdent);
+    XFILE::CFile::Delete(GetCharacterCachePath());
+    return;
+  }
+
+  m_savedChars = m_numChars;
+#endif
 }
 
 bool CGUIFontTTF::CacheCharacter(wchar_t letter, uint32_t style, Character* ch, FT_UInt glyphIndex)
@@ -11,9 +11,11 @@
 #include "utils/ColorUtils.h"
 #include "utils/Geometry.h"
 
+#include <list>
 #include <memory>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ft2build.h>
@@ -98,6 +100,11 @@ public:
 
   const std::string& GetFontIdent() const { return m_fontIdent; }
 
+  /*! \brief hits and misses of the shaped text cache since the font was last cleared
+   */
+  unsigned int GetShapedTextHits() const { return m_shapedTextHits; }
+  unsigned int GetShapedTextMisses() const { return m_shapedTextMisses; }
+
 protected:
   explicit CGUIFontTTF(const std::string& fontIdent);
 
@@ -130,6 +137,18 @@ protected:
     wchar_t m_letter;
   };
 
+  struct ShapedText
+  {
+    std::vector<Glyph> m_glyphs;
+    float m_width{-1.0f}; // measured on first use
+    std::list<const vecText*>::iterator m_lastUsed;
+  };
+
+  struct TextHash
+  {
+    size_t operator()(const vecText& text) const;
+  };
+
   struct RunInfo
   {
     unsigned int m_startOffset;
@@ -145,8 +164,22 @@ protected:
 
   std::vector<Glyph> GetHarfBuzzShapedGlyphs(const vecText& text);
 
+  /*! \brief shaped glyphs of a text, the texts used last are kept so they are only shaped once
+   The result is valid until the next call.
+   */
+  ShapedText& GetShapedText(const vecText& text);
+  void ClearShapedTextCache();
+
   float GetTextWidthInternal(const vecText& text);
-  float GetTextWidthInternal(const vecText& text, std::vector<Glyph>& glyph);
+  float GetTextWidthInternal(const vecText& text, const std::vector<Glyph>& glyph);
+
+  /*! \brief advance and overhang of each character of a single line
+   The line is shaped without going through the shaped text cache. A glyph is added to the
+   character it starts at, the overhang is what its rendering sticks out past its advance.
+   */
+  void GetCharWidthsInternal(const vecText& text,
+                             std::vector<float>& advances,
+                             std::vector<float>& overhangs);
   float GetCharWidthInternal(character_t ch);
   float GetTextHeight(float lineSpacing, int numLines) const;
   float GetTextBaseLine() const { return static_cast<float>(m_cellBaseLine); }
@@ -175,6 +208,17 @@ protected:
                        bool roundX,
                        std::vector<SVertex>& vertices);
   void ClearCharacterCache();
+  void UpdateQuickAccess();
+
+  /*! \brief restore the characters cached in an earlier run
+   \return true if the character cache was replaced
+   */
+  bool LoadCharacterCache();
+  void SaveCharacterCache();
+  std::string GetCharacterCachePath() const;
+
+  /*! \brief cache a few of the common characters ahead of their first use */
+  void WarmupCharacters();
 
   virtual std::unique_ptr<CTexture> ReallocTexture(unsigned int& newHeight) = 0;
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph,
@@ -215,6 +259,12 @@ protected:
 
   unsigned int m_nestedBeginCount{0}; // speedups
 
+  std::string m_fontPath; // file the font was loaded from
+  int m_savedChars{0}; // number of characters in the cache file
+  wchar_t m_warmupLetter{0}; // next letter to cache ahead, 0 when done
+  unsigned int m_warmupFrameTime{0};
+  unsigned int m_warmupBudget{0};
+
   // freetype stuff
   FT_Face m_face{nullptr};
   FT_Stroker m_stroker{nullptr};
@@ -259,6 +309,13 @@ protected:
   CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue> m_staticCache;
   CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue> m_dynamicCache;
 
+  std::unordered_map<vecText, ShapedText, TextHash> m_shapedText;
+  std::list<const vecText*> m_shapedTextOrder; // most recently used first
+  ShapedText m_uncachedText; // texts too long to be worth keeping
+  size_t m_shapedTextGlyphs{0};
+  unsigned int m_shapedTextHits{0};
+  unsigned int m_shapedTextMisses{0};
+
   CRenderSystemBase* m_renderSystem;
 
 private:
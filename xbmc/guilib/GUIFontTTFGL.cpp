@@ -58,6 +58,9 @@ CGUIFontTTFGL::~CGUIFontTTFGL(void)
 
 bool CGUIFontTTFGL::FirstBegin()
 {
+  // textures queued before the text have to be drawn before the font changes render state
+  CServiceBroker::GetRenderSystem()->FlushGUIBatch();
+
 #if defined(HAS_GL)
   GLenum pixformat = GL_RED;
   GLenum internalFormat;
@@ -116,6 +119,7 @@ bool CGUIFontTTFGL::FirstBegin()
   glEnable(GL_BLEND);
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, m_nTexture);
+  CServiceBroker::GetRenderSystem()->AddGUITextureBind(m_nTexture);
 
   return true;
 }
@@ -175,6 +179,7 @@ void CGUIFontTTFGL::LastEnd()
                           reinterpret_cast<const GLvoid*>(offsetof(SVertex, u)));
 
     glDrawArrays(GL_TRIANGLES, 0, vecVertices.size());
+    renderSystem->AddGUIDrawCall();
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDeleteBuffers(1, &VertexVBO);
@@ -226,6 +231,7 @@ void CGUIFontTTFGL::LastEnd()
                           reinterpret_cast<char*>(vertices) + offsetof(SVertex, u));
 
     glDrawArrays(GL_TRIANGLES, 0, vecVertices.size());
+    renderSystem->AddGUIDrawCall();
   }
 #endif
 
@@ -288,6 +294,7 @@ void CGUIFontTTFGL::LastEnd()
             reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
 
         glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+        renderSystem->AddGUIDrawCall();
       }
 
       glMatrixModview.Pop();
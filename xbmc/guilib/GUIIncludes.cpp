@@ -18,6 +18,8 @@
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 using namespace KODI::GUILIB;
 
 CGUIIncludes::CGUIIncludes()
@@ -300,7 +302,9 @@ bool CGUIIncludes::HasLoaded(const std::string &file) const
   return false;
 }
 
-void CGUIIncludes::Resolve(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */)
+void CGUIIncludes::Resolve(TiXmlElement *node,
+                           std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */,
+                           std::vector<std::string>* includeFiles /* = nullptr */)
 {
   if (!node)
     return;
@@ -308,13 +312,13 @@ void CGUIIncludes::Resolve(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xm
   SetDefaults(node);
   ResolveConstants(node);
   ResolveExpressions(node);
-  ResolveIncludes(node, xmlIncludeConditions);
+  ResolveIncludes(node, xmlIncludeConditions, includeFiles);
 
   TiXmlElement *child = node->FirstChildElement();
   while (child)
   {
     // recursive call
-    Resolve(child, xmlIncludeConditions);
+    Resolve(child, xmlIncludeConditions, includeFiles);
     child = child->NextSiblingElement();
   }
 }
@@ -396,7 +400,9 @@ void CGUIIncludes::ResolveExpressions(TiXmlElement *node)
   }
 }
 
-void CGUIIncludes::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */)
+void CGUIIncludes::ResolveIncludes(TiXmlElement *node,
+                                   std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */,
+                                   std::vector<std::string>* includeFiles /* = nullptr */)
 {
   if (!node)
     return;
@@ -407,7 +413,13 @@ void CGUIIncludes::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, b
     // file: load includes from specified XML file
     const char *file = include->Attribute("file");
     if (file)
-      Load(g_SkinInfo->GetSkinPath(file));
+    {
+      const std::string path = g_SkinInfo->GetSkinPath(file);
+      Load(path);
+      if (includeFiles &&
+          std::find(includeFiles->begin(), includeFiles->end(), path) == includeFiles->end())
+        includeFiles->push_back(path);
+    }
 
     // condition: process include if condition evals to true
     const char *condition = include->Attribute("condition");
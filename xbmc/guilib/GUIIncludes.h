@@ -49,8 +49,18 @@ public:
 
    \param node the node from where we start to resolve the include components
    \param includeConditions a map that holds the conditions for resolved includes
+   \param includeFiles the include files loaded by <include file="..."> elements
    */
-  void Resolve(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* includeConditions = NULL);
+  void Resolve(TiXmlElement *node,
+               std::map<INFO::InfoPtr, bool>* includeConditions = NULL,
+               std::vector<std::string>* includeFiles = nullptr);
+
+  /*!
+   \brief Get the include files that have been loaded, in load order.
+
+   \return the paths of the loaded files
+   */
+  const std::vector<std::string>& GetFiles() const { return m_files; }
 
   /*!
    \brief Create a skin variable for the given \code{name} within the given \code{context}.
@@ -105,7 +115,9 @@ private:
   void FlattenSkinVariableConditions();
 
   void SetDefaults(TiXmlElement *node);
-  void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
+  void ResolveIncludes(TiXmlElement *node,
+                       std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL,
+                       std::vector<std::string>* includeFiles = nullptr);
   void ResolveConstants(TiXmlElement *node);
   void ResolveExpressions(TiXmlElement *node);
 
@@ -0,0 +1,440 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUISkinCache.h"
+
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "addons/Skin.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/GUIComponent.h"
+#include "utils/Digest.h"
+#include "utils/URIUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+using namespace KODI::UTILITY;
+
+namespace
+{
+constexpr const char* SKIN_CACHE_PATH = "special://temp/skincache/";
+constexpr uint32_t SKIN_CACHE_MAGIC = 0x43534b4b; // "KKSC"
+constexpr uint32_t SKIN_CACHE_VERSION = 2;
+
+enum NodeType : uint8_t
+{
+  NODE_ELEMENT = 0,
+  NODE_TEXT,
+  NODE_CDATA
+};
+
+std::string GetCachePath(const std::string& path)
+{
+  return URIUtils::AddFileToFolder(SKIN_CACHE_PATH,
+                                   CDigest::Calculate(CDigest::Type::MD5, path) + ".bin");
+}
+
+struct FileStamp
+{
+  std::string path;
+  int64_t time;
+  uint64_t size;
+};
+
+bool GetFileStamp(const std::string& path, FileStamp& stamp)
+{
+  struct __stat64 stat;
+  if (XFILE::CFile::Stat(path, &stat) != 0)
+    return false;
+
+  stamp = {path, static_cast<int64_t>(stat.st_mtime), static_cast<uint64_t>(stat.st_size)};
+  return true;
+}
+
+/*!
+ \brief Writes the cache file, strings are stored once and referred to by index.
+ */
+class CWriter
+{
+public:
+  void Write(uint8_t value) { m_data.push_back(static_cast<char>(value)); }
+  void Write(uint32_t value) { m_data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  void Write(uint64_t value) { m_data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  void Write(int64_t value) { m_data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  void WriteString(const std::string& value)
+  {
+    Write(static_cast<uint32_t>(value.size()));
+    m_data.append(value);
+  }
+  void WriteStrings(const std::vector<std::string>& values)
+  {
+    Write(static_cast<uint32_t>(values.size()));
+    for (const auto& value : values)
+      WriteString(value);
+  }
+
+  void WriteNode(const TiXmlNode& node)
+  {
+    if (node.Type() == TiXmlNode::TINYXML_TEXT)
+    {
+      Write(static_cast<uint8_t>(node.ToText()->CDATA() ? NODE_CDATA : NODE_TEXT));
+      WriteIndex(node.ValueStr());
+      return;
+    }
+
+    Write(static_cast<uint8_t>(NODE_ELEMENT));
+    WriteIndex(node.ValueStr());
+
+    const TiXmlElement* element = node.ToElement();
+    uint32_t attributes = 0;
+    for (const TiXmlAttribute* attribute = element->FirstAttribute(); attribute;
+         attribute = attribute->Next())
+      attributes++;
+    Write(attributes);
+    for (const TiXmlAttribute* attribute = element->FirstAttribute(); attribute;
+         attribute = attribute->Next())
+    {
+      WriteIndex(attribute->NameTStr());
+      WriteIndex(attribute->ValueStr());
+    }
+
+    // comments and the like are not needed to create the controls
+    uint32_t children = 0;
+    for (const TiXmlNode* child = node.FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+        children++;
+    }
+    Write(children);
+    for (const TiXmlNode* child = node.FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+        WriteNode(*child);
+    }
+  }
+
+  //! the string table followed by the nodes
+  std::string Finish() const
+  {
+    CWriter table;
+    table.Write(static_cast<uint32_t>(m_strings.size()));
+    for (const auto& string : m_strings)
+      table.WriteString(*string);
+    return table.m_data + m_data;
+  }
+
+  const std::string& GetData() const { return m_data; }
+
+private:
+  void WriteIndex(const std::string& value)
+  {
+    auto it = m_index.find(value);
+    if (it == m_index.end())
+    {
+      it = m_index.emplace(value, static_cast<uint32_t>(m_strings.size())).first;
+      m_strings.push_back(&it->first);
+    }
+    Write(it->second);
+  }
+
+  std::string m_data;
+  std::unordered_map<std::string, uint32_t> m_index;
+  std::vector<const std::string*> m_strings;
+};
+
+class CReader
+{
+public:
+  CReader(const std::vector<uint8_t>& data) : m_data(data) {}
+
+  template<typename T>
+  bool Read(T& value)
+  {
+    if (m_data.size() - m_pos < sizeof(T))
+      return false;
+    std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string& value)
+  {
+    uint32_t size;
+    if (!Read(size) || m_data.size() - m_pos < size)
+      return false;
+    value.assign(reinterpret_cast<const char*>(m_data.data() + m_pos), size);
+    m_pos += size;
+    return true;
+  }
+
+  bool ReadStrings(std::vector<std::string>& values)
+  {
+    uint32_t count;
+    if (!Read(count) || count > m_data.size() - m_pos)
+      return false;
+    values.resize(count);
+    for (auto& value : values)
+    {
+      if (!ReadString(value))
+        return false;
+    }
+    return true;
+  }
+
+  bool ReadStringTable() { return ReadStrings(m_strings); }
+
+  std::unique_ptr<TiXmlNode> ReadNode(unsigned int depth = 0)
+  {
+    uint8_t type;
+    const std::string* value;
+    if (depth > 256 || !Read(type) || !ReadIndex(value))
+      return nullptr;
+
+    if (type == NODE_TEXT || type == NODE_CDATA)
+    {
+      std::unique_ptr<TiXmlText> text(new TiXmlText(*value));
+      text->SetCDATA(type == NODE_CDATA);
+      return std::move(text);
+    }
+    if (type != NODE_ELEMENT)
+      return nullptr;
+
+    std::unique_ptr<TiXmlElement> element(new TiXmlElement(*value));
+    uint32_t attributes;
+    if (!Read(attributes))
+      return nullptr;
+    for (uint32_t i = 0; i < attributes; i++)
+    {
+      const std::string* name;
+      const std::string* attribute;
+      if (!ReadIndex(name) || !ReadIndex(attribute))
+        return nullptr;
+      element->SetAttribute(*name, *attribute);
+    }
+
+    uint32_t children;
+    if (!Read(children))
+      return nullptr;
+    for (uint32_t i = 0; i < children; i++)
+    {
+      std::unique_ptr<TiXmlNode> child = ReadNode(depth + 1);
+      if (!child)
+        return nullptr;
+      element->LinkEndChild(child.release());
+    }
+    return std::move(element);
+  }
+
+private:
+  bool ReadIndex(const std::string*& value)
+  {
+    uint32_t index;
+    if (!Read(index) || index >= m_strings.size())
+      return false;
+    value = &m_strings[index];
+    return true;
+  }
+
+  const std::vector<uint8_t>& m_data;
+  size_t m_pos = 0;
+  std::vector<std::string> m_strings;
+};
+
+std::unique_ptr<TiXmlElement> DecodeTree(CReader& reader)
+{
+  if (!reader.ReadStringTable())
+    return nullptr;
+
+  std::unique_ptr<TiXmlNode> root = reader.ReadNode();
+  if (!root || !root->ToElement())
+    return nullptr;
+
+  return std::unique_ptr<TiXmlElement>(static_cast<TiXmlElement*>(root.release()));
+}
+
+} // namespace
+
+std::unique_ptr<TiXmlElement> CGUISkinCache::Load(const std::string& path,
+                                                  std::map<INFO::InfoPtr, bool>& includeConditions,
+                                                  std::vector<std::string>& includeFiles)
+{
+  Entry entry;
+  if (!Read(path, entry))
+    return nullptr;
+
+  return Use(entry, includeConditions, includeFiles);
+}
+
+bool CGUISkinCache::Read(const std::string& path, Entry& entry)
+{
+  std::vector<uint8_t> data;
+  XFILE::CFile file;
+  if (file.LoadFile(GetCachePath(path), data) <= 0)
+    return false;
+
+  CReader reader(data);
+  uint32_t magic, version;
+  std::string windowPath;
+  if (!reader.Read(magic) || magic != SKIN_CACHE_MAGIC || !reader.Read(version) ||
+      version != SKIN_CACHE_VERSION || !reader.ReadString(entry.skinId) ||
+      !reader.ReadString(entry.skinVersion) || !reader.ReadString(windowPath) ||
+      windowPath != path)
+    return false;
+
+  // the window and every include file must be unchanged
+  uint32_t files;
+  if (!reader.Read(files))
+    return false;
+  for (uint32_t i = 0; i < files; i++)
+  {
+    FileStamp cached, current;
+    if (!reader.ReadString(cached.path) || !reader.Read(cached.time) || !reader.Read(cached.size))
+      return false;
+    if (!GetFileStamp(cached.path, current) || current.time != cached.time ||
+        current.size != cached.size)
+    {
+      CLog::Log(LOGDEBUG, "CGUISkinCache::{} - {} changed, not using cache for {}", __FUNCTION__,
+                cached.path, path);
+      return false;
+    }
+  }
+
+  uint32_t count;
+  if (!reader.Read(count) || count > data.size())
+    return false;
+  entry.includeConditions.resize(count);
+  for (auto& condition : entry.includeConditions)
+  {
+    uint8_t value;
+    if (!reader.ReadString(condition.first) || !reader.Read(value))
+      return false;
+    condition.second = value != 0;
+  }
+
+  if (!reader.ReadStrings(entry.skinIncludeFiles) ||
+      !reader.ReadStrings(entry.windowIncludeFiles))
+    return false;
+
+  entry.root = DecodeTree(reader);
+  if (!entry.root)
+  {
+    CLog::Log(LOGERROR, "CGUISkinCache::{} - invalid cache for {}", __FUNCTION__, path);
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<TiXmlElement> CGUISkinCache::Use(Entry& entry,
+                                                 std::map<INFO::InfoPtr, bool>& includeConditions,
+                                                 std::vector<std::string>& includeFiles)
+{
+  if (!entry.root || !g_SkinInfo || entry.skinId != g_SkinInfo->ID() ||
+      entry.skinVersion != g_SkinInfo->Version().asString())
+    return nullptr;
+
+  // conditional <include file> elements of includes.xml may have loaded other files
+  if (entry.skinIncludeFiles != g_SkinInfo->GetSkinIncludeFiles())
+    return nullptr;
+
+  // the includes must resolve the same way
+  std::map<INFO::InfoPtr, bool> conditions;
+  for (const auto& condition : entry.includeConditions)
+  {
+    INFO::InfoPtr info = CServiceBroker::GetGUI()->GetInfoManager().Register(condition.first);
+    if (!info || info->Get() != condition.second)
+      return nullptr;
+    conditions.insert(std::make_pair(info, condition.second));
+  }
+
+  // the variables and expressions of the window's own include files are needed by its controls
+  for (const auto& file : entry.windowIncludeFiles)
+    g_SkinInfo->LoadIncludeFile(file);
+
+  includeConditions = std::move(conditions);
+  includeFiles = std::move(entry.windowIncludeFiles);
+  return std::move(entry.root);
+}
+
+bool CGUISkinCache::Save(const std::string& path,
+                         const TiXmlElement& root,
+                         const std::map<INFO::InfoPtr, bool>& includeConditions,
+                         const std::vector<std::string>& includeFiles)
+{
+  if (!g_SkinInfo)
+    return false;
+
+  std::vector<FileStamp> files(1);
+  if (!GetFileStamp(path, files[0]))
+    return false;
+  for (const auto& include : g_SkinInfo->GetIncludeFiles())
+  {
+    FileStamp stamp;
+    if (GetFileStamp(include, stamp))
+      files.push_back(stamp);
+  }
+
+  CWriter header;
+  header.Write(SKIN_CACHE_MAGIC);
+  header.Write(SKIN_CACHE_VERSION);
+  header.WriteString(g_SkinInfo->ID());
+  header.WriteString(g_SkinInfo->Version().asString());
+  header.WriteString(path);
+  header.Write(static_cast<uint32_t>(files.size()));
+  for (const auto& stamp : files)
+  {
+    header.WriteString(stamp.path);
+    header.Write(stamp.time);
+    header.Write(stamp.size);
+  }
+  header.Write(static_cast<uint32_t>(includeConditions.size()));
+  for (const auto& condition : includeConditions)
+  {
+    header.WriteString(condition.first->GetExpression());
+    header.Write(static_cast<uint8_t>(condition.second ? 1 : 0));
+  }
+  header.WriteStrings(g_SkinInfo->GetSkinIncludeFiles());
+  header.WriteStrings(includeFiles);
+
+  const std::string data = header.GetData() + Encode(root);
+
+  // the window manager reads entries ahead on a job thread, only complete files may show up
+  const std::string cachePath = GetCachePath(path);
+  const std::string tempPath = cachePath + ".tmp";
+  XFILE::CDirectory::Create(SKIN_CACHE_PATH);
+  XFILE::CFile file;
+  bool written = file.OpenForWrite(tempPath, true) &&
+                 file.Write(data.data(), data.size()) == static_cast<ssize_t>(data.size());
+  file.Close();
+  // renaming doesn't replace an existing file on every platform
+  if (written && !XFILE::CFile::Rename(tempPath, cachePath))
+    written = XFILE::CFile::Delete(cachePath) && XFILE::CFile::Rename(tempPath, cachePath);
+  if (!written)
+  {
+    CLog::Log(LOGDEBUG, "CGUISkinCache::{} - unable to write cache for {}", __FUNCTION__, path);
+    XFILE::CFile::Delete(tempPath);
+  }
+  return written;
+}
+
+std::string CGUISkinCache::Encode(const TiXmlElement& root)
+{
+  CWriter nodes;
+  nodes.WriteNode(root);
+  return nodes.Finish();
+}
+
+std::unique_ptr<TiXmlElement> CGUISkinCache::Decode(const std::vector<uint8_t>& data)
+{
+  CReader reader(data);
+  return DecodeTree(reader);
+}
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/info/InfoBool.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TiXmlElement;
+
+/*!
+ \ingroup window
+ \brief Keeps window XML with includes, constants and expressions resolved on disk.
+
+ Loading a window from the cache skips parsing the skin files and resolving the includes. An
+ entry is used as long as the skin, the include files loaded with the skin, the modification
+ times of the window and include files and the values of the conditions the includes were
+ resolved with are the same. Include files the window refers to itself are loaded when the entry
+ is used, as the variables and expressions they define are needed when creating the controls.
+ */
+class CGUISkinCache
+{
+public:
+  /*! \brief an entry as read from disk, not yet checked against the current skin */
+  struct Entry
+  {
+    std::string skinId;
+    std::string skinVersion;
+    std::unique_ptr<TiXmlElement> root;
+    std::vector<std::pair<std::string, bool>> includeConditions;
+    std::vector<std::string> skinIncludeFiles;
+    std::vector<std::string> windowIncludeFiles;
+  };
+
+  /*! \brief load the resolved XML of a window
+   \param path the window XML file
+   \param includeConditions [out] the conditions the includes were resolved with
+   \param includeFiles [out] the include files the window refers to
+   \return the root element, nullptr if there is no valid entry
+   */
+  static std::unique_ptr<TiXmlElement> Load(const std::string& path,
+                                            std::map<INFO::InfoPtr, bool>& includeConditions,
+                                            std::vector<std::string>& includeFiles);
+
+  /*! \brief read the entry of a window, may be called from any thread
+   \param path the window XML file
+   \param entry [out] the entry, if the window and include files haven't changed since it was
+   written
+   \return true if there is an entry
+   */
+  static bool Read(const std::string& path, Entry& entry);
+
+  /*! \brief check an entry against the skin and the include conditions, must be called from the
+   gui thread
+   \param entry the entry to use, its root is taken
+   \param includeConditions [out] the conditions the includes were resolved with
+   \param includeFiles [out] the include files the window refers to, loaded into the skin
+   \return the root element, nullptr if the entry is not valid anymore
+   */
+  static std::unique_ptr<TiXmlElement> Use(Entry& entry,
+                                           std::map<INFO::InfoPtr, bool>& includeConditions,
+                                           std::vector<std::string>& includeFiles);
+
+  /*! \brief store the resolved XML of a window
+   The entry is written to a temporary file first, so Read never sees a partly written entry.
+   \param path the window XML file
+   \param root the root element after resolving the includes
+   \param includeConditions the conditions the includes were resolved with
+   \param includeFiles the include files the window refers to
+   \return true if the entry was written
+   */
+  static bool Save(const std::string& path,
+                   const TiXmlElement& root,
+                   const std::map<INFO::InfoPtr, bool>& includeConditions,
+                   const std::vector<std::string>& includeFiles);
+
+  /*! \brief encode a tree as stored in the cache, only elements, attributes and text are kept
+   \param root the root element
+   \return the encoded tree
+   */
+  static std::string Encode(const TiXmlElement& root);
+
+  /*! \brief decode a tree written by Encode
+   \param data the encoded tree
+   \return the root element, nullptr if the data is invalid
+   */
+  static std::unique_ptr<TiXmlElement> Decode(const std::vector<uint8_t>& data);
+};
@@ -547,6 +547,11 @@ void CGUITextLayout::WrapText(const vecText &text, float maxWidth)
   std::vector<CGUIString> lines;
   LineBreakText(text, lines);
 
+  // each line is shaped once and the candidates are measured from its character widths,
+  // measuring them with GetTextWidth would push the texts being drawn out of the font's cache
+  std::vector<float> advances;
+  std::vector<float> overhangs;
+
   for (unsigned int i = 0; i < lines.size(); i++)
   {
     const CGUIString &line = lines[i];
@@ -554,6 +559,14 @@ void CGUITextLayout::WrapText(const vecText &text, float maxWidth)
     vecText::const_iterator pos = line.m_text.begin();
     unsigned int lastSpaceInLine = 0;
     vecText curLine;
+    float curLineAdvance = 0;
+    m_font->GetCharWidths(line.m_text, advances, overhangs);
+    // width of curLine, which always ends right before pos
+    auto curLineWidth = [&]() {
+      if (curLine.empty())
+        return 0.0f;
+      return curLineAdvance + overhangs[pos - line.m_text.begin() - 1];
+    };
     while (pos != line.m_text.end())
     {
       // Get the current letter in the string
@@ -561,7 +574,7 @@ void CGUITextLayout::WrapText(const vecText &text, float maxWidth)
       // check for a space
       if (CanWrapAtLetter(letter))
       {
-        float width = m_font->GetTextWidth(curLine);
+        float width = curLineWidth();
         if (width > maxWidth)
         {
           if (lastSpace != line.m_text.begin() && lastSpaceInLine > 0)
@@ -576,6 +589,7 @@ void CGUITextLayout::WrapText(const vecText &text, float maxWidth)
             while (pos != line.m_text.end() && IsSpace(*pos))
               ++pos;
             curLine.clear();
+            curLineAdvance = 0;
             lastSpaceInLine = 0;
             lastSpace = line.m_text.begin();
             continue;
@@ -585,10 +599,11 @@ void CGUITextLayout::WrapText(const vecText &text, float maxWidth)
         lastSpaceInLine = curLine.size();
       }
       curLine.push_back(letter);
+      curLineAdvance += advances[pos - line.m_text.begin()];
       ++pos;
     }
     // now add whatever we have left to the string
-    float width = m_font->GetTextWidth(curLine);
+    float width = curLineWidth();
     if (width > maxWidth)
     {
       // too long - put up to the last space on if we can + remove it from what's left.
@@ -265,6 +265,7 @@ void CGUITexture::Render(float left,
 
   int orientation = GetOrientation();
   OrientateTexture(texture, u3, v3, orientation);
+  MapToAtlas(texture, m_texture.m_atlasCoords[m_currentFrame]);
 
   if (m_diffuse.size())
   {
@@ -274,6 +275,7 @@ void CGUITexture::Render(float left,
     diffuse.y1 *= m_diffuseScaleV / v3; diffuse.y2 *= m_diffuseScaleV / v3;
     diffuse += m_diffuseOffset;
     OrientateTexture(diffuse, m_diffuseU, m_diffuseV, m_info.orientation);
+    MapToAtlas(diffuse, m_diffuse.m_atlasCoords[0]);
   }
 
   float x[4], y[4], z[4];
@@ -613,6 +615,17 @@ void CGUITexture::OrientateTexture(CRect& rect, float width, float height, int o
   }
 }
 
+void CGUITexture::MapToAtlas(CRect& rect, const CRect& atlasCoords)
+{
+  if (atlasCoords.IsEmpty())
+    return;
+
+  rect.x1 = atlasCoords.x1 + rect.x1 * atlasCoords.Width();
+  rect.x2 = atlasCoords.x1 + rect.x2 * atlasCoords.Width();
+  rect.y1 = atlasCoords.y1 + rect.y1 * atlasCoords.Height();
+  rect.y2 = atlasCoords.y1 + rect.y2 * atlasCoords.Height();
+}
+
 void CGUITexture::ResetAnimState()
 {
   m_lasttime = 0;
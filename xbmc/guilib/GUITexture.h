@@ -145,6 +145,7 @@ protected:
               float u3,
               float v3);
   static void OrientateTexture(CRect &rect, float width, float height, int orientation);
+  static void MapToAtlas(CRect& rect, const CRect& atlasCoords);
   void ResetAnimState();
 
   // functions that our implementation classes handle
@@ -9,7 +9,7 @@
 #include "GUITextureGL.h"
 
 #include "ServiceBroker.h"
-#include "Texture.h"
+#include "TextureGL.h"
 #include "rendering/gl/RenderSystemGL.h"
 #include "utils/GLUtils.h"
 #include "utils/Geometry.h"
@@ -48,114 +48,45 @@ void CGUITextureGL::Begin(UTILS::COLOR::Color color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
-  texture->BindToUnit(0);
+  m_batchState.texture0 = static_cast<CGLTexture*>(texture)->GetTextureObject();
+  m_batchState.texture1 = 0;
 
   // Setup Colors
-  m_col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
-  m_col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
-  m_col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
-  m_col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
+  std::array<GLubyte, 4>& col = m_batchState.color;
+  col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
+  col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
+  col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
+  col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
 
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  const bool opaqueColor = col[0] == 255 && col[1] == 255 && col[2] == 255 && col[3] == 255;
+  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || col[3] < 255;
 
   if (m_diffuse.size())
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255 )
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_MULTI);
-    }
-    else
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_MULTI_BLENDCOLOR);
-    }
+    m_batchState.method =
+        opaqueColor ? ShaderMethodGL::SM_MULTI : ShaderMethodGL::SM_MULTI_BLENDCOLOR;
 
     hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
 
-    m_diffuse.m_textures[0]->BindToUnit(1);
+    m_batchState.texture1 =
+        static_cast<CGLTexture*>(m_diffuse.m_textures[0].get())->GetTextureObject();
   }
   else
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255)
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_TEXTURE_NOBLEND);
-    }
-    else
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_TEXTURE);
-    }
+    m_batchState.method =
+        opaqueColor ? ShaderMethodGL::SM_TEXTURE_NOBLEND : ShaderMethodGL::SM_TEXTURE;
   }
 
-  if (hasAlpha)
-  {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable(GL_BLEND);
-  }
-  else
-  {
-    glDisable(GL_BLEND);
-  }
+  m_batchState.blend = hasAlpha;
   m_packedVertices.clear();
-  m_idx.clear();
 }
 
 void CGUITextureGL::End()
 {
+  // the render system draws the quads together with those of the textures following
+  // this one if they share the state
   if (m_packedVertices.size())
-  {
-    GLint posLoc  = m_renderSystem->ShaderGetPos();
-    GLint tex0Loc = m_renderSystem->ShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->ShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->ShaderGetUniCol();
-
-    GLuint VertexVBO;
-    GLuint IndexVBO;
-
-    glGenBuffers(1, &VertexVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VertexVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex)*m_packedVertices.size(), &m_packedVertices[0], GL_STATIC_DRAW);
-
-    if (uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
-
-    if (m_diffuse.size())
-    {
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                            reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u2)));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
-                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, x)));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u1)));
-    glEnableVertexAttribArray(tex0Loc);
-
-    glGenBuffers(1, &IndexVBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IndexVBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(ushort)*m_idx.size(), m_idx.data(), GL_STATIC_DRAW);
-
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, 0);
-
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
-
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glDeleteBuffers(1, &VertexVBO);
-    glDeleteBuffers(1, &IndexVBO);
-  }
-
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
-
-  m_renderSystem->DisableShader();
+    m_renderSystem->AddGUIQuads(m_batchState, m_packedVertices.data(), m_packedVertices.size());
 }
 
 void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -237,17 +168,6 @@ void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, con
     vertices[i].z = z[i];
     m_packedVertices.push_back(vertices[i]);
   }
-
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
 }
 
 void CGUITextureGL::DrawQuad(const CRect& rect,
@@ -256,10 +176,12 @@ void CGUITextureGL::DrawQuad(const CRect& rect,
                              const CRect* texCoords)
 {
   CRenderSystemGL *renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+  renderSystem->FlushGUIBatch();
   if (texture)
   {
     texture->LoadToGPU();
     texture->BindToUnit(0);
+    renderSystem->AddGUITextureBind(static_cast<CGLTexture*>(texture)->GetTextureObject());
   }
 
   glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
@@ -344,6 +266,7 @@ void CGUITextureGL::DrawQuad(const CRect& rect,
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLubyte)*4, idx, GL_STATIC_DRAW);
 
   glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, 0);
+  renderSystem->AddGUIDrawCall();
 
   glDisableVertexAttribArray(posLoc);
   if (texture)
@@ -9,14 +9,13 @@
 #pragma once
 
 #include "GUITexture.h"
+#include "rendering/gl/RenderSystemGL.h"
 #include "utils/ColorUtils.h"
 
-#include <array>
+#include <vector>
 
 #include "system_gl.h"
 
-class CRenderSystemGL;
-
 class CGUITextureGL : public CGUITexture
 {
 public:
@@ -42,17 +41,10 @@ protected:
 private:
   CGUITextureGL(const CGUITextureGL& texture) = default;
 
-  std::array<GLubyte, 4> m_col;
-
-  struct PackedVertex
-  {
-    float x, y, z;
-    float u1, v1;
-    float u2, v2;
-  };
+  typedef CRenderSystemGL::GUIVertex PackedVertex;
 
+  CRenderSystemGL::GUIBatchState m_batchState;
   std::vector<PackedVertex> m_packedVertices;
-  std::vector<GLushort> m_idx;
   CRenderSystemGL *m_renderSystem;
 };
 
@@ -9,8 +9,7 @@
 #include "GUITextureGLES.h"
 
 #include "ServiceBroker.h"
-#include "Texture.h"
-#include "rendering/gles/RenderSystemGLES.h"
+#include "TextureGL.h"
 #include "utils/GLUtils.h"
 #include "utils/MathUtils.h"
 #include "utils/log.h"
@@ -49,100 +48,52 @@ void CGUITextureGLES::Begin(UTILS::COLOR::Color color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
-  texture->BindToUnit(0);
+  m_batchState.texture0 = static_cast<CGLTexture*>(texture)->GetTextureObject();
+  m_batchState.texture1 = 0;
 
   // Setup Colors
-  m_col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
-  m_col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
-  m_col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
-  m_col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
+  std::array<GLubyte, 4>& col = m_batchState.color;
+  col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
+  col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
+  col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
+  col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
 
   if (CServiceBroker::GetWinSystem()->UseLimitedColor())
   {
-    m_col[0] = (235 - 16) * m_col[0] / 255 + 16;
-    m_col[1] = (235 - 16) * m_col[1] / 255 + 16;
-    m_col[2] = (235 - 16) * m_col[2] / 255 + 16;
+    col[0] = (235 - 16) * col[0] / 255 + 16;
+    col[1] = (235 - 16) * col[1] / 255 + 16;
+    col[2] = (235 - 16) * col[2] / 255 + 16;
   }
 
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  const bool opaqueColor = col[0] == 255 && col[1] == 255 && col[2] == 255 && col[3] == 255;
+  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || col[3] < 255;
 
   if (m_diffuse.size())
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255 )
-    {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI);
-    }
-    else
-    {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_BLENDCOLOR);
-    }
+    m_batchState.method =
+        opaqueColor ? ShaderMethodGLES::SM_MULTI : ShaderMethodGLES::SM_MULTI_BLENDCOLOR;
 
     hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
 
-    m_diffuse.m_textures[0]->BindToUnit(1);
-
+    m_batchState.texture1 =
+        static_cast<CGLTexture*>(m_diffuse.m_textures[0].get())->GetTextureObject();
   }
   else
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255)
-    {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_NOBLEND);
-    }
-    else
-    {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE);
-    }
+    m_batchState.method =
+        opaqueColor ? ShaderMethodGLES::SM_TEXTURE_NOBLEND : ShaderMethodGLES::SM_TEXTURE;
   }
 
-  if ( hasAlpha )
-  {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable( GL_BLEND );
-  }
-  else
-  {
-    glDisable(GL_BLEND);
-  }
+  m_batchState.blend = hasAlpha;
   m_packedVertices.clear();
 }
 
 void CGUITextureGLES::End()
 {
+  // the render system draws the quads together with those of the textures following
+  // this one if they share the state
   if (m_packedVertices.size())
-  {
-    GLint posLoc  = m_renderSystem->GUIShaderGetPos();
-    GLint tex0Loc = m_renderSystem->GUIShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->GUIShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->GUIShaderGetUniCol();
-
-    if(uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
-
-    if(m_diffuse.size())
-    {
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u2));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, x));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u1));
-    glEnableVertexAttribArray(tex0Loc);
-
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, m_idx.data());
-
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
-
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-  }
-
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
-  m_renderSystem->DisableGUIShader();
+    m_renderSystem->AddGUIQuads(m_batchState, m_packedVertices.data(), m_packedVertices.size());
 }
 
 void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -218,17 +169,6 @@ void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, c
     vertices[i].z = z[i];
     m_packedVertices.push_back(vertices[i]);
   }
-
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
 }
 
 void CGUITextureGLES::DrawQuad(const CRect& rect,
@@ -237,10 +177,12 @@ void CGUITextureGLES::DrawQuad(const CRect& rect,
                                const CRect* texCoords)
 {
   CRenderSystemGLES *renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+  renderSystem->FlushGUIBatch();
   if (texture)
   {
     texture->LoadToGPU();
     texture->BindToUnit(0);
+    renderSystem->AddGUITextureBind(static_cast<CGLTexture*>(texture)->GetTextureObject());
   }
 
   glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
@@ -294,6 +236,7 @@ void CGUITextureGLES::DrawQuad(const CRect& rect,
     tex[2][1] = tex[3][1] = coords.y2;
   }
   glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, idx);
+  renderSystem->AddGUIDrawCall();
 
   glDisableVertexAttribArray(posLoc);
   if (texture)
@@ -9,23 +9,16 @@
 #pragma once
 
 #include "GUITexture.h"
+#include "rendering/gles/RenderSystemGLES.h"
 #include "utils/ColorUtils.h"
 
-#include <array>
 #include <vector>
 
 #include "system_gl.h"
 
-struct PackedVertex
-{
-  float x, y, z;
-  float u1, v1;
-  float u2, v2;
-};
+typedef CRenderSystemGLES::GUIVertex PackedVertex;
 typedef std::vector<PackedVertex> PackedVertices;
 
-class CRenderSystemGLES;
-
 class CGUITextureGLES : public CGUITexture
 {
 public:
@@ -51,10 +44,8 @@ protected:
 private:
   CGUITextureGLES(const CGUITextureGLES& texture) = default;
 
-  std::array<GLubyte, 4> m_col;
-
+  CRenderSystemGLES::GUIBatchState m_batchState;
   PackedVertices m_packedVertices;
-  std::vector<GLushort> m_idx;
   CRenderSystemGLES *m_renderSystem;
 };
 
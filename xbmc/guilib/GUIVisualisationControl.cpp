@@ -23,9 +23,13 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace ADDON;
 
 #define LABEL_ROW1 10
@@ -63,6 +67,12 @@ void CAudioBuffer::Set(const float* psBuffer, int iSize)
     m_pBuffer[i] = 0;
 }
 
+void CAudioBuffer::SetSpectrum(const CAESpectrum& spectrum)
+{
+  m_freq.assign(spectrum.GetMagnitudes(), spectrum.GetMagnitudes() + spectrum.GetSize());
+  m_bands = spectrum.GetBands();
+}
+
 CGUIVisualisationControl::CGUIVisualisationControl(int parentID, int controlID, float posX, float posY, float width, float height)
   : CGUIControl(parentID, controlID, posX, posY, width, height),
     m_callStart(false),
@@ -242,6 +252,20 @@ void CGUIVisualisationControl::OnInitialize(int channels, int samplesPerSec, int
 }
 
 void CGUIVisualisationControl::OnAudioData(const float* audioData, unsigned int audioDataLength)
+{
+  AddAudioData(audioData, audioDataLength, nullptr);
+}
+
+void CGUIVisualisationControl::OnAudioSpectrum(const float* audioData,
+                                               unsigned int audioDataLength,
+                                               const CAESpectrum& spectrum)
+{
+  AddAudioData(audioData, audioDataLength, &spectrum);
+}
+
+void CGUIVisualisationControl::AddAudioData(const float* audioData,
+                                            unsigned int audioDataLength,
+                                            const CAESpectrum* spectrum)
 {
   if (!m_instance || !m_alreadyStarted || !audioData || audioDataLength == 0)
     return;
@@ -249,6 +273,9 @@ void CGUIVisualisationControl::OnAudioData(const float* audioData, unsigned int
   // Save our audio data in the buffers
   std::unique_ptr<CAudioBuffer> pBuffer(new CAudioBuffer(audioDataLength));
   pBuffer->Set(audioData, audioDataLength);
+  // the engine analysed the block already, use it if it is the size we hand on
+  if (spectrum && spectrum->GetSize() == AUDIO_BUFFER_SIZE / 2)
+    pBuffer->SetSpectrum(*spectrum);
   //m_vecBuffers.push_back(pBuffer.release());
   m_vecBuffers.emplace_back(std::move(pBuffer));
 
@@ -258,15 +285,29 @@ void CGUIVisualisationControl::OnAudioData(const float* audioData, unsigned int
   std::unique_ptr<CAudioBuffer> ptrAudioBuffer = std::move(m_vecBuffers.front());
   m_vecBuffers.pop_front();
 
+  if (ptrAudioBuffer->HasSpectrum())
+  {
+    CSingleLock lock(m_bandsLock);
+    m_bands = ptrAudioBuffer->GetBands();
+  }
+
   // Fourier transform the data if the vis wants it...
   if (m_wantsFreq)
   {
     const float *psAudioData = ptrAudioBuffer->Get();
 
-    if (!m_transform)
-      m_transform.reset(new RFFT(AUDIO_BUFFER_SIZE/2, false)); // half due to stereo
+    if (ptrAudioBuffer->HasSpectrum())
+    {
+      std::copy(ptrAudioBuffer->GetFreq(), ptrAudioBuffer->GetFreq() + AUDIO_BUFFER_SIZE / 2,
+                m_freq);
+    }
+    else
+    {
+      if (!m_transform)
+        m_transform.reset(new RFFT(AUDIO_BUFFER_SIZE/2, false)); // half due to stereo
 
-    m_transform->calc(psAudioData, m_freq);
+      m_transform->calc(psAudioData, m_freq);
+    }
 
     // Transfer data to our visualisation
     m_instance->AudioData(psAudioData, ptrAudioBuffer->Size(), m_freq, AUDIO_BUFFER_SIZE/2); // half due to complex-conjugate
@@ -460,4 +501,15 @@ void CGUIVisualisationControl::ClearBuffers()
 
   if (m_transform)
     m_transform.reset();
+
+  CSingleLock lock(m_bandsLock);
+  m_bands.fill(0.0f);
+}
+
+int CGUIVisualisationControl::GetSpectrumBand(unsigned int band)
+{
+  CSingleLock lock(m_bandsLock);
+  if (band >= m_bands.size())
+    return 0;
+  return static_cast<int>(std::lround(m_bands[band] * 100));
 }
@@ -11,8 +11,11 @@
 #include "GUIControl.h"
 #include "addons/Visualization.h"
 #include "cores/AudioEngine/Interfaces/IAudioCallback.h"
+#include "cores/AudioEngine/Utils/AESpectrum.h"
+#include "threads/CriticalSection.h"
 #include "utils/rfft.h"
 
+#include <array>
 #include <list>
 #include <string>
 #include <vector>
@@ -28,12 +31,18 @@ public:
   const float* Get() const;
   int Size() const;
   void Set(const float* psBuffer, int iSize);
+  void SetSpectrum(const CAESpectrum& spectrum);
+  bool HasSpectrum() const { return !m_freq.empty(); }
+  const float* GetFreq() const { return m_freq.data(); }
+  const std::array<float, CAESpectrum::BANDS>& GetBands() const { return m_bands; }
 private:
   CAudioBuffer(const CAudioBuffer&) = delete;
   CAudioBuffer& operator=(const CAudioBuffer&) = delete;
   CAudioBuffer();
   float* m_pBuffer;
   int m_iLen;
+  std::vector<float> m_freq;
+  std::array<float, CAESpectrum::BANDS> m_bands{};
 };
 
 class CGUIVisualisationControl : public CGUIControl, public IAudioCallback
@@ -46,6 +55,9 @@ public:
   // Child functions related to IAudioCallback
   void OnInitialize(int channels, int samplesPerSec, int bitsPerSample) override;
   void OnAudioData(const float* audioData, unsigned int audioDataLength) override;
+  void OnAudioSpectrum(const float* audioData,
+                       unsigned int audioDataLength,
+                       const CAESpectrum& spectrum) override;
 
   // Child functions related to CGUIControl
   void FreeResources(bool immediately = false) override;
@@ -66,11 +78,19 @@ public:
   std::string GetActivePresetName();
   bool GetPresetList(std::vector<std::string>& vecpresets);
 
+  /*!
+   * \brief Level of a band of the spectrum currently shown, 0 to 100.
+   */
+  int GetSpectrumBand(unsigned int band);
+
 private:
   bool InitVisualization();
   void DeInitVisualization();
   inline void CreateBuffers();
   inline void ClearBuffers();
+  void AddAudioData(const float* audioData,
+                    unsigned int audioDataLength,
+                    const CAESpectrum* spectrum);
 
   bool m_callStart;
   bool m_alreadyStarted;
@@ -83,6 +103,8 @@ private:
   float m_freq[AUDIO_BUFFER_SIZE]; /*!< Frequency data */
   std::vector<std::string> m_presets; /*!< cached preset list */
   std::unique_ptr<RFFT> m_transform;
+  std::array<float, CAESpectrum::BANDS> m_bands{}; /*!< band levels of the buffer passed on last */
+  CCriticalSection m_bandsLock;
 
   /* values set from "OnInitialize" IAudioCallback  */
   int m_channels;
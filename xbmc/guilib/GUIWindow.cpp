@@ -15,6 +15,7 @@
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
 #include "GUIInfoManager.h"
+#include "GUISkinCache.h"
 #include "GUIWindowManager.h"
 #include "ServiceBroker.h"
 #include "addons/Skin.h"
@@ -121,9 +122,45 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
   return ret;
 }
 
+std::string CGUIWindow::GetPreloadPath() const
+{
+  if (!g_SkinInfo || m_windowXMLRootElement || (m_loadType != LOAD_EVERY_TIME && !NeedLoad()))
+    return "";
+
+  const std::string xmlFile = GetProperty("xmlfile").asString();
+  if (xmlFile.empty() || xmlFile.find('\\') != std::string::npos ||
+      xmlFile.find('/') != std::string::npos)
+    return xmlFile;
+
+  RESOLUTION_INFO res;
+  return g_SkinInfo->GetSkinPath(xmlFile, &res);
+}
+
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
   // load window xml if we don't have it stored yet
+  if (!m_windowXMLRootElement)
+  {
+    // the window manager may have read it ahead already
+    CGUISkinCache::Entry cached;
+    std::unique_ptr<TiXmlElement> preloadedRoot;
+    if (!CServiceBroker::GetGUI()->GetWindowManager().GetWindowPreloader().Take(strPath, cached,
+                                                                                preloadedRoot))
+      CGUISkinCache::Read(strPath, cached);
+
+    // the resolved xml from a previous run is valid as long as the skin files and the
+    // include conditions haven't changed
+    std::unique_ptr<TiXmlElement> cachedRoot =
+        CGUISkinCache::Use(cached, m_xmlIncludeConditions, m_xmlIncludeFiles);
+    if (cachedRoot)
+    {
+      CLog::Log(LOGDEBUG, "Using cached xml for {}", strPath);
+      return Load(cachedRoot.get());
+    }
+    m_skinCacheSaved = false;
+    m_windowXMLRootElement = preloadedRoot.release();
+  }
+
   if (!m_windowXMLRootElement)
   {
     CXBMCTinyXML xmlDoc;
@@ -151,7 +188,16 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for {}", strPath);
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  // a window loaded every time only has to update the cache when its includes resolved differently
+  std::unique_ptr<TiXmlElement> preparedRoot = Prepare(m_windowXMLRootElement);
+  if (preparedRoot && (!m_skinCacheSaved || m_xmlIncludeConditions != m_savedIncludeConditions))
+  {
+    m_skinCacheSaved =
+        CGUISkinCache::Save(strPath, *preparedRoot, m_xmlIncludeConditions, m_xmlIncludeFiles);
+    m_savedIncludeConditions = m_xmlIncludeConditions;
+  }
+
+  return Load(preparedRoot.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
@@ -164,7 +210,7 @@ std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
 
   // Resolve any includes, constants, expressions that may be present
   // and save include's conditions to the given map
-  g_SkinInfo->ResolveIncludes(preparedRoot.get(), &m_xmlIncludeConditions);
+  g_SkinInfo->ResolveIncludes(preparedRoot.get(), &m_xmlIncludeConditions, &m_xmlIncludeFiles);
 
   return preparedRoot;
 }
@@ -388,11 +434,13 @@ void CGUIWindow::Close_Internal(bool forceClose /*= false*/, int nextWindowID /*
       // Perform the window out effect
       QueueAnimation(ANIM_TYPE_WINDOW_CLOSE);
       m_closing = true;
+      CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_WINDOWS);
     }
     return;
   }
 
   m_closing = false;
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_WINDOWS);
   CGUIMessage msg(GUI_MSG_WINDOW_DEINIT, 0, 0, nextWindowID);
   OnMessage(msg);
 }
@@ -794,6 +842,7 @@ void CGUIWindow::FreeResources(bool forceUnload /*= false */)
     delete m_windowXMLRootElement;
     m_windowXMLRootElement = nullptr;
     m_xmlIncludeConditions.clear();
+    m_xmlIncludeFiles.clear();
   }
 }
 
@@ -881,6 +930,8 @@ bool CGUIWindow::Animate(unsigned int currentTime)
 void CGUIWindow::DisableAnimations()
 {
   m_animationsEnabled = false;
+  // a closing window is no longer animating
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_WINDOWS);
 }
 
 // returns true if the control group with id groupID has controlID as
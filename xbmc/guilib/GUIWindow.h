@@ -66,6 +66,11 @@ public:
   bool Initialize();  // loads the window
   bool Load(const std::string& strFileName, bool bContainsPath = false);
 
+  /*! \brief Get the XML file the window will be loaded from when it is activated next
+   \return the path, empty if the window is loaded and will not be loaded again
+   */
+  std::string GetPreloadPath() const;
+
   void CenterWindow();
 
   void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions) override;
@@ -286,5 +291,8 @@ protected:
 private:
   std::map<std::string, CVariant, icompare> m_mapProperties;
   std::map<INFO::InfoPtr, bool> m_xmlIncludeConditions; ///< \brief used to store conditions used to resolve includes for this window
+  std::vector<std::string> m_xmlIncludeFiles; ///< \brief include files loaded by <include file="..."> elements of this window
+  bool m_skinCacheSaved{false}; ///< \brief the skin cache holds the xml resolved with m_savedIncludeConditions
+  std::map<INFO::InfoPtr, bool> m_savedIncludeConditions;
 };
 
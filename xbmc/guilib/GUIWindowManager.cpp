@@ -151,6 +151,15 @@ using namespace PVR;
 using namespace PERIPHERALS;
 using namespace MESSAGING;
 
+namespace
+{
+// the info manager caches the window conditions until the window state changes
+void InvalidateWindowInfo()
+{
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_WINDOWS);
+}
+} // namespace
+
 CGUIWindowManager::CGUIWindowManager()
 {
   m_pCallback = nullptr;
@@ -613,6 +622,8 @@ void CGUIWindowManager::AddCustomWindow(CGUIWindow* pWindow)
 void CGUIWindowManager::RegisterDialog(CGUIWindow* dialog)
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  // a dialog reopened while closing is still registered, but no longer closing
+  InvalidateWindowInfo();
   // only add the window if it does not exists
   for (const auto& window : m_activeDialogs)
   {
@@ -639,6 +650,7 @@ void CGUIWindowManager::Remove(int id)
                                          [window](CGUIWindow* w){ return w == window; }),
                           m_activeDialogs.end());
     m_mapWindows.erase(it);
+    InvalidateWindowInfo();
   }
   else
   {
@@ -722,6 +734,7 @@ void CGUIWindowManager::PreviousWindow()
 
   // remove the current window off our window stack
   m_windowHistory.pop_back();
+  InvalidateWindowInfo();
 
   // ok, initialize the new window
   CLog::Log(LOGDEBUG,"CGUIWindowManager::PreviousWindow: Activate new");
@@ -862,6 +875,9 @@ void CGUIWindowManager::ActivateWindow_Internal(int iWindowID, const std::vector
   msg.SetStringParams(params);
   pNewWindow->OnMessage(msg);
 //  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetGUIControlsInfoProvider().SetPreviousWindow(WINDOW_INVALID);
+
+  // read ahead the windows likely to be opened from here
+  m_preloader.OnWindowActivated(currentWindow, iWindowID);
 }
 
 void CGUIWindowManager::CloseDialogs(bool forceClose) const
@@ -1414,6 +1430,7 @@ void CGUIWindowManager::DeInitialize()
     pWindow->FreeResources(true);
   }
   UnloadNotOnDemandWindows();
+  m_preloader.Clear();
 
   m_vecMsgTargets.erase( m_vecMsgTargets.begin(), m_vecMsgTargets.end() );
 
@@ -1429,6 +1446,7 @@ void CGUIWindowManager::DeInitialize()
   // clear our vectors of windows
   m_vecCustomWindows.clear();
   m_activeDialogs.clear();
+  InvalidateWindowInfo();
 
   m_initialized = false;
 }
@@ -1442,6 +1460,7 @@ void CGUIWindowManager::RemoveDialog(int id)
                                        m_activeDialogs.end(),
                                        [id](CGUIWindow* dialog) { return dialog->GetID() == id; }),
                          m_activeDialogs.end());
+  InvalidateWindowInfo();
 }
 
 bool CGUIWindowManager::HasModalDialog(bool ignoreClosing) const
@@ -1678,6 +1697,7 @@ void CGUIWindowManager::AddToWindowHistory(int newWindowID)
     // didn't find window in history - add it to the stack
     m_windowHistory.emplace_back(newWindowID);
   }
+  InvalidateWindowInfo();
 }
 
 void CGUIWindowManager::RemoveFromWindowHistory(int windowID)
@@ -1697,6 +1717,7 @@ void CGUIWindowManager::RemoveFromWindowHistory(int windowID)
   {
     history.pop_back(); // remove window from stack
     m_windowHistory.swap(history);
+    InvalidateWindowInfo();
   }
 }
 
@@ -1743,6 +1764,7 @@ void CGUIWindowManager::ClearWindowHistory()
 {
   while (!m_windowHistory.empty())
     m_windowHistory.pop_back();
+  InvalidateWindowInfo();
 }
 
 void CGUIWindowManager::CloseWindowSync(CGUIWindow *window, int nextWindowID /*= 0*/)
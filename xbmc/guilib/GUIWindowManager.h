@@ -10,6 +10,7 @@
 
 #include "DirtyRegionTracker.h"
 #include "GUIWindow.h"
+#include "GUIWindowPreloader.h"
 #include "IMsgTargetCallback.h"
 #include "IWindowManagerCallback.h"
 #include "guilib/WindowIDs.h"
@@ -124,6 +125,10 @@ public:
    */
   bool Initialized() const { return m_initialized; }
 
+  /*! \brief Get the preloader reading ahead the windows likely to be opened next
+   */
+  CGUIWindowPreloader& GetWindowPreloader() { return m_preloader; }
+
   /*! \brief Create and initialize all windows and dialogs
    */
   void CreateWindows();
@@ -282,4 +287,6 @@ private:
 
   CDirtyRegionList m_dirtyregions;
   CDirtyRegionTracker m_tracker;
+
+  CGUIWindowPreloader m_preloader;
 };
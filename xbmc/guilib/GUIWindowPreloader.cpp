@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIWindowPreloader.h"
+
+#include "GUIComponent.h"
+#include "GUIWindow.h"
+#include "GUIWindowManager.h"
+#include "ServiceBroker.h"
+#include "WindowIDs.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr size_t MAX_PRELOAD_WINDOWS = 3;
+
+// opened from home before anything has been learned
+const std::vector<int> HOME_WINDOWS = {WINDOW_VIDEO_NAV, WINDOW_MUSIC_NAV, WINDOW_TV_GUIDE};
+} // namespace
+
+class CGUIWindowPreloader::CPreloadJob : public CJob
+{
+public:
+  explicit CPreloadJob(const std::string& path) : m_path(path) {}
+
+  bool DoWork() override
+  {
+    if (CGUISkinCache::Read(m_path, m_preloaded.cached))
+      return true;
+
+    CXBMCTinyXML xmlDoc;
+    if (!xmlDoc.LoadFile(m_path) || !xmlDoc.RootElement() ||
+        !StringUtils::EqualsNoCase(xmlDoc.RootElement()->Value(), "window"))
+      return false;
+
+    m_preloaded.xml.reset(static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone()));
+    return true;
+  }
+
+  const char* GetType() const override { return "windowpreload"; }
+
+  std::string m_path;
+  Preloaded m_preloaded;
+};
+
+CGUIWindowPreloader::~CGUIWindowPreloader()
+{
+  Clear();
+}
+
+void CGUIWindowPreloader::OnWindowActivated(int previousWindow, int window)
+{
+  if (previousWindow != WINDOW_INVALID && previousWindow != window)
+    m_transitions[previousWindow][window]++;
+
+  // the windows opened from here most often, then the defaults
+  std::vector<std::pair<unsigned int, int>> candidates;
+  const auto it = m_transitions.find(window);
+  if (it != m_transitions.end())
+  {
+    for (const auto& next : it->second)
+      candidates.emplace_back(next.second, next.first);
+  }
+  if (window == WINDOW_HOME)
+  {
+    for (int next : HOME_WINDOWS)
+    {
+      if (std::none_of(candidates.begin(), candidates.end(),
+                       [next](const std::pair<unsigned int, int>& c) { return c.second == next; }))
+        candidates.emplace_back(0, next);
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const std::pair<unsigned int, int>& a, const std::pair<unsigned int, int>& b) {
+                     return a.first > b.first;
+                   });
+
+  std::set<std::string> paths;
+  CGUIWindowManager& windowManager = CServiceBroker::GetGUI()->GetWindowManager();
+  for (const auto& candidate : candidates)
+  {
+    if (paths.size() >= MAX_PRELOAD_WINDOWS)
+      break;
+
+    const CGUIWindow* next = windowManager.GetWindow(candidate.second);
+    if (!next)
+      continue;
+
+    const std::string path = next->GetPreloadPath();
+    if (!path.empty())
+      paths.insert(path);
+  }
+
+  CSingleLock lock(m_critSection);
+
+  // whatever isn't likely to be used from here is dropped again
+  for (auto preloaded = m_preloaded.begin(); preloaded != m_preloaded.end();)
+  {
+    if (paths.find(preloaded->first) == paths.end())
+      preloaded = m_preloaded.erase(preloaded);
+    else
+      ++preloaded;
+  }
+
+  for (const auto& path : paths)
+  {
+    if (m_preloaded.find(path) != m_preloaded.end() || m_pending.find(path) != m_pending.end())
+      continue;
+
+    m_pending[path] =
+        CJobManager::GetInstance().AddJob(new CPreloadJob(path), this, CJob::PRIORITY_LOW);
+  }
+}
+
+bool CGUIWindowPreloader::Take(const std::string& path,
+                               CGUISkinCache::Entry& cached,
+                               std::unique_ptr<TiXmlElement>& xml)
+{
+  CSingleLock lock(m_critSection);
+  auto it = m_preloaded.find(path);
+  if (it == m_preloaded.end())
+    return false;
+
+  cached = std::move(it->second.cached);
+  xml = std::move(it->second.xml);
+  m_preloaded.erase(it);
+  return true;
+}
+
+void CGUIWindowPreloader::Clear()
+{
+  CSingleLock lock(m_critSection);
+  for (const auto& pending : m_pending)
+    CJobManager::GetInstance().CancelJob(pending.second);
+  m_pending.clear();
+  m_preloaded.clear();
+}
+
+void CGUIWindowPreloader::OnJobComplete(unsigned int jobID, bool success, CJob* job)
+{
+  CPreloadJob* preloadJob = static_cast<CPreloadJob*>(job);
+
+  CSingleLock lock(m_critSection);
+  auto it = m_pending.find(preloadJob->m_path);
+  if (it == m_pending.end() || it->second != jobID)
+    return;
+
+  m_pending.erase(it);
+  if (success)
+  {
+    CLog::Log(LOGDEBUG, "CGUIWindowPreloader::{} - preloaded {}", __FUNCTION__,
+              preloadJob->m_path);
+    m_preloaded[preloadJob->m_path] = std::move(preloadJob->m_preloaded);
+  }
+}
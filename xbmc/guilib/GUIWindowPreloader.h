@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GUISkinCache.h"
+#include "threads/CriticalSection.h"
+#include "utils/Job.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+class TiXmlElement;
+
+/*!
+ \ingroup winman
+ \brief Reads the XML of the windows likely to be opened next on a job thread.
+
+ The windows opened from a window are counted while switching, the most frequent ones (and a
+ few defaults from home) are preloaded when it is activated. Preloading only covers reading the
+ skin cache entry or parsing the window file, resolving includes and creating the controls is
+ left to the gui thread as both evaluate info conditions.
+
+ Apart from Take(), must be used from the gui thread.
+ */
+class CGUIWindowPreloader : public IJobCallback
+{
+public:
+  CGUIWindowPreloader() = default;
+  ~CGUIWindowPreloader() override;
+
+  /*! \brief remember the switch and preload the windows likely to follow the new window
+   \param previousWindow the window that was active before
+   \param window the window that has been activated
+   */
+  void OnWindowActivated(int previousWindow, int window);
+
+  /*! \brief take the preloaded XML of a window
+   \param path the window XML file
+   \param cached [out] the skin cache entry of the window, if there is one
+   \param xml [out] the parsed window XML, if there is no cache entry
+   \return true if the window has been preloaded
+   */
+  bool Take(const std::string& path,
+            CGUISkinCache::Entry& cached,
+            std::unique_ptr<TiXmlElement>& xml);
+
+  /*! \brief cancel the pending jobs and drop everything preloaded */
+  void Clear();
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+
+private:
+  CGUIWindowPreloader(const CGUIWindowPreloader&) = delete;
+  CGUIWindowPreloader& operator=(const CGUIWindowPreloader&) = delete;
+
+  class CPreloadJob;
+
+  struct Preloaded
+  {
+    CGUISkinCache::Entry cached;
+    std::unique_ptr<TiXmlElement> xml;
+  };
+
+  std::map<int, std::map<int, unsigned int>> m_transitions;
+  std::map<std::string, unsigned int> m_pending; //!< job ids by path
+  std::map<std::string, Preloaded> m_preloaded;
+  CCriticalSection m_critSection;
+};
@@ -124,7 +124,7 @@ void CTexture::Update(unsigned int width,
   if (pixels == NULL)
     return;
 
-  if (format & XB_FMT_DXT_MASK)
+  if ((format & XB_FMT_DXT_MASK) && !CServiceBroker::GetRenderSystem()->SupportsDXT())
     return;
 
   Allocate(width, height, format);
@@ -156,6 +156,52 @@ void CTexture::Update(unsigned int width,
     LoadToGPU();
 }
 
+void CTexture::UpdateRegion(unsigned int x,
+                            unsigned int y,
+                            unsigned int width,
+                            unsigned int height,
+                            unsigned int pitch,
+                            const unsigned char* pixels)
+{
+  if (!pixels || width == 0 || height == 0 || (m_format & XB_FMT_DXT_MASK) ||
+      x + width > m_textureWidth || y + height > m_textureHeight)
+    return;
+
+  // the pixels are still around, so the next upload takes the whole image anyway
+  if (m_pixels)
+  {
+    const unsigned int dstPitch = GetPitch();
+    for (unsigned int row = y; row < y + height; row++)
+      memcpy(m_pixels + row * dstPitch + GetPitch(x), pixels + row * pitch + GetPitch(x),
+             GetPitch(width));
+    return;
+  }
+
+  if (!m_loadedToGPU)
+    return;
+
+  if (!m_dirtyPixels.empty())
+  {
+    const unsigned int right = std::max(x + width, m_dirtyX + m_dirtyWidth);
+    const unsigned int bottom = std::max(y + height, m_dirtyY + m_dirtyHeight);
+    x = std::min(x, m_dirtyX);
+    y = std::min(y, m_dirtyY);
+    width = right - x;
+    height = bottom - y;
+  }
+
+  m_dirtyX = x;
+  m_dirtyY = y;
+  m_dirtyWidth = width;
+  m_dirtyHeight = height;
+
+  const unsigned int rowSize = GetPitch(width);
+  m_dirtyPixels.resize(rowSize * height);
+  for (unsigned int row = 0; row < height; row++)
+    memcpy(m_dirtyPixels.data() + row * rowSize, pixels + (y + row) * pitch + GetPitch(x),
+           rowSize);
+}
+
 void CTexture::ClampToEdge()
 {
   if (m_pixels == nullptr)
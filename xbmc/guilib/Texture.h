@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 class IImage;
 
@@ -91,6 +92,7 @@ public:
   virtual void BindToUnit(unsigned int unit) = 0;
 
   unsigned char* GetPixels() const { return m_pixels; }
+  unsigned int GetFormat() const { return m_format; }
   unsigned int GetPitch() const { return GetPitch(m_textureWidth); }
   unsigned int GetRows() const { return GetRows(m_textureHeight); }
   unsigned int GetTextureWidth() const { return m_textureWidth; }
@@ -106,6 +108,18 @@ public:
   void SetOrientation(int orientation) { m_orientation = orientation; }
 
   void Update(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, const unsigned char *pixels, bool loadToGPU);
+  /*! \brief Replace a rectangle of the image.
+   Once the texture is on the GPU only the rectangle is uploaded the next time it is loaded,
+   merged with the ones replaced since the last upload. Not for compressed formats.
+   \param pixels the whole image in the format of the texture, not only the rectangle
+   \param pitch the pitch of pixels
+   */
+  void UpdateRegion(unsigned int x,
+                    unsigned int y,
+                    unsigned int width,
+                    unsigned int height,
+                    unsigned int pitch,
+                    const unsigned char* pixels);
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
   void ClampToEdge();
 
@@ -141,4 +155,11 @@ protected:
   bool m_mipmapping =  false ;
   TEXTURE_SCALING m_scalingMethod = TEXTURE_SCALING::LINEAR;
   bool m_bCacheMemory = false;
+
+  // rectangle replaced since the last upload, and its pixels
+  unsigned int m_dirtyX = 0;
+  unsigned int m_dirtyY = 0;
+  unsigned int m_dirtyWidth = 0;
+  unsigned int m_dirtyHeight = 0;
+  std::vector<unsigned char> m_dirtyPixels;
 };
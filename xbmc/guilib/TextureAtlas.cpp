@@ -0,0 +1,275 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureAtlas.h"
+
+#include "ServiceBroker.h"
+#include "Texture.h"
+#include "TextureFormats.h"
+#include "rendering/RenderSystem.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+constexpr unsigned int PAGE_SIZE = 1024;
+constexpr unsigned int MAX_PAGES = 4;
+// images larger than this in either direction keep their own texture
+constexpr unsigned int MAX_IMAGE_SIZE = 128;
+// border of repeated edge pixels so filtering doesn't pick up the neighbours
+constexpr unsigned int GUTTER = 1;
+// shelves are opened in steps of this, so images of similar height share them
+constexpr unsigned int SHELF_STEP = 4;
+} // namespace
+
+class CTextureAtlas::CPage
+{
+public:
+  struct Slot
+  {
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+    unsigned int height;
+  };
+
+  CPage() : m_texture(CTexture::CreateTexture()), m_pixels(PAGE_SIZE * PAGE_SIZE * 4)
+  {
+    if (m_texture)
+      m_texture->Update(PAGE_SIZE, PAGE_SIZE, PAGE_SIZE * 4, XB_FMT_A8R8G8B8, m_pixels.data(),
+                        false);
+  }
+
+  bool Allocate(unsigned int width, unsigned int height, Slot& slot)
+  {
+    // reuse the smallest released slot that fits
+    auto best = m_free.end();
+    for (auto it = m_free.begin(); it != m_free.end(); ++it)
+    {
+      if (it->width >= width && it->height >= height &&
+          (best == m_free.end() || it->width * it->height < best->width * best->height))
+        best = it;
+    }
+    if (best != m_free.end())
+    {
+      slot = *best;
+      m_free.erase(best);
+      m_regions++;
+      return true;
+    }
+
+    // then the lowest shelf with room left, not wasting more than half of its height
+    Shelf* shelf = nullptr;
+    for (auto& it : m_shelves)
+    {
+      if (it.height >= height && it.height <= height * 2 && PAGE_SIZE - it.used >= width &&
+          (!shelf || it.height < shelf->height))
+        shelf = &it;
+    }
+    if (!shelf)
+    {
+      const unsigned int shelfHeight =
+          std::min((height + SHELF_STEP - 1) / SHELF_STEP * SHELF_STEP, PAGE_SIZE);
+      if (m_nextY + shelfHeight > PAGE_SIZE)
+        return false;
+      m_shelves.push_back({m_nextY, shelfHeight, 0});
+      m_nextY += shelfHeight;
+      shelf = &m_shelves.back();
+    }
+
+    slot = {shelf->used, shelf->y, width, shelf->height};
+    shelf->used += width;
+    m_regions++;
+    return true;
+  }
+
+  void Free(const Slot& slot)
+  {
+    if (--m_regions == 0)
+    {
+      // nothing left, start over
+      m_shelves.clear();
+      m_free.clear();
+      m_nextY = 0;
+      return;
+    }
+
+    for (auto& shelf : m_shelves)
+    {
+      if (shelf.y != slot.y)
+        continue;
+
+      if (slot.x + slot.width != shelf.used)
+        break;
+
+      // the last slot of a shelf goes back to it, along with released ones before it
+      shelf.used = slot.x;
+      for (auto it = m_free.begin(); it != m_free.end();)
+      {
+        if (it->y == shelf.y && it->x + it->width == shelf.used)
+        {
+          shelf.used = it->x;
+          m_free.erase(it);
+          it = m_free.begin();
+        }
+        else
+          ++it;
+      }
+      return;
+    }
+    m_free.push_back(slot);
+  }
+
+  void Write(const Slot& slot, const CTexture& texture)
+  {
+    const unsigned int width = texture.GetWidth();
+    const unsigned int height = texture.GetHeight();
+    const unsigned int srcPitch = texture.GetPitch();
+    const unsigned int dstPitch = PAGE_SIZE * 4;
+    const unsigned char* src = texture.GetPixels();
+
+    for (unsigned int y = 0; y < height + 2 * GUTTER; y++)
+    {
+      const unsigned int srcY = std::min(y > GUTTER ? y - GUTTER : 0, height - 1);
+      const uint32_t* srcRow = reinterpret_cast<const uint32_t*>(src + srcY * srcPitch);
+      uint32_t* dstRow =
+          reinterpret_cast<uint32_t*>(m_pixels.data() + (slot.y + y) * dstPitch) + slot.x;
+
+      for (unsigned int x = 0; x < GUTTER; x++)
+      {
+        dstRow[x] = srcRow[0];
+        dstRow[GUTTER + width + x] = srcRow[width - 1];
+      }
+      std::memcpy(dstRow + GUTTER, srcRow, width * 4);
+    }
+
+    // only the slot is uploaded again once the page is on the gpu
+    m_texture->UpdateRegion(slot.x, slot.y, width + 2 * GUTTER, height + 2 * GUTTER, dstPitch,
+                            m_pixels.data());
+  }
+
+  const std::shared_ptr<CTexture>& GetTexture() const { return m_texture; }
+  unsigned int GetRegions() const { return m_regions; }
+
+private:
+  struct Shelf
+  {
+    unsigned int y;
+    unsigned int height;
+    unsigned int used;
+  };
+
+  std::shared_ptr<CTexture> m_texture;
+  std::vector<uint8_t> m_pixels;
+  std::vector<Shelf> m_shelves;
+  std::vector<Slot> m_free;
+  unsigned int m_nextY = 0;
+  unsigned int m_regions = 0;
+};
+
+CTextureAtlas::CRegion::CRegion(std::shared_ptr<CPage> page,
+                                unsigned int x,
+                                unsigned int y,
+                                unsigned int width,
+                                unsigned int height,
+                                const CRect& texCoords)
+  : m_page(std::move(page)),
+    m_x(x),
+    m_y(y),
+    m_width(width),
+    m_height(height),
+    m_texCoords(texCoords)
+{
+}
+
+CTextureAtlas::CRegion::~CRegion()
+{
+  m_page->Free({m_x, m_y, m_width, m_height});
+}
+
+std::shared_ptr<CTexture> CTextureAtlas::CRegion::GetTexture() const
+{
+  return m_page->GetTexture();
+}
+
+bool CTextureAtlas::CanAdd(const CTexture& texture)
+{
+  // opaque images are left alone, so they don't end up blended
+  return texture.GetPixels() && texture.GetWidth() > 0 && texture.GetHeight() > 0 &&
+         texture.GetWidth() <= MAX_IMAGE_SIZE && texture.GetHeight() <= MAX_IMAGE_SIZE &&
+         (texture.GetFormat() & XB_FMT_MASK) == XB_FMT_A8R8G8B8 && texture.HasAlpha() &&
+         !texture.IsMipmapped() && texture.GetScalingMethod() == TEXTURE_SCALING::LINEAR &&
+         CServiceBroker::GetRenderSystem()->GetMaxTextureSize() >= PAGE_SIZE;
+}
+
+std::shared_ptr<CTextureAtlas::CRegion> CTextureAtlas::Add(const CTexture& texture)
+{
+  const unsigned int width = texture.GetWidth() + 2 * GUTTER;
+  const unsigned int height = texture.GetHeight() + 2 * GUTTER;
+
+  CPage::Slot slot;
+  std::shared_ptr<CPage> page;
+  for (const auto& it : m_pages)
+  {
+    if (it->Allocate(width, height, slot))
+    {
+      page = it;
+      break;
+    }
+  }
+
+  if (!page)
+  {
+    if (m_pages.size() >= MAX_PAGES)
+      return nullptr;
+
+    page = std::make_shared<CPage>();
+    if (!page->GetTexture() || !page->GetTexture()->GetPixels() ||
+        !page->Allocate(width, height, slot))
+      return nullptr;
+
+    m_pages.push_back(page);
+    CLog::Log(LOGDEBUG, "CTextureAtlas::{} - started page {}", __FUNCTION__, m_pages.size());
+  }
+
+  page->Write(slot, texture);
+
+  const float scale = 1.0f / PAGE_SIZE;
+  const CRect texCoords((slot.x + GUTTER) * scale, (slot.y + GUTTER) * scale,
+                        (slot.x + GUTTER + texture.GetWidth()) * scale,
+                        (slot.y + GUTTER + texture.GetHeight()) * scale);
+  return std::make_shared<CRegion>(std::move(page), slot.x, slot.y, slot.width, slot.height,
+                                   texCoords);
+}
+
+void CTextureAtlas::FreeUnusedPages()
+{
+  for (auto it = m_pages.begin(); it != m_pages.end();)
+  {
+    if ((*it)->GetRegions() == 0 && it->use_count() == 1)
+      it = m_pages.erase(it);
+    else
+      ++it;
+  }
+}
+
+void CTextureAtlas::Dump() const
+{
+  for (size_t i = 0; i < m_pages.size(); i++)
+    CLog::Log(LOGDEBUG, "{}: atlas page {} has {} images", __FUNCTION__, i,
+              m_pages[i]->GetRegions());
+}
+
+unsigned int CTextureAtlas::GetMemoryUsage() const
+{
+  // the gpu copy and the one kept for uploading
+  return m_pages.size() * PAGE_SIZE * PAGE_SIZE * 4 * 2;
+}
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/Geometry.h"
+
+#include <memory>
+#include <vector>
+
+class CTexture;
+
+/*!
+ \ingroup textures
+ \brief Packs small gui textures into a few large pages so they share a texture bind.
+
+ Each page keeps a copy of its pixels, adding an image writes it into the copy and the
+ rectangle of the images added since the last upload goes to the gpu before the page is used
+ next. Regions are never moved once handed out, as
+ controls keep their texture coordinates. The space of a region goes back to its page when
+ the last reference is dropped, and a page is started over once it is empty.
+
+ Must be used with the graphics context locked.
+ */
+class CTextureAtlas
+{
+  class CPage;
+
+public:
+  class CRegion
+  {
+  public:
+    CRegion(std::shared_ptr<CPage> page,
+            unsigned int x,
+            unsigned int y,
+            unsigned int width,
+            unsigned int height,
+            const CRect& texCoords);
+    ~CRegion();
+
+    std::shared_ptr<CTexture> GetTexture() const;
+
+    /*! \brief normalized texture coordinates of the image within the page */
+    const CRect& GetTexCoords() const { return m_texCoords; }
+
+  private:
+    CRegion(const CRegion&) = delete;
+    CRegion& operator=(const CRegion&) = delete;
+
+    std::shared_ptr<CPage> m_page;
+    unsigned int m_x;
+    unsigned int m_y;
+    unsigned int m_width;
+    unsigned int m_height;
+    CRect m_texCoords;
+  };
+
+  CTextureAtlas() = default;
+
+  /*! \brief true if the texture is small enough and in a format that can be packed */
+  static bool CanAdd(const CTexture& texture);
+
+  /*! \brief copy the image of a texture into a page
+   \return the region holding the image, nullptr if it didn't fit
+   */
+  std::shared_ptr<CRegion> Add(const CTexture& texture);
+
+  /*! \brief drop the pages no region is left in */
+  void FreeUnusedPages();
+
+  void Dump() const;
+  unsigned int GetMemoryUsage() const;
+
+private:
+  std::vector<std::shared_ptr<CPage>> m_pages;
+};
@@ -8,6 +8,7 @@
 
 #include "TextureDX.h"
 
+#include "rendering/dx/DeviceResources.h"
 #include "utils/MemUtils.h"
 #include "utils/log.h"
 
@@ -72,7 +73,9 @@ void CDXTexture::LoadToGPU()
 {
   if (!m_pixels)
   {
-    // nothing to load - probably same image (no change)
+    // nothing to load - probably same image (no change), unless a part of it was replaced
+    if (!m_dirtyPixels.empty() && m_texture.Get() != nullptr)
+      LoadRegionToGPU();
     return;
   }
 
@@ -185,9 +188,33 @@ void CDXTexture::LoadToGPU()
     m_pixels = nullptr;
   }
 
+  m_dirtyPixels.clear();
   m_loadedToGPU = true;
 }
 
+void CDXTexture::LoadRegionToGPU()
+{
+  D3D11_TEXTURE2D_DESC texDesc;
+  m_texture.GetDesc(&texDesc);
+
+  // a dynamic texture can only be mapped as a whole, the region is lost
+  if (texDesc.Usage != D3D11_USAGE_DEFAULT || m_format == XB_FMT_RGB8)
+  {
+    CLog::LogF(LOGERROR, "can't update a region of a dynamic texture");
+    m_dirtyPixels.clear();
+    return;
+  }
+
+  const D3D11_BOX box = {m_dirtyX, m_dirtyY, 0, m_dirtyX + m_dirtyWidth, m_dirtyY + m_dirtyHeight,
+                         1};
+  DX::DeviceResources::Get()->GetImmediateContext()->UpdateSubresource(
+      m_texture.Get(), 0, &box, m_dirtyPixels.data(), GetPitch(m_dirtyWidth), 0);
+  if (IsMipmapped())
+    m_texture.GenerateMipmaps();
+
+  m_dirtyPixels.clear();
+}
+
 void CDXTexture::BindToUnit(unsigned int unit)
 {
 }
@@ -38,4 +38,5 @@ public:
 private:
   CD3DTexture m_texture;
   DXGI_FORMAT GetFormat();
+  void LoadRegionToGPU();
 };
@@ -54,7 +54,9 @@ void CGLTexture::LoadToGPU()
 {
   if (!m_pixels)
   {
-    // nothing to load - probably same image (no change)
+    // nothing to load - probably same image (no change), unless a part of it was replaced
+    if (!m_dirtyPixels.empty() && m_texture != 0)
+      LoadRegionToGPU();
     return;
   }
   if (m_texture == 0)
@@ -63,6 +65,11 @@ void CGLTexture::LoadToGPU()
     // this happens only one time - the first time the texture is loaded
     CreateTextureObject();
   }
+  else
+  {
+    // gui quads queued before may still sample the previous image
+    CServiceBroker::GetRenderSystem()->FlushGUIBatch();
+  }
 
   // Bind the texture object
   glBindTexture(GL_TEXTURE_2D, m_texture);
@@ -215,9 +222,55 @@ void CGLTexture::LoadToGPU()
     m_pixels = NULL;
   }
 
+  m_dirtyPixels.clear();
   m_loadedToGPU = true;
 }
 
+void CGLTexture::LoadRegionToGPU()
+{
+  // gui quads queued before may still sample the previous image
+  CServiceBroker::GetRenderSystem()->FlushGUIBatch();
+
+  glBindTexture(GL_TEXTURE_2D, m_texture);
+
+#ifndef HAS_GLES
+  const GLenum format = m_format == XB_FMT_RGB8 ? GL_RGB : GL_BGRA;
+#else
+  GLenum format = GL_RGBA;
+  if (m_format == XB_FMT_RGB8)
+    format = GL_RGB;
+  else if (m_format == XB_FMT_A8R8G8B8)
+  {
+    // same as the whole image in LoadToGPU
+    if (CServiceBroker::GetRenderSystem()->IsExtSupported("GL_EXT_texture_format_BGRA8888") ||
+        CServiceBroker::GetRenderSystem()->IsExtSupported("GL_IMG_texture_format_BGRA8888") ||
+        CServiceBroker::GetRenderSystem()->IsExtSupported("GL_APPLE_texture_format_BGRA8888"))
+      format = GL_BGRA_EXT;
+    else
+      SwapBlueRed(m_dirtyPixels.data(), m_dirtyHeight, GetPitch(m_dirtyWidth));
+  }
+#endif
+
+  // the rows of the region are packed
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, m_dirtyX, m_dirtyY, m_dirtyWidth, m_dirtyHeight, format,
+                  GL_UNSIGNED_BYTE, m_dirtyPixels.data());
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+#ifndef HAS_GLES
+  if (IsMipmapped() && m_isOglVersion3orNewer)
+#else
+  if (IsMipmapped())
+#endif
+  {
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
+
+  VerifyGLState();
+
+  m_dirtyPixels.clear();
+}
+
 void CGLTexture::BindToUnit(unsigned int unit)
 {
   glActiveTexture(GL_TEXTURE0 + unit);
@@ -16,6 +16,8 @@
 #include "filesystem/File.h"
 #include "guilib/TextureBundle.h"
 #include "guilib/TextureFormats.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -75,6 +77,7 @@ void CTextureArray::Reset()
 {
   m_textures.clear();
   m_delays.clear();
+  m_atlasCoords.clear();
   m_width = 0;
   m_height = 0;
   m_loops = 0;
@@ -95,6 +98,19 @@ void CTextureArray::Add(std::shared_ptr<CTexture> texture, int delay)
 
   m_textures.emplace_back(std::move(texture));
   m_delays.push_back(delay);
+  m_atlasCoords.emplace_back();
+}
+
+void CTextureArray::Add(const CTextureAtlas::CRegion& region, int delay)
+{
+  // texture coordinates are relative to the image and mapped into the page when rendering
+  m_texWidth = m_width;
+  m_texHeight = m_height;
+  m_texCoordsArePixels = false;
+
+  m_textures.emplace_back(region.GetTexture());
+  m_delays.push_back(delay);
+  m_atlasCoords.push_back(region.GetTexCoords());
 }
 
 void CTextureArray::Set(std::shared_ptr<CTexture> texture, int width, int height)
@@ -186,6 +202,7 @@ void CTextureMap::Flush()
 void CTextureMap::FreeTexture()
 {
   m_texture.Free();
+  m_atlasRegions.clear();
 }
 
 void CTextureMap::SetHeight(int height)
@@ -211,6 +228,16 @@ void CTextureMap::Add(std::unique_ptr<CTexture> texture, int delay)
   m_texture.Add(std::move(texture), delay);
 }
 
+void CTextureMap::Add(std::shared_ptr<CTextureAtlas::CRegion> region, int delay)
+{
+  // the memory is accounted for by the atlas
+  if (!region)
+    return;
+
+  m_texture.Add(*region, delay);
+  m_atlasRegions.emplace_back(std::move(region));
+}
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -445,7 +472,14 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
   if (!pTexture) return emptyTexture;
 
   CTextureMap* pMap = new CTextureMap(strTextureName, width, height, 0);
-  pMap->Add(std::move(pTexture), 100);
+  std::shared_ptr<CTextureAtlas::CRegion> region;
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureAtlas &&
+      CTextureAtlas::CanAdd(*pTexture))
+    region = m_atlas.Add(*pTexture);
+  if (region)
+    pMap->Add(std::move(region), 100);
+  else
+    pMap->Add(std::move(pTexture), 100);
   m_vecTextures.push_back(pMap);
 
 #ifdef _DEBUG_TEXTURES
@@ -506,6 +540,8 @@ void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
       ++i;
   }
 
+  m_atlas.FreeUnusedPages();
+
 #if defined(HAS_GL) || defined(HAS_GLES)
   for (unsigned int i = 0; i < m_unusedHwTextures.size(); ++i)
   {
@@ -558,6 +594,7 @@ void CGUITextureManager::Dump() const
     if (!pMap->IsEmpty())
       pMap->Dump();
   }
+  m_atlas.Dump();
 }
 
 void CGUITextureManager::Flush()
@@ -589,7 +626,7 @@ unsigned int CGUITextureManager::GetMemoryUsage() const
   {
     memUsage += m_vecTextures[i]->GetMemoryUsage();
   }
-  return memUsage;
+  return memUsage + m_atlas.GetMemoryUsage();
 }
 
 void CGUITextureManager::SetTexturePath(const std::string &texturePath)
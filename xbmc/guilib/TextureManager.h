@@ -9,6 +9,7 @@
 #pragma once
 
 #include "GUIComponent.h"
+#include "TextureAtlas.h"
 #include "TextureBundle.h"
 #include "threads/CriticalSection.h"
 
@@ -37,12 +38,14 @@ public:
   void Reset();
 
   void Add(std::shared_ptr<CTexture> texture, int delay);
+  void Add(const CTextureAtlas::CRegion& region, int delay);
   void Set(std::shared_ptr<CTexture> texture, int width, int height);
   void Free();
   unsigned int size() const;
 
   std::vector<std::shared_ptr<CTexture>> m_textures;
   std::vector<int> m_delays;
+  std::vector<CRect> m_atlasCoords; ///< frame's rect in its atlas page, empty if not packed
   int m_width;
   int m_height;
   int m_orientation;
@@ -67,6 +70,7 @@ public:
   virtual ~CTextureMap();
 
   void Add(std::unique_ptr<CTexture> texture, int delay);
+  void Add(std::shared_ptr<CTextureAtlas::CRegion> region, int delay);
   bool Release();
 
   const std::string& GetName() const;
@@ -81,6 +85,7 @@ protected:
   void FreeTexture();
 
   CTextureArray m_texture;
+  std::vector<std::shared_ptr<CTextureAtlas::CRegion>> m_atlasRegions;
   std::string m_textureName;
   unsigned int m_referenceCount;
   uint32_t m_memUsage;
@@ -124,6 +129,7 @@ protected:
   typedef std::vector<CTextureMap*>::iterator ivecTextures;
   // we have 2 texture bundles (one for the base textures, one for the theme)
   CTextureBundle m_TexBundle[2];
+  CTextureAtlas m_atlas; ///< small textures share pages so they can be drawn without a bind
 
   std::vector<std::string> m_texturePaths;
   CCriticalSection m_section;
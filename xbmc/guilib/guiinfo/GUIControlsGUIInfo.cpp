@@ -9,6 +9,7 @@
 #include "guilib/guiinfo/GUIControlsGUIInfo.h"
 
 #include "FileItem.h"
+#include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "dialogs/GUIDialogKeyboardGeneric.h"
@@ -38,6 +39,18 @@
 using namespace KODI::GUILIB;
 using namespace KODI::GUILIB::GUIINFO;
 
+void CGUIControlsGUIInfo::SetNextWindow(int windowID)
+{
+  m_nextWindowID = windowID;
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_WINDOWS);
+}
+
+void CGUIControlsGUIInfo::SetPreviousWindow(int windowID)
+{
+  m_prevWindowID = windowID;
+  CServiceBroker::GetGUI()->GetInfoManager().InvalidateInfoSource(INFO::INFO_SOURCE_WINDOWS);
+}
+
 void CGUIControlsGUIInfo::SetContainerMoving(int id, bool next, bool scrolling)
 {
   // magnitude 2 indicates a scroll, sign indicates direction
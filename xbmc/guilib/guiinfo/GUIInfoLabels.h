@@ -380,6 +380,7 @@
 #define VISUALISATION_NAME          412
 #define VISUALISATION_ENABLED       413
 #define VISUALISATION_HAS_PRESETS   414
+#define VISUALISATION_SPECTRUM      415
 
 #define STRING_IS_EMPTY             420
 #define STRING_IS_EQUAL             421
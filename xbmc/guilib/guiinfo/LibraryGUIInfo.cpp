@@ -66,8 +66,9 @@ void CLibraryGUIInfo::SetLibraryBool(int condition, bool value)
       m_libraryHasBoxsets = value ? 1 : 0;
       break;
     default:
-      break;
+      return;
   }
+  m_changeCounter++;
 }
 
 void CLibraryGUIInfo::ResetLibraryBools()
@@ -81,6 +82,7 @@ void CLibraryGUIInfo::ResetLibraryBools()
   m_libraryHasCompilations = -1;
   m_libraryHasBoxsets = -1;
   m_libraryRoleCounts.clear();
+  m_changeCounter++;
 }
 
 bool CLibraryGUIInfo::InitCurrentItem(CFileItem *item)
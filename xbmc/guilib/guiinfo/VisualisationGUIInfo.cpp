@@ -50,6 +50,16 @@ bool CVisualisationGUIInfo::GetLabel(std::string& value, const CFileItem *item,
       }
       break;
     }
+    case VISUALISATION_SPECTRUM:
+    {
+      int band;
+      if (GetInt(band, item, contextWindow, info))
+      {
+        value = std::to_string(band);
+        return true;
+      }
+      break;
+    }
     case VISUALISATION_NAME:
     {
       ADDON::AddonPtr addon;
@@ -70,6 +80,25 @@ bool CVisualisationGUIInfo::GetLabel(std::string& value, const CFileItem *item,
 
 bool CVisualisationGUIInfo::GetInt(int& value, const CGUIListItem *gitem, int contextWindow, const CGUIInfo &info) const
 {
+  switch (info.m_info)
+  {
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // VISUALISATION_*
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    case VISUALISATION_SPECTRUM:
+    {
+      CGUIMessage msg(GUI_MSG_GET_VISUALISATION, 0, 0);
+      CServiceBroker::GetGUI()->GetWindowManager().SendMessage(msg);
+      if (msg.GetPointer())
+      {
+        CGUIVisualisationControl* viz = static_cast<CGUIVisualisationControl*>(msg.GetPointer());
+        value = viz->GetSpectrumBand(info.GetData1());
+        return true;
+      }
+      break;
+    }
+  }
+
   return false;
 }
 
@@ -0,0 +1,237 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/DDSImage.h"
+#include "guilib/TextureFormats.h"
+#include "test/TestUtils.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Color
+{
+  int b, g, r;
+};
+
+Color Decode565(uint16_t color)
+{
+  const int r = (color >> 11) & 31;
+  const int g = (color >> 5) & 63;
+  const int b = color & 31;
+  return {(b << 3) | (b >> 2), (g << 2) | (g >> 4), (r << 3) | (r >> 2)};
+}
+
+//! decodes pixel x, y of a DXT1 or DXT5 image to BGRA
+void DecodePixel(const CDDSImage& image, unsigned int x, unsigned int y, int* bgra)
+{
+  const bool dxt5 = image.GetFormat() == XB_FMT_DXT5;
+  const unsigned int blockSize = dxt5 ? 16 : 8;
+  const unsigned int blocksWide = (image.GetWidth() + 3) / 4;
+  const unsigned char* block = image.GetData() + ((y / 4) * blocksWide + x / 4) * blockSize;
+  const unsigned int index = (y % 4) * 4 + x % 4;
+
+  bgra[3] = 255;
+  if (dxt5)
+  {
+    const int a0 = block[0];
+    const int a1 = block[1];
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; i++)
+      bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    int alphas[8] = {a0, a1};
+    if (a0 > a1)
+    {
+      for (int i = 1; i < 7; i++)
+        alphas[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+    }
+    else
+    {
+      for (int i = 1; i < 5; i++)
+        alphas[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+      alphas[6] = 0;
+      alphas[7] = 255;
+    }
+    bgra[3] = alphas[(bits >> (3 * index)) & 7];
+    block += 8;
+  }
+
+  const uint16_t c0 = block[0] | (block[1] << 8);
+  const uint16_t c1 = block[2] | (block[3] << 8);
+  const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) |
+                           (static_cast<uint32_t>(block[7]) << 24);
+  Color colors[4] = {Decode565(c0), Decode565(c1)};
+  if (c0 > c1 || dxt5)
+  {
+    colors[2] = {(2 * colors[0].b + colors[1].b) / 3, (2 * colors[0].g + colors[1].g) / 3,
+                 (2 * colors[0].r + colors[1].r) / 3};
+    colors[3] = {(colors[0].b + 2 * colors[1].b) / 3, (colors[0].g + 2 * colors[1].g) / 3,
+                 (colors[0].r + 2 * colors[1].r) / 3};
+  }
+  else
+  {
+    colors[2] = {(colors[0].b + colors[1].b) / 2, (colors[0].g + colors[1].g) / 2,
+                 (colors[0].r + colors[1].r) / 2};
+    colors[3] = {0, 0, 0};
+    if (((indices >> (2 * index)) & 3) == 3)
+      bgra[3] = 0;
+  }
+  const Color& color = colors[(indices >> (2 * index)) & 3];
+  bgra[0] = color.b;
+  bgra[1] = color.g;
+  bgra[2] = color.r;
+}
+
+class TestDDSImage : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_file = XBMC_CREATETEMPFILE(".dds");
+    ASSERT_NE(nullptr, m_file);
+    m_file->Close();
+  }
+
+  void TearDown() override { EXPECT_TRUE(XBMC_DELETETEMPFILE(m_file)); }
+
+  //! compresses the image, reads it back and returns the largest error of each channel
+  void RoundTrip(unsigned int width,
+                 unsigned int height,
+                 const std::vector<unsigned char>& bgra,
+                 unsigned int expectedFormat,
+                 int* maxError,
+                 double* colorPSNR = nullptr)
+  {
+    const std::string path = XBMC_TEMPFILEPATH(m_file);
+    CDDSImage out;
+    ASSERT_TRUE(out.Create(path, width, height, width * 4, bgra.data()));
+
+    CDDSImage in;
+    ASSERT_TRUE(in.ReadFile(path));
+    ASSERT_EQ(expectedFormat, in.GetFormat());
+    ASSERT_EQ(width, in.GetWidth());
+    ASSERT_EQ(height, in.GetHeight());
+    const unsigned int blockSize = expectedFormat == XB_FMT_DXT5 ? 16 : 8;
+    ASSERT_EQ(((width + 3) / 4) * ((height + 3) / 4) * blockSize, in.GetSize());
+
+    double squaredError = 0;
+    for (int c = 0; c < 4; c++)
+      maxError[c] = 0;
+    for (unsigned int y = 0; y < height; y++)
+    {
+      for (unsigned int x = 0; x < width; x++)
+      {
+        int decoded[4];
+        DecodePixel(in, x, y, decoded);
+        for (int c = 0; c < 4; c++)
+        {
+          const int error = decoded[c] - bgra[(y * width + x) * 4 + c];
+          maxError[c] = std::max(maxError[c], std::abs(error));
+          if (c < 3)
+            squaredError += error * error;
+        }
+      }
+    }
+    if (colorPSNR)
+      *colorPSNR = 10 * std::log10(255.0 * 255.0 * width * height * 3 / squaredError);
+  }
+
+  XFILE::CFile* m_file = nullptr;
+};
+} // namespace
+
+TEST_F(TestDDSImage, OpaqueBlock)
+{
+  // a 4x4 gradient along a single colour axis
+  std::vector<unsigned char> bgra(4 * 4 * 4);
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    bgra[i * 4 + 0] = static_cast<unsigned char>(40 + i * 8);
+    bgra[i * 4 + 1] = static_cast<unsigned char>(200 - i * 8);
+    bgra[i * 4 + 2] = static_cast<unsigned char>(100);
+    bgra[i * 4 + 3] = 255;
+  }
+
+  int maxError[4];
+  RoundTrip(4, 4, bgra, XB_FMT_DXT1, maxError);
+  // four colours on the line cover the 120 wide range in steps of 40
+  EXPECT_LE(maxError[0], 24);
+  EXPECT_LE(maxError[1], 24);
+  EXPECT_LE(maxError[2], 8);
+  EXPECT_EQ(maxError[3], 0);
+}
+
+TEST_F(TestDDSImage, SolidBlock)
+{
+  std::vector<unsigned char> bgra(4 * 4 * 4);
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    bgra[i * 4 + 0] = 10;
+    bgra[i * 4 + 1] = 128;
+    bgra[i * 4 + 2] = 250;
+    bgra[i * 4 + 3] = 255;
+  }
+
+  int maxError[4];
+  RoundTrip(4, 4, bgra, XB_FMT_DXT1, maxError);
+  // only the 565 quantisation is lost
+  EXPECT_LE(maxError[0], 8);
+  EXPECT_LE(maxError[1], 4);
+  EXPECT_LE(maxError[2], 8);
+  EXPECT_EQ(maxError[3], 0);
+}
+
+TEST_F(TestDDSImage, AlphaBlock)
+{
+  std::vector<unsigned char> bgra(4 * 4 * 4);
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    bgra[i * 4 + 0] = 60;
+    bgra[i * 4 + 1] = 60;
+    bgra[i * 4 + 2] = 60;
+    bgra[i * 4 + 3] = static_cast<unsigned char>(i * 17);
+  }
+
+  int maxError[4];
+  RoundTrip(4, 4, bgra, XB_FMT_DXT5, maxError);
+  EXPECT_LE(maxError[0], 8);
+  EXPECT_LE(maxError[1], 4);
+  EXPECT_LE(maxError[2], 8);
+  // eight alpha levels over the full range
+  EXPECT_LE(maxError[3], 19);
+}
+
+TEST_F(TestDDSImage, PartialBlocks)
+{
+  // not a multiple of the block size
+  const unsigned int width = 37;
+  const unsigned int height = 29;
+  std::vector<unsigned char> bgra(width * height * 4);
+  for (unsigned int y = 0; y < height; y++)
+  {
+    for (unsigned int x = 0; x < width; x++)
+    {
+      unsigned char* pixel = &bgra[(y * width + x) * 4];
+      pixel[0] = static_cast<unsigned char>(x * 6);
+      pixel[1] = static_cast<unsigned char>(y * 8);
+      pixel[2] = static_cast<unsigned char>((x * y) % 256);
+      pixel[3] = 255;
+    }
+  }
+
+  int maxError[4];
+  double psnr;
+  RoundTrip(width, height, bgra, XB_FMT_DXT1, maxError, &psnr);
+  EXPECT_GT(psnr, 25.0);
+  EXPECT_EQ(maxError[3], 0);
+}
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUISkinCache.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+bool IsKept(const TiXmlNode* node)
+{
+  return node->Type() == TiXmlNode::TINYXML_ELEMENT || node->Type() == TiXmlNode::TINYXML_TEXT;
+}
+
+const TiXmlNode* NextKept(const TiXmlNode* node)
+{
+  while (node && !IsKept(node))
+    node = node->NextSibling();
+  return node;
+}
+
+void ExpectEqual(const TiXmlNode* expected, const TiXmlNode* actual)
+{
+  ASSERT_NE(nullptr, actual);
+  ASSERT_EQ(expected->Type(), actual->Type());
+  EXPECT_EQ(expected->ValueStr(), actual->ValueStr());
+
+  if (expected->Type() == TiXmlNode::TINYXML_TEXT)
+  {
+    EXPECT_EQ(expected->ToText()->CDATA(), actual->ToText()->CDATA());
+    return;
+  }
+
+  const TiXmlAttribute* expectedAttribute = expected->ToElement()->FirstAttribute();
+  const TiXmlAttribute* actualAttribute = actual->ToElement()->FirstAttribute();
+  for (; expectedAttribute; expectedAttribute = expectedAttribute->Next())
+  {
+    ASSERT_NE(nullptr, actualAttribute);
+    EXPECT_EQ(expectedAttribute->NameTStr(), actualAttribute->NameTStr());
+    EXPECT_EQ(expectedAttribute->ValueStr(), actualAttribute->ValueStr());
+    actualAttribute = actualAttribute->Next();
+  }
+  EXPECT_EQ(nullptr, actualAttribute);
+
+  const TiXmlNode* expectedChild = NextKept(expected->FirstChild());
+  const TiXmlNode* actualChild = actual->FirstChild();
+  for (; expectedChild; expectedChild = NextKept(expectedChild->NextSibling()))
+  {
+    ExpectEqual(expectedChild, actualChild);
+    if (!actualChild)
+      return;
+    actualChild = actualChild->NextSibling();
+  }
+  EXPECT_EQ(nullptr, actualChild);
+}
+
+const char* WINDOW_XML = R"(<?xml version="1.0" encoding="UTF-8"?>
+<window id="1100" type="dialog">
+  <!-- comments are dropped -->
+  <defaultcontrol always="true">9000</defaultcontrol>
+  <onload condition="!Skin.HasSetting(animations)">SetProperty(a,1)</onload>
+  <controls>
+    <control type="label" id="10">
+      <left>20</left>
+      <top>20</top>
+      <label>$INFO[ListItem.Label]</label>
+      <visible>String.IsEqual(Window.Property(a),1) + !Player.HasVideo</visible>
+    </control>
+    <control type="textbox" id="11">
+      <left>20</left>
+      <label><![CDATA[<b>bold</b> & more]]></label>
+      <empty />
+    </control>
+  </controls>
+</window>
+)";
+} // namespace
+
+TEST(TestGUISkinCache, RoundTrip)
+{
+  CXBMCTinyXML doc;
+  ASSERT_TRUE(doc.Parse(WINDOW_XML));
+  const TiXmlElement* root = doc.RootElement();
+  ASSERT_NE(nullptr, root);
+
+  const std::string encoded = CGUISkinCache::Encode(*root);
+  const std::vector<uint8_t> data(encoded.begin(), encoded.end());
+  std::unique_ptr<TiXmlElement> decoded = CGUISkinCache::Decode(data);
+  ASSERT_NE(nullptr, decoded);
+
+  ExpectEqual(root, decoded.get());
+}
+
+TEST(TestGUISkinCache, CDATA)
+{
+  CXBMCTinyXML doc;
+  ASSERT_TRUE(doc.Parse(WINDOW_XML));
+
+  const std::string encoded = CGUISkinCache::Encode(*doc.RootElement());
+  std::unique_ptr<TiXmlElement> decoded =
+      CGUISkinCache::Decode(std::vector<uint8_t>(encoded.begin(), encoded.end()));
+  ASSERT_NE(nullptr, decoded);
+
+  const TiXmlElement* label = decoded->FirstChildElement("controls")
+                                  ->FirstChildElement("control")
+                                  ->NextSiblingElement("control")
+                                  ->FirstChildElement("label");
+  ASSERT_NE(nullptr, label);
+  ASSERT_NE(nullptr, label->FirstChild());
+  const TiXmlText* text = label->FirstChild()->ToText();
+  ASSERT_NE(nullptr, text);
+  EXPECT_TRUE(text->CDATA());
+  EXPECT_EQ("<b>bold</b> & more", text->ValueStr());
+}
+
+TEST(TestGUISkinCache, Invalid)
+{
+  CXBMCTinyXML doc;
+  ASSERT_TRUE(doc.Parse(WINDOW_XML));
+  const std::string encoded = CGUISkinCache::Encode(*doc.RootElement());
+
+  EXPECT_EQ(nullptr, CGUISkinCache::Decode({}));
+
+  // every truncation is detected
+  for (size_t size = 0; size < encoded.size(); size++)
+  {
+    const std::vector<uint8_t> data(encoded.begin(), encoded.begin() + size);
+    EXPECT_EQ(nullptr, CGUISkinCache::Decode(data)) << "truncated to " << size;
+  }
+
+  // an element named by a string index past the empty string table
+  const std::vector<uint8_t> data = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+  EXPECT_EQ(nullptr, CGUISkinCache::Decode(data));
+}
@@ -12,13 +12,15 @@
 
 namespace INFO
 {
-  InfoBool::InfoBool(const std::string &expression, int context, unsigned int &refreshCounter)
+  InfoBool::InfoBool(const std::string &expression, int context, const InfoRefreshCounters &refreshCounters)
     : m_value(false),
       m_context(context),
       m_listItemDependent(false),
+      m_constant(false),
+      m_sources(INFO_SOURCE_MASK_FRAME),
       m_expression(expression),
-      m_refreshCounter(0),
-      m_parentRefreshCounter(refreshCounter)
+      m_refreshStamp(0),
+      m_parentRefreshCounters(refreshCounters)
   {
     StringUtils::ToLower(m_expression);
   }
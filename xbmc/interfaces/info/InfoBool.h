@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -15,6 +16,50 @@ class CGUIListItem;
 
 namespace INFO
 {
+/*!
+ \ingroup info
+ \brief State an info bool can depend on, each with its own refresh counter
+ */
+enum InfoSource
+{
+  INFO_SOURCE_FRAME = 0,     ///< may change any frame, e.g. player time or control focus
+  INFO_SOURCE_SKIN_SETTINGS, ///< skin bools and strings
+  INFO_SOURCE_LIBRARY,       ///< library content flags
+  INFO_SOURCE_WINDOWS,       ///< active windows and dialogs, window history
+  INFO_SOURCE_PLAYER,        ///< player started, stopped, paused, speed changed
+  INFO_SOURCE_MAX
+};
+
+constexpr unsigned int INFO_SOURCE_MASK_FRAME = 1 << INFO_SOURCE_FRAME;
+
+/*!
+ \ingroup info
+ \brief Refresh counters of the info sources, owned by the info manager
+ The counters are bumped from the thread that changed the state, e.g. a player thread.
+ */
+struct InfoRefreshCounters
+{
+  std::atomic<unsigned int> counters[INFO_SOURCE_MAX] = {1, 1, 1, 1, 1};
+
+  /*! \brief Number of cached info bools updated since the last frame, list item updates
+   are not counted as they never use the cache
+   */
+  mutable std::atomic<unsigned int> updates{0};
+
+  /*! \brief Sum of the counters of the given sources, changes whenever one of them is bumped
+   */
+  unsigned int Stamp(unsigned int sources) const
+  {
+    unsigned int stamp = 0;
+    for (int i = 0; i < INFO_SOURCE_MAX; i++)
+    {
+      if (sources & (1 << i))
+        stamp += counters[i];
+    }
+    return stamp;
+  }
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -22,7 +67,7 @@ namespace INFO
 class InfoBool
 {
 public:
-  InfoBool(const std::string &expression, int context, unsigned int &refreshCounter);
+  InfoBool(const std::string &expression, int context, const InfoRefreshCounters &refreshCounters);
   virtual ~InfoBool() = default;
 
   virtual void Initialize() {}
@@ -33,12 +78,19 @@ public:
    */
   inline bool Get(const CGUIListItem *item = NULL)
   {
+    if (m_constant)
+      return m_value;
     if (item && m_listItemDependent)
       Update(item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+    else
     {
-      Update(NULL);
-      m_refreshCounter = m_parentRefreshCounter;
+      const unsigned int stamp = m_parentRefreshCounters.Stamp(m_sources);
+      if (stamp != m_refreshStamp)
+      {
+        ++m_parentRefreshCounters.updates;
+        Update(NULL);
+        m_refreshStamp = stamp;
+      }
     }
     return m_value;
   }
@@ -66,16 +118,24 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  /*! \brief Whether the value is fixed while the skin is loaded, e.g. true or System.Platform.Linux
+   */
+  bool IsConstant() const { return m_constant; }
+  /*! \brief Mask of the info sources the value depends on, it is only updated when one of them changed
+   */
+  unsigned int GetSources() const { return m_sources; }
 protected:
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
+  bool m_constant;             ///< value is set by Initialize and never updated
+  unsigned int m_sources;      ///< mask of INFO_SOURCE_* the value depends on
   std::string  m_expression;   ///< original expression
 
 private:
-  unsigned int m_refreshCounter;
-  unsigned int &m_parentRefreshCounter;
+  unsigned int m_refreshStamp;
+  const InfoRefreshCounters &m_parentRefreshCounters;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -11,17 +11,56 @@
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/guiinfo/GUIInfoLabels.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <list>
 #include <memory>
 #include <stack>
 
 using namespace INFO;
 
+namespace
+{
+// every n-th update evaluates the tree to learn which children decide their groups
+constexpr unsigned int SAMPLE_INTERVAL = 32;
+// samples after which the groups are reordered
+constexpr unsigned int RANK_INTERVAL = 32;
+
+// conditions that can't change while the skin is loaded
+bool IsConstantCondition(int condition)
+{
+  switch (condition)
+  {
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+    case SYSTEM_PLATFORM_LINUX:
+    case SYSTEM_PLATFORM_WINDOWS:
+    case SYSTEM_PLATFORM_UWP:
+    case SYSTEM_PLATFORM_DARWIN:
+    case SYSTEM_PLATFORM_DARWIN_OSX:
+    case SYSTEM_PLATFORM_DARWIN_IOS:
+    case SYSTEM_PLATFORM_DARWIN_TVOS:
+    case SYSTEM_PLATFORM_ANDROID:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = infoMgr.TranslateSingleString(m_expression, m_listItemDependent);
+  if (IsConstantCondition(std::abs(m_condition)))
+  {
+    m_value = infoMgr.GetBool(m_condition, m_context);
+    m_constant = true;
+  }
+  m_sources = infoMgr.GetInfoSources(m_condition);
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -31,16 +70,52 @@ void InfoSingle::Update(const CGUIListItem *item)
 
 void InfoExpression::Initialize()
 {
+  m_infoMgr = &CServiceBroker::GetGUI()->GetInfoManager();
   if (!Parse(m_expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression {}", m_expression);
-    m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    m_expression_tree = std::make_shared<InfoLeaf>(m_infoMgr->Register("false", 0), false);
   }
+  Compile();
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  if (++m_updates % SAMPLE_INTERVAL == 0)
+  {
+    m_value = m_expression_tree->Evaluate(item);
+    if (++m_samples % RANK_INTERVAL == 0 && m_expression_tree->Rank())
+      Compile();
+    return;
+  }
+
+  bool result = false;
+  const size_t size = m_program.size();
+  size_t pc = 0;
+  while (pc < size)
+  {
+    const Instruction& instruction = m_program[pc++];
+    switch (instruction.op)
+    {
+      case OP_CONST:
+        result = instruction.value;
+        break;
+      case OP_BOOL:
+        result = instruction.value ^ instruction.info->Get(item);
+        break;
+      case OP_ITEM_BOOL:
+        if (item)
+          result = instruction.value ^ m_infoMgr->GetBool(instruction.condition, m_context, item);
+        else
+          result = instruction.value ^ instruction.info->Get(nullptr);
+        break;
+      case OP_JUMP:
+        if (result == instruction.value)
+          pc += instruction.offset;
+        break;
+    }
+  }
+  m_value = result;
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
@@ -59,13 +134,83 @@ void InfoExpression::Update(const CGUIListItem *item)
  * 2) Combining adjacent AND or OR operations such that each path from the root
  *    to a leaf encounters a strictly alternating pattern of AND and OR
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
+ *
+ * Each group is compiled as its children, each followed by a jump to the end
+ * of the group that is taken once the value of the group is known (true for
+ * OR, false for AND). Children which don't depend on the list item come first,
+ * their values are cached for the frame, so they are cheap and often decide the
+ * group before any list item condition has to be evaluated. Within that, they
+ * keep the order of the group. The program runs most updates, the tree still
+ * runs a sample of them to count which children decide their group, and the
+ * groups are then reordered and the program compiled again.
  */
 
+void InfoExpression::Compile()
+{
+  m_program.clear();
+  m_infos.clear();
+  m_expression_tree->Compile(m_program, m_infos);
+  ThreadJumps(m_program);
+
+  // the expression only needs updating when a source of one of its operands changed
+  m_sources = 0;
+  for (const auto& info : m_infos)
+    m_sources |= info->GetSources();
+
+  if (IsConst(m_program))
+  {
+    m_value = m_program[0].value;
+    m_constant = true;
+  }
+}
+
+void InfoExpression::ThreadJumps(Program& program)
+{
+  // a jump landing on a jump of a parent group either takes it as well or falls through it
+  for (size_t i = 0; i < program.size(); i++)
+  {
+    if (program[i].op != OP_JUMP)
+      continue;
+
+    size_t target = i + 1 + program[i].offset;
+    while (target < program.size() && program[target].op == OP_JUMP)
+    {
+      if (program[target].value == program[i].value)
+        target += 1 + program[target].offset;
+      else
+        target++;
+    }
+    program[i].offset = static_cast<unsigned int>(target - i - 1);
+  }
+}
+
 bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
 {
   return m_invert ^ m_info->Get(item);
 }
 
+void InfoExpression::InfoLeaf::Compile(Program& program, std::vector<InfoPtr>& infos) const
+{
+  Instruction instruction{OP_BOOL, m_invert, 0, 0, m_info.get()};
+  if (m_info->IsConstant())
+  {
+    instruction.op = OP_CONST;
+    instruction.value = m_invert ^ m_info->Get();
+    instruction.info = nullptr;
+  }
+  else
+  {
+    const auto single = std::dynamic_pointer_cast<InfoSingle>(m_info);
+    if (single && single->ListItemDependent())
+    {
+      instruction.op = OP_ITEM_BOOL;
+      instruction.condition = single->GetCondition();
+    }
+    infos.push_back(m_info);
+  }
+  program.push_back(instruction);
+}
+
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
     node_type_t type,
     const InfoSubexpressionPtr &left,
@@ -92,21 +237,91 @@ bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
    * A AND B == !(!A OR !B)
    * to convert ANDs into ORs
    */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
   bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  for (const auto& child : m_children)
+  {
+    if (use_and ^ child->Evaluate(item))
+    {
+      child->m_hits++;
+      return !use_and;
+    }
+  }
+  return use_and;
+}
+
+bool InfoExpression::InfoAssociativeGroup::Rank()
+{
+  bool changed = false;
+  for (const auto& child : m_children)
+    changed |= child->Rank();
+
+  const auto byHits = [](const InfoSubexpressionPtr& a, const InfoSubexpressionPtr& b) {
+    return a->m_hits > b->m_hits;
+  };
+  if (!std::is_sorted(m_children.begin(), m_children.end(), byHits))
+  {
+    m_children.sort(byHits);
+    changed = true;
+  }
+
+  // older evaluations count less, so the order follows changes
+  for (const auto& child : m_children)
+    child->m_hits /= 2;
+
+  return changed;
+}
+
+void InfoExpression::InfoAssociativeGroup::Compile(Program& program,
+                                                   std::vector<InfoPtr>& infos) const
+{
+  /* A child with the value that decides the group (true for OR, false for AND)
+   * makes the group constant, children with the other value can be dropped.
+   */
+  const bool decides = (m_type == NODE_OR);
+  std::vector<Program> children;
+  std::vector<InfoPtr> childInfos;
+  for (const auto& child : m_children)
+  {
+    Program code;
+    child->Compile(code, childInfos);
+    if (IsConst(code))
+    {
+      if (code[0].value == decides)
+      {
+        program.push_back(code[0]);
+        return;
+      }
+      continue;
+    }
+    children.push_back(std::move(code));
+  }
+
+  if (children.empty())
+  {
+    program.push_back({OP_CONST, !decides, 0, 0, nullptr});
+    return;
+  }
+
+  std::stable_partition(children.begin(), children.end(), [](const Program& code) {
+    return std::none_of(code.begin(), code.end(),
+                        [](const Instruction& instruction) { return instruction.op == OP_ITEM_BOOL; });
+  });
+
+  size_t size = children.size() - 1;
+  for (const auto& code : children)
+    size += code.size();
+
+  const size_t end = program.size() + size;
+  for (size_t i = 0; i < children.size(); i++)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
+    program.insert(program.end(), children[i].begin(), children[i].end());
+    if (i + 1 < children.size())
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      const unsigned int offset = static_cast<unsigned int>(end - program.size() - 1);
+      program.push_back({OP_JUMP, decides, offset, 0, nullptr});
     }
   }
-  return use_and ^ result;
+  infos.insert(infos.end(), childInfos.begin(), childInfos.end());
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
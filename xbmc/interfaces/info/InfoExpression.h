@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+class CGUIInfoManager;
 class CGUIListItem;
 
 namespace INFO
@@ -24,24 +25,32 @@ namespace INFO
 class InfoSingle : public InfoBool
 {
 public:
-  InfoSingle(const std::string& expression, int context, unsigned int& refreshCounter)
-    : InfoBool(expression, context, refreshCounter)
+  InfoSingle(const std::string& expression, int context, const InfoRefreshCounters& refreshCounters)
+    : InfoBool(expression, context, refreshCounters)
   {
   }
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+
+  int GetCondition() const { return m_condition; }
 private:
   int m_condition;             ///< actual condition this represents
 };
 
 /*! \brief Class to wrap active boolean expressions
+
+ The expression is parsed into a tree, which is then compiled into a flat program that
+ Update runs with an accumulator: leaves load a value, jumps skip the rest of an AND or
+ OR group once its value is known. Constant leaves are folded away while compiling.
+ Some updates evaluate the tree instead, counting which children decide their group, and
+ the program is compiled again when that changes the order of the children.
  */
 class InfoExpression : public InfoBool
 {
 public:
-  InfoExpression(const std::string& expression, int context, unsigned int& refreshCounter)
-    : InfoBool(expression, context, refreshCounter)
+  InfoExpression(const std::string& expression, int context, const InfoRefreshCounters& refreshCounters)
+    : InfoBool(expression, context, refreshCounters)
   {
   }
   ~InfoExpression() override = default;
@@ -50,6 +59,25 @@ public:
 
   void Update(const CGUIListItem *item) override;
 private:
+  typedef enum
+  {
+    OP_CONST,     // result = value
+    OP_BOOL,      // result = value ^ info->Get(item)
+    OP_ITEM_BOOL, // same for list item dependent conditions, item ones skip the InfoBool
+    OP_JUMP,      // if result == value, skip offset instructions
+  } opcode_t;
+
+  struct Instruction
+  {
+    opcode_t op;
+    bool value;
+    unsigned int offset;
+    int condition;
+    InfoBool* info;
+  };
+
+  typedef std::vector<Instruction> Program;
+
   typedef enum
   {
     OPERATOR_NONE  = 0,
@@ -74,6 +102,12 @@ private:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
     virtual bool Evaluate(const CGUIListItem *item) = 0;
     virtual node_type_t Type() const=0;
+    // Append the program of this node, keeping the infos it refers to alive in infos
+    virtual void Compile(Program& program, std::vector<InfoPtr>& infos) const = 0;
+    // Order children by how often they decided their group, true if the order changed
+    virtual bool Rank() { return false; }
+
+    unsigned int m_hits = 0; ///< evaluations in which this node decided its parent group
   };
 
   typedef std::shared_ptr<InfoSubexpression> InfoSubexpressionPtr;
@@ -85,6 +119,7 @@ private:
     InfoLeaf(InfoPtr info, bool invert) : m_info(std::move(info)), m_invert(invert) {}
     bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return NODE_LEAF; }
+    void Compile(Program& program, std::vector<InfoPtr>& infos) const override;
 
   private:
     InfoPtr m_info;
@@ -100,6 +135,8 @@ private:
     void Merge(const std::shared_ptr<InfoAssociativeGroup>& other);
     bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return m_type; }
+    void Compile(Program& program, std::vector<InfoPtr>& infos) const override;
+    bool Rank() override;
 
   private:
     node_type_t m_type;
@@ -109,7 +146,16 @@ private:
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
+  void Compile();
+  static bool IsConst(const Program& program) { return program.size() == 1 && program[0].op == OP_CONST; }
+  static void ThreadJumps(Program& program);
+
   InfoSubexpressionPtr m_expression_tree;
+  Program m_program;
+  std::vector<InfoPtr> m_infos; ///< infos the program refers to
+  CGUIInfoManager* m_infoMgr = nullptr;
+  unsigned int m_updates = 0;
+  unsigned int m_samples = 0;
 };
 
 };
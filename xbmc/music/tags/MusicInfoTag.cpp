@@ -271,6 +271,16 @@ const ReplayGain& CMusicInfoTag::GetReplayGain() const
   return m_replayGain;
 }
 
+int CMusicInfoTag::GetEncoderDelay() const
+{
+  return m_encoderDelay;
+}
+
+int CMusicInfoTag::GetEncoderPadding() const
+{
+  return m_encoderPadding;
+}
+
 CAlbum::ReleaseType CMusicInfoTag::GetAlbumReleaseType() const
 {
   return m_albumReleaseType;
@@ -752,6 +762,16 @@ void CMusicInfoTag::SetReplayGain(const ReplayGain& aGain)
   m_replayGain = aGain;
 }
 
+void CMusicInfoTag::SetEncoderDelay(int frames)
+{
+  m_encoderDelay = frames;
+}
+
+void CMusicInfoTag::SetEncoderPadding(int frames)
+{
+  m_encoderPadding = frames;
+}
+
 void CMusicInfoTag::SetAlbumReleaseType(CAlbum::ReleaseType releaseType)
 {
   m_albumReleaseType = releaseType;
@@ -1181,6 +1201,8 @@ void CMusicInfoTag::Clear()
   m_iAlbumId = -1;
   m_coverArt.Clear();
   m_replayGain = ReplayGain();
+  m_encoderDelay = 0;
+  m_encoderPadding = 0;
   m_albumReleaseType = CAlbum::Album;
   m_listeners = 0;
   m_Rating = 0;
@@ -87,6 +87,8 @@ public:
   const std::string& GetStationArt() const;
   const EmbeddedArtInfo &GetCoverArtInfo() const;
   const ReplayGain& GetReplayGain() const;
+  int GetEncoderDelay() const;
+  int GetEncoderPadding() const;
   CAlbum::ReleaseType GetAlbumReleaseType() const;
 
   void SetURL(const std::string& strURL);
@@ -146,6 +148,8 @@ public:
   void SetBoxset(bool boxset);
   void SetCoverArtInfo(size_t size, const std::string &mimeType);
   void SetReplayGain(const ReplayGain& aGain);
+  void SetEncoderDelay(int frames);
+  void SetEncoderPadding(int frames);
   void SetAlbumReleaseType(CAlbum::ReleaseType releaseType);
   void SetType(const MediaType& mediaType);
   void SetDiscSubtitle(const std::string& strDiscSubtitle);
@@ -259,5 +263,8 @@ protected:
   EmbeddedArtInfo m_coverArt; ///< art information
 
   ReplayGain m_replayGain; ///< ReplayGain information
+
+  int m_encoderDelay = 0; ///< priming frames the encoder added before the audio (gapless)
+  int m_encoderPadding = 0; ///< frames the encoder appended after the audio (gapless)
 };
 }
@@ -8,6 +8,7 @@
 
 #include "TagLoaderTagLib.h"
 
+#include <sstream>
 #include <vector>
 
 #include <taglib/id3v1tag.h>
@@ -339,8 +340,12 @@ bool CTagLoaderTagLib::ParseTag(ID3v2::Tag *id3v2, EmbeddedArt *art, MUSIC_INFO:
       for (ID3v2::FrameList::ConstIterator ct = it->second.begin(); ct != it->second.end(); ++ct)
       {
         ID3v2::CommentsFrame *commentsFrame = dynamic_cast<ID3v2::CommentsFrame *> (*ct);
-        if (commentsFrame && commentsFrame->description().isEmpty())
+        if (!commentsFrame)
+          continue;
+        if (commentsFrame->description().isEmpty())
           tag.SetComment(commentsFrame->text().to8Bit(true));
+        else if (commentsFrame->description() == "iTunSMPB")
+          SetGaplessInfo(tag, commentsFrame->text().to8Bit(true));
       }
     else if (it->first == "TXXX")
       // Loop through and process the UserTextIdentificationFrames
@@ -902,6 +907,8 @@ bool CTagLoaderTagLib::ParseTag(MP4::Tag *mp4, EmbeddedArt *art, CMusicInfoTag&
       replayGainInfo.ParsePeak(ReplayGain::TRACK, it->second.toStringList().front().toCString());
     else if (it->first == "----:com.apple.iTunes:replaygain_album_peak")
       replayGainInfo.ParsePeak(ReplayGain::ALBUM, it->second.toStringList().front().toCString());
+    else if (it->first == "----:com.apple.iTunes:iTunSMPB")
+      SetGaplessInfo(tag, it->second.toStringList().front().to8Bit(true));
     else if (it->first == "----:com.apple.iTunes:MusicBrainz Artist Id")
       tag.SetMusicBrainzArtistID(SplitMBID(StringListToVectorString(it->second.toStringList())));
     else if (it->first == "----:com.apple.iTunes:MusicBrainz Album Artist Id")
@@ -1100,6 +1107,22 @@ void CTagLoaderTagLib::SetReleaseType(CMusicInfoTag &tag, const std::vector<std:
     tag.SetMusicBrainzReleaseType(StringUtils::Join(values, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator));
 }
 
+void CTagLoaderTagLib::SetGaplessInfo(CMusicInfoTag& tag, const std::string& iTunSMPB)
+{
+  // iTunes gapless info, hex fields: reserved, encoder delay, padding, original length, ...
+  std::istringstream fields(iTunSMPB);
+  unsigned int reserved, delay, padding;
+  if (!(fields >> std::hex >> reserved >> delay >> padding))
+    return;
+
+  // anything above a few packets is garbage
+  if (delay > 0xFFFF || padding > 0xFFFF)
+    return;
+
+  tag.SetEncoderDelay(delay);
+  tag.SetEncoderPadding(padding);
+}
+
 void CTagLoaderTagLib::AddArtistRole(CMusicInfoTag &tag, const std::string& strRole, const std::vector<std::string> &values)
 {
   if (values.size() == 1)
@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <taglib/apetag.h>
 #include <taglib/asftag.h>
+#include <taglib/commentsframe.h>
 #include <taglib/id3v1genres.h>
 #include <taglib/id3v1tag.h>
 #include <taglib/id3v2tag.h>
@@ -228,3 +229,46 @@ TEST_F(TestTagLoaderTagLib, SplitMBID)
   EXPECT_STREQ(result[0].c_str(), "0383dadf-2a4e-4d10-a46a-e9e041da8eb3");
   EXPECT_STREQ(result[1].c_str(), "53b106e7-0cc6-42cc-ac95-ed8d30a3a98e");
 }
+
+class TestGaplessInfo : public ::testing::Test, public CTagLoaderTagLib
+{
+protected:
+  // LAME encoded, 576 frames delay and 1468 frames padding
+  const String m_iTunSMPB{" 00000000 00000240 000005BC 0000000000A1C0E4 00000000 00000000"};
+};
+
+TEST_F(TestGaplessInfo, MP4)
+{
+  MP4::Tag mp4;
+  mp4.setItem("----:com.apple.iTunes:iTunSMPB", StringList(m_iTunSMPB));
+
+  CMusicInfoTag tag;
+  EXPECT_TRUE(CTagLoaderTagLib::ParseTag<MP4::Tag>(&mp4, nullptr, tag));
+  EXPECT_EQ(576, tag.GetEncoderDelay());
+  EXPECT_EQ(1468, tag.GetEncoderPadding());
+}
+
+TEST_F(TestGaplessInfo, ID3v2)
+{
+  ID3v2::Tag id3v2;
+  auto frame = new ID3v2::CommentsFrame();
+  frame->setDescription("iTunSMPB");
+  frame->setText(m_iTunSMPB);
+  id3v2.addFrame(frame);
+
+  CMusicInfoTag tag;
+  EXPECT_TRUE(CTagLoaderTagLib::ParseTag<ID3v2::Tag>(&id3v2, nullptr, tag));
+  EXPECT_EQ(576, tag.GetEncoderDelay());
+  EXPECT_EQ(1468, tag.GetEncoderPadding());
+  EXPECT_EQ("", tag.GetComment());
+}
+
+TEST_F(TestGaplessInfo, Invalid)
+{
+  CMusicInfoTag tag;
+  SetGaplessInfo(tag, "garbage");
+  EXPECT_EQ(0, tag.GetEncoderDelay());
+  SetGaplessInfo(tag, " 00000000 FFFFFFFF 00000000");
+  EXPECT_EQ(0, tag.GetEncoderDelay());
+  EXPECT_EQ(0, tag.GetEncoderPadding());
+}
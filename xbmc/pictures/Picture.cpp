@@ -20,6 +20,7 @@
 #include "utils/URIUtils.h"
 #include "guilib/Texture.h"
 #include "guilib/imagefactory.h"
+#include "cores/VideoPlayer/DVDCodecs/SliceScaler.h"
 
 extern "C" {
 #include <libswscale/swscale.h>
@@ -338,22 +339,14 @@ bool CPicture::ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned in
                           uint8_t *out_pixels, unsigned int out_width, unsigned int out_height, unsigned int out_pitch,
                           CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  struct SwsContext *context = sws_getContext(in_width, in_height, AV_PIX_FMT_BGRA,
-                                                         out_width, out_height, AV_PIX_FMT_BGRA,
-                                                         CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), NULL, NULL, NULL);
-
-  uint8_t *src[] = { in_pixels, 0, 0, 0 };
+  const uint8_t* src[] = {in_pixels, nullptr, nullptr, nullptr};
   int     srcStride[] = { (int)in_pitch, 0, 0, 0 };
   uint8_t *dst[] = { out_pixels , 0, 0, 0 };
   int     dstStride[] = { (int)out_pitch, 0, 0, 0 };
 
-  if (context)
-  {
-    sws_scale(context, src, srcStride, 0, in_height, dst, dstStride);
-    sws_freeContext(context);
-    return true;
-  }
-  return false;
+  return CSliceScaler::Scale(in_width, in_height, AV_PIX_FMT_BGRA, src, srcStride, out_width,
+                             out_height, AV_PIX_FMT_BGRA, dst, dstStride,
+                             CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm));
 }
 
 bool CPicture::OrientateImage(uint32_t *&pixels, unsigned int &width, unsigned int &height, int orientation)
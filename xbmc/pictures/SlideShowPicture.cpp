@@ -840,6 +840,7 @@ void CSlideShowPic::Render(float* x, float* y, CTexture* pTexture, UTILS::COLOR:
 
 #elif defined(HAS_GL)
   CRenderSystemGL *renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+  renderSystem->FlushGUIBatch();
   if (pTexture)
   {
     pTexture->LoadToGPU();
@@ -940,6 +941,7 @@ void CSlideShowPic::Render(float* x, float* y, CTexture* pTexture, UTILS::COLOR:
 
 #elif defined(HAS_GLES)
   CRenderSystemGLES *renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+  renderSystem->FlushGUIBatch();
   if (pTexture)
   {
     pTexture->LoadToGPU();
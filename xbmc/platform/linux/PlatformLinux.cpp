@@ -8,6 +8,7 @@
 
 #include "PlatformLinux.h"
 
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
 #include "utils/StringUtils.h"
 
 #include "platform/linux/powermanagement/LinuxPowerSyscall.h"
@@ -98,6 +99,10 @@ bool CPlatformLinux::InitStageOne()
   {
     OPTIONALS::SndioRegister();
   }
+  else if (StringUtils::EqualsNoCase(envSink, "NULL"))
+  {
+    CAESinkNULL::Register();
+  }
   else if (StringUtils::EqualsNoCase(envSink, "ALSA+PULSE"))
   {
     OPTIONALS::ALSARegister();
@@ -41,6 +41,11 @@ bool CRenderSystemBase::SupportsNPOT(bool dxt) const
   return true;
 }
 
+bool CRenderSystemBase::SupportsDXT() const
+{
+  return false;
+}
+
 bool CRenderSystemBase::SupportsStereo(RENDER_STEREO_MODE mode) const
 {
   switch(mode)
@@ -66,11 +66,36 @@ public:
 
   virtual std::string GetShaderPath(const std::string &filename) { return ""; }
 
+  /**
+   * Draw gui textures the render system batched so far. Code that sets render state or draws
+   * by itself has to call this first, the render state functions above do it implicitly.
+   */
+  virtual void FlushGUIBatch() {}
+
+  /**
+   * Count a draw call of the gui, reported for the last frame by GetGUIDrawCalls
+   */
+  void AddGUIDrawCall() { m_guiDrawCalls++; }
+  unsigned int GetGUIDrawCalls() const { return m_guiDrawCallsLastFrame; }
+
+  /**
+   * Count a texture bound for drawing the gui, reported for the last frame by
+   * GetGUITextureBinds. Drawing with the texture of the previous draw call is not counted.
+   */
+  void AddGUITextureBind(unsigned int texture)
+  {
+    if (texture != m_guiBoundTexture)
+      m_guiTextureBinds++;
+    m_guiBoundTexture = texture;
+  }
+  unsigned int GetGUITextureBinds() const { return m_guiTextureBindsLastFrame; }
+
   void GetRenderVersion(unsigned int& major, unsigned int& minor) const;
   const std::string& GetRenderVendor() const { return m_RenderVendor; }
   const std::string& GetRenderRenderer() const { return m_RenderRenderer; }
   const std::string& GetRenderVersionString() const { return m_RenderVersion; }
   virtual bool SupportsNPOT(bool dxt) const;
+  virtual bool SupportsDXT() const;
   virtual bool SupportsStereo(RENDER_STEREO_MODE mode) const;
   unsigned int GetMaxTextureSize() const { return m_maxTextureSize; }
   unsigned int GetMinDXTPitch() const { return m_minDXTPitch; }
@@ -91,6 +116,11 @@ protected:
   RENDER_STEREO_VIEW m_stereoView = RENDER_STEREO_VIEW_OFF;
   RENDER_STEREO_MODE m_stereoMode = RENDER_STEREO_MODE_OFF;
   bool m_limitedColorRange = false;
+  unsigned int m_guiDrawCalls = 0;
+  unsigned int m_guiDrawCallsLastFrame = 0;
+  unsigned int m_guiTextureBinds = 0;
+  unsigned int m_guiTextureBindsLastFrame = 0;
+  unsigned int m_guiBoundTexture = 0;
 
   std::unique_ptr<CGUIImage> m_splashImage;
   std::unique_ptr<CGUITextLayout> m_splashMessageLayout;
@@ -22,8 +22,16 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <cstddef>
+
 using namespace std::chrono_literals;
 
+namespace
+{
+// quads of a batch are indexed with unsigned shorts
+constexpr size_t GUI_BATCH_MAX_QUADS = 0x10000 / 4;
+} // namespace
+
 CRenderSystemGL::CRenderSystemGL() : CRenderSystemBase()
 {
 }
@@ -199,6 +207,15 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGL::DestroyRenderSystem()
 {
+  m_guiBatchVertices.clear();
+  if (m_guiBatchVertexVBO != GL_NONE)
+  {
+    glDeleteBuffers(1, &m_guiBatchVertexVBO);
+    glDeleteBuffers(1, &m_guiBatchIndexVBO);
+    m_guiBatchVertexVBO = GL_NONE;
+    m_guiBatchIndexVBO = GL_NONE;
+  }
+
   if (m_vertexArray != GL_NONE)
   {
     glDeleteVertexArrays(1, &m_vertexArray);
@@ -232,6 +249,13 @@ bool CRenderSystemGL::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+  m_guiDrawCallsLastFrame = m_guiDrawCalls;
+  m_guiDrawCalls = 0;
+  m_guiTextureBindsLastFrame = m_guiTextureBinds;
+  m_guiTextureBinds = 0;
+  m_guiBoundTexture = 0;
+
   return true;
 }
 
@@ -240,6 +264,8 @@ bool CRenderSystemGL::ClearBuffers(UTILS::COLOR::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+
   /* clear is not affected by stipple pattern, so we can only clear on first frame */
   if(m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return true;
@@ -285,6 +311,11 @@ bool CRenderSystemGL::SupportsNPOT(bool dxt) const
   return true;
 }
 
+bool CRenderSystemGL::SupportsDXT() const
+{
+  return IsExtSupported("GL_EXT_texture_compression_s3tc");
+}
+
 void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
 {
   SetVSync(true);
@@ -292,6 +323,7 @@ void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
   PresentRenderImpl(rendered);
 
   if (!rendered)
@@ -322,6 +354,8 @@ void CRenderSystemGL::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -335,6 +369,8 @@ void CRenderSystemGL::ApplyStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glBindVertexArray(m_vertexArray);
 
   glViewport(m_viewPort[0], m_viewPort[1], m_viewPort[2], m_viewPort[3]);
@@ -353,6 +389,8 @@ void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, i
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
 
@@ -428,6 +466,8 @@ void CRenderSystemGL::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -462,6 +502,8 @@ void CRenderSystemGL::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
+  FlushGUIBatch();
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
   GLint y1 = MathUtils::round_int(static_cast<double>(rect.y1));
   GLint x2 = MathUtils::round_int(static_cast<double>(rect.x2));
@@ -534,6 +576,7 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  FlushGUIBatch();
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -712,6 +755,8 @@ void CRenderSystemGL::ReleaseShaders()
 
 void CRenderSystemGL::EnableShader(ShaderMethodGL method)
 {
+  FlushGUIBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
@@ -780,6 +825,138 @@ GLint CRenderSystemGL::ShaderGetModel()
   return -1;
 }
 
+bool CRenderSystemGL::GUIBatchState::operator==(const GUIBatchState& right) const
+{
+  return method == right.method && texture0 == right.texture0 && texture1 == right.texture1 &&
+         blend == right.blend && color == right.color;
+}
+
+void CRenderSystemGL::AddGUIQuads(const GUIBatchState& state,
+                                  const GUIVertex* vertices,
+                                  size_t count)
+{
+  if (!m_guiBatchVertices.empty() &&
+      (!(state == m_guiBatchState) ||
+       (m_guiBatchVertices.size() + count) / 4 > GUI_BATCH_MAX_QUADS))
+    FlushGUIBatch();
+
+  m_guiBatchState = state;
+  m_guiBatchVertices.insert(m_guiBatchVertices.end(), vertices, vertices + count);
+}
+
+void CRenderSystemGL::FlushGUIBatch()
+{
+  if (m_guiBatchVertices.empty())
+    return;
+
+  const GUIBatchState& state = m_guiBatchState;
+  CGLShader* shader = m_pShader[state.method].get();
+  if (!shader)
+  {
+    CLog::Log(LOGERROR, "Invalid GUI Shader selected {}", state.method);
+    m_guiBatchVertices.clear();
+    return;
+  }
+
+  if (m_guiBatchVertexVBO == GL_NONE)
+  {
+    // the indices of all quads follow the same pattern, so they are only uploaded once
+    std::vector<GLushort> indices;
+    indices.reserve(GUI_BATCH_MAX_QUADS * 6);
+    for (size_t i = 0; i < GUI_BATCH_MAX_QUADS * 4; i += 4)
+    {
+      indices.push_back(i + 0);
+      indices.push_back(i + 1);
+      indices.push_back(i + 2);
+      indices.push_back(i + 2);
+      indices.push_back(i + 3);
+      indices.push_back(i + 0);
+    }
+
+    glGenBuffers(1, &m_guiBatchVertexVBO);
+    glGenBuffers(1, &m_guiBatchIndexVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_guiBatchIndexVBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), indices.data(),
+                 GL_STATIC_DRAW);
+  }
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, state.texture0);
+  AddGUITextureBind(state.texture0);
+  if (state.texture1)
+  {
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, state.texture1);
+  }
+
+  if (state.blend)
+  {
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    glEnable(GL_BLEND);
+  }
+  else
+  {
+    glDisable(GL_BLEND);
+  }
+
+  m_method = state.method;
+  shader->Enable();
+
+  GLint posLoc = shader->GetPosLoc();
+  GLint tex0Loc = shader->GetCord0Loc();
+  GLint tex1Loc = shader->GetCord1Loc();
+  GLint uniColLoc = shader->GetUniColLoc();
+
+  // orphan the previous batch, the driver doesn't have to wait until it was drawn
+  glBindBuffer(GL_ARRAY_BUFFER, m_guiBatchVertexVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(GUIVertex) * m_guiBatchVertices.size(), nullptr,
+               GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GUIVertex) * m_guiBatchVertices.size(),
+                  m_guiBatchVertices.data());
+
+  if (uniColLoc >= 0)
+  {
+    glUniform4f(uniColLoc, (state.color[0] / 255.0f), (state.color[1] / 255.0f),
+                (state.color[2] / 255.0f), (state.color[3] / 255.0f));
+  }
+
+  if (state.texture1)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                          reinterpret_cast<const GLvoid*>(offsetof(GUIVertex, u2)));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(GUIVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(GUIVertex, x)));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(GUIVertex, u1)));
+  glEnableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_guiBatchIndexVBO);
+  glDrawElements(GL_TRIANGLES, m_guiBatchVertices.size() * 6 / 4, GL_UNSIGNED_SHORT, 0);
+  m_guiDrawCalls++;
+
+  if (state.texture1)
+    glDisableVertexAttribArray(tex1Loc);
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  if (state.texture1)
+    glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  shader->Disable();
+  m_method = ShaderMethodGL::SM_DEFAULT;
+
+  m_guiBatchVertices.clear();
+}
+
 std::string CRenderSystemGL::GetShaderPath(const std::string &filename)
 {
   std::string path = "GL/1.2/";
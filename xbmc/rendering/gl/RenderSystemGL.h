@@ -12,8 +12,10 @@
 #include "rendering/RenderSystem.h"
 #include "utils/ColorUtils.h"
 
+#include <array>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "system_gl.h"
 
@@ -62,6 +64,7 @@ public:
   void SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view) override;
   bool SupportsStereo(RENDER_STEREO_MODE mode) const override;
   bool SupportsNPOT(bool dxt) const override;
+  bool SupportsDXT() const override;
 
   void Project(float &x, float &y, float &z) override;
 
@@ -82,6 +85,32 @@ public:
   GLint ShaderGetUniCol();
   GLint ShaderGetModel();
 
+  // batched gui textures
+  struct GUIVertex
+  {
+    float x, y, z;
+    float u1, v1;
+    float u2, v2;
+  };
+
+  struct GUIBatchState
+  {
+    ShaderMethodGL method;
+    GLuint texture0;
+    GLuint texture1; ///< diffuse texture, 0 if there is none
+    bool blend;
+    std::array<GLubyte, 4> color;
+
+    bool operator==(const GUIBatchState& right) const;
+  };
+
+  /*! \brief Queue quads of a gui texture, four vertices each.
+   Consecutive quads with the same state are drawn with a single draw call when the batch is
+   flushed, quads are never reordered.
+   */
+  void AddGUIQuads(const GUIBatchState& state, const GUIVertex* vertices, size_t count);
+  void FlushGUIBatch() override;
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
@@ -103,4 +132,9 @@ protected:
   std::map<ShaderMethodGL, std::unique_ptr<CGLShader>> m_pShader;
   ShaderMethodGL m_method = ShaderMethodGL::SM_DEFAULT;
   GLuint m_vertexArray = GL_NONE;
+
+  GUIBatchState m_guiBatchState;
+  std::vector<GUIVertex> m_guiBatchVertices;
+  GLuint m_guiBatchVertexVBO = GL_NONE;
+  GLuint m_guiBatchIndexVBO = GL_NONE;
 };
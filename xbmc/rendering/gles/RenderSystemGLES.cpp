@@ -25,8 +25,16 @@
 #include "utils/EGLUtils.h"
 #endif
 
+#include <cstddef>
+
 using namespace std::chrono_literals;
 
+namespace
+{
+// quads of a batch are indexed with unsigned shorts
+constexpr size_t GUI_BATCH_MAX_QUADS = 0x10000 / 4;
+} // namespace
+
 CRenderSystemGLES::CRenderSystemGLES()
  : CRenderSystemBase()
 {
@@ -152,6 +160,7 @@ bool CRenderSystemGLES::DestroyRenderSystem()
   glFinish();
   PresentRenderImpl(true);
 
+  m_guiBatchVertices.clear();
   ReleaseShaders();
   m_bRenderCreated = false;
 
@@ -181,6 +190,13 @@ bool CRenderSystemGLES::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+  m_guiDrawCallsLastFrame = m_guiDrawCalls;
+  m_guiDrawCalls = 0;
+  m_guiTextureBindsLastFrame = m_guiTextureBinds;
+  m_guiTextureBinds = 0;
+  m_guiBoundTexture = 0;
+
   return true;
 }
 
@@ -189,6 +205,8 @@ bool CRenderSystemGLES::ClearBuffers(UTILS::COLOR::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+
   float r = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color) / 255.0f;
   float g = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color) / 255.0f;
   float b = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color) / 255.0f;
@@ -227,6 +245,7 @@ void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
   PresentRenderImpl(rendered);
 
   // if video is rendered to a separate layer, we should not block this thread
@@ -257,6 +276,8 @@ void CRenderSystemGLES::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -272,6 +293,8 @@ void CRenderSystemGLES::ApplyStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glMatrixProject.PopLoad();
   glMatrixModview.PopLoad();
   glMatrixTexture.PopLoad();
@@ -286,6 +309,8 @@ void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth,
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
   float w = (float)m_viewPort[2]*0.5f;
@@ -334,6 +359,8 @@ void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -368,6 +395,8 @@ void CRenderSystemGLES::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
+  FlushGUIBatch();
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
   GLint y1 = MathUtils::round_int(static_cast<double>(rect.y1));
   GLint x2 = MathUtils::round_int(static_cast<double>(rect.x2));
@@ -555,6 +584,8 @@ void CRenderSystemGLES::ReleaseShaders()
 
 void CRenderSystemGLES::EnableGUIShader(ShaderMethodGLES method)
 {
+  FlushGUIBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
@@ -655,6 +686,121 @@ GLint CRenderSystemGLES::GUIShaderGetBrightness()
   return -1;
 }
 
+bool CRenderSystemGLES::GUIBatchState::operator==(const GUIBatchState& right) const
+{
+  return method == right.method && texture0 == right.texture0 && texture1 == right.texture1 &&
+         blend == right.blend && color == right.color;
+}
+
+void CRenderSystemGLES::AddGUIQuads(const GUIBatchState& state,
+                                    const GUIVertex* vertices,
+                                    size_t count)
+{
+  if (!m_guiBatchVertices.empty() &&
+      (!(state == m_guiBatchState) ||
+       (m_guiBatchVertices.size() + count) / 4 > GUI_BATCH_MAX_QUADS))
+    FlushGUIBatch();
+
+  m_guiBatchState = state;
+  m_guiBatchVertices.insert(m_guiBatchVertices.end(), vertices, vertices + count);
+}
+
+void CRenderSystemGLES::FlushGUIBatch()
+{
+  if (m_guiBatchVertices.empty())
+    return;
+
+  const GUIBatchState& state = m_guiBatchState;
+  CGLESShader* shader = m_pShader[state.method].get();
+  if (!shader)
+  {
+    CLog::Log(LOGERROR, "Invalid GUI Shader selected - {}", state.method);
+    m_guiBatchVertices.clear();
+    return;
+  }
+
+  // the indices of all quads follow the same pattern, so they are only built once
+  if (m_guiBatchIndices.empty())
+  {
+    m_guiBatchIndices.reserve(GUI_BATCH_MAX_QUADS * 6);
+    for (size_t i = 0; i < GUI_BATCH_MAX_QUADS * 4; i += 4)
+    {
+      m_guiBatchIndices.push_back(i + 0);
+      m_guiBatchIndices.push_back(i + 1);
+      m_guiBatchIndices.push_back(i + 2);
+      m_guiBatchIndices.push_back(i + 2);
+      m_guiBatchIndices.push_back(i + 3);
+      m_guiBatchIndices.push_back(i + 0);
+    }
+  }
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, state.texture0);
+  AddGUITextureBind(state.texture0);
+  if (state.texture1)
+  {
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, state.texture1);
+  }
+
+  if (state.blend)
+  {
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    glEnable(GL_BLEND);
+  }
+  else
+  {
+    glDisable(GL_BLEND);
+  }
+
+  m_method = state.method;
+  shader->Enable();
+
+  GLint posLoc = shader->GetPosLoc();
+  GLint tex0Loc = shader->GetCord0Loc();
+  GLint tex1Loc = shader->GetCord1Loc();
+  GLint uniColLoc = shader->GetUniColLoc();
+
+  if (uniColLoc >= 0)
+  {
+    glUniform4f(uniColLoc, (state.color[0] / 255.0f), (state.color[1] / 255.0f),
+                (state.color[2] / 255.0f), (state.color[3] / 255.0f));
+  }
+
+  const char* vertices = reinterpret_cast<const char*>(m_guiBatchVertices.data());
+  if (state.texture1)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                          vertices + offsetof(GUIVertex, u2));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(GUIVertex),
+                        vertices + offsetof(GUIVertex, x));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(GUIVertex),
+                        vertices + offsetof(GUIVertex, u1));
+  glEnableVertexAttribArray(tex0Loc);
+
+  glDrawElements(GL_TRIANGLES, m_guiBatchVertices.size() * 6 / 4, GL_UNSIGNED_SHORT,
+                 m_guiBatchIndices.data());
+  m_guiDrawCalls++;
+
+  if (state.texture1)
+    glDisableVertexAttribArray(tex1Loc);
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
+
+  if (state.texture1)
+    glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  shader->Disable();
+  m_method = ShaderMethodGLES::SM_DEFAULT;
+
+  m_guiBatchVertices.clear();
+}
+
 bool CRenderSystemGLES::SupportsStereo(RENDER_STEREO_MODE mode) const
 {
   return CRenderSystemBase::SupportsStereo(mode);
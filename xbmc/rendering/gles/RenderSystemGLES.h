@@ -12,7 +12,9 @@
 #include "rendering/RenderSystem.h"
 #include "utils/ColorUtils.h"
 
+#include <array>
 #include <map>
+#include <vector>
 
 #include "system_gl.h"
 
@@ -87,6 +89,32 @@ public:
   GLint GUIShaderGetBrightness();
   GLint GUIShaderGetModel();
 
+  // batched gui textures
+  struct GUIVertex
+  {
+    float x, y, z;
+    float u1, v1;
+    float u2, v2;
+  };
+
+  struct GUIBatchState
+  {
+    ShaderMethodGLES method;
+    GLuint texture0;
+    GLuint texture1; ///< diffuse texture, 0 if there is none
+    bool blend;
+    std::array<GLubyte, 4> color;
+
+    bool operator==(const GUIBatchState& right) const;
+  };
+
+  /*! \brief Queue quads of a gui texture, four vertices each.
+   Consecutive quads with the same state are drawn with a single draw call when the batch is
+   flushed, quads are never reordered.
+   */
+  void AddGUIQuads(const GUIBatchState& state, const GUIVertex* vertices, size_t count);
+  void FlushGUIBatch() override;
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
@@ -102,5 +130,9 @@ protected:
   ShaderMethodGLES m_method = ShaderMethodGLES::SM_DEFAULT;
 
   GLint      m_viewPort[4];
+
+  GUIBatchState m_guiBatchState;
+  std::vector<GUIVertex> m_guiBatchVertices;
+  std::vector<GLushort> m_guiBatchIndices;
 };
 
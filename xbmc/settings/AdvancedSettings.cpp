@@ -120,6 +120,10 @@ void CAdvancedSettings::Initialize()
   //default hold time of 25 ms, this allows a 20 hertz sine to pass undistorted
   m_limiterHold = 0.025f;
   m_limiterRelease = 0.1f;
+  m_audioLowLatency = false;
+  m_audioLookAheadSeconds = 20;
+  m_audioLookAheadMaxSize = 16;
+  m_audioDecodeAheadMs = 1000;
 
   m_seekSteps = { 10, 30, 60, 180, 300, 600, 1800 };
 
@@ -141,6 +145,7 @@ void CAdvancedSettings::Initialize()
   m_videoPPFFmpegPostProc = "ha:128:7,va,dr";
   m_videoDefaultPlayer = "VideoPlayer";
   m_videoIgnoreSecondsAtStart = 3*60;
+  m_videoPrefetchNextItemSeconds = 15;
   m_videoIgnorePercentAtEnd   = 8.0f;
   m_videoPlayCountMinimumPercent = 90.0f;
   m_videoVDPAUScaling = -1;
@@ -271,6 +276,7 @@ void CAdvancedSettings::Initialize()
   m_fanartRes = 1080;
   m_imageRes = 720;
   m_imageScalingAlgorithm = CPictureScalingAlgorithm::Default;
+  m_useDDSTextures = false;
 
   m_sambaclienttimeout = 30;
   m_sambadoscodepage = "";
@@ -410,6 +416,7 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiTextureAtlas = true;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -580,6 +587,10 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
     XMLUtils::GetFloat(pElement, "limiterhold", m_limiterHold, 0.0f, 100.0f);
     XMLUtils::GetFloat(pElement, "limiterrelease", m_limiterRelease, 0.001f, 100.0f);
+    XMLUtils::GetBoolean(pElement, "lowlatency", m_audioLowLatency);
+    XMLUtils::GetInt(pElement, "lookaheadseconds", m_audioLookAheadSeconds, 0, 120);
+    XMLUtils::GetInt(pElement, "lookaheadmaxsize", m_audioLookAheadMaxSize, 1, 256);
+    XMLUtils::GetInt(pElement, "decodeaheadms", m_audioDecodeAheadMs, 0, 10000);
   }
 
   pElement = pRootElement->FirstChildElement("x11");
@@ -602,6 +613,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     // 101 on purpose - can be used to never automark as watched
     XMLUtils::GetFloat(pElement, "playcountminimumpercent", m_videoPlayCountMinimumPercent, 0.0f, 101.0f);
     XMLUtils::GetInt(pElement, "ignoresecondsatstart", m_videoIgnoreSecondsAtStart, 0, 900);
+    XMLUtils::GetInt(pElement, "prefetchnextitemseconds", m_videoPrefetchNextItemSeconds, 0, 600);
     XMLUtils::GetFloat(pElement, "ignorepercentatend", m_videoIgnorePercentAtEnd, 0, 100.0f);
 
     XMLUtils::GetBoolean(pElement, "usetimeseeking", m_videoUseTimeSeeking);
@@ -1073,6 +1085,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   XMLUtils::GetUInt(pRootElement, "imageres", m_imageRes, 0, 9999);
   if (XMLUtils::GetString(pRootElement, "imagescalingalgorithm", tmp))
     m_imageScalingAlgorithm = CPictureScalingAlgorithm::FromString(tmp);
+  XMLUtils::GetBoolean(pRootElement, "useddstextures", m_useDDSTextures);
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
   XMLUtils::GetBoolean(pRootElement, "uselocalecollation", m_useLocaleCollation);
   XMLUtils::GetBoolean(pRootElement, "detectasudf", m_detectAsUdf);
@@ -1230,6 +1243,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "textureatlas", m_guiTextureAtlas);
   }
 
   std::string seekSteps;
@@ -130,6 +130,10 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_VideoPlayerIgnoreDTSinWAV;
     float m_limiterHold;
     float m_limiterRelease;
+    bool m_audioLowLatency; ///< run the audio engine with small buffers for all streams
+    int m_audioLookAheadSeconds; ///< seconds of the next track paplayer decodes ahead
+    int m_audioLookAheadMaxSize; ///< upper limit of the look ahead buffer in MB
+    int m_audioDecodeAheadMs; ///< decoded audio videoplayer keeps ahead of the sink for network and realtime streams, 0 disables
 
     bool  m_omlSync = true;
 
@@ -158,6 +162,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_musicPercentSeekForwardBig;
     int m_musicPercentSeekBackwardBig;
     int m_videoIgnoreSecondsAtStart;
+    int m_videoPrefetchNextItemSeconds;
     float m_videoIgnorePercentAtEnd;
     float m_audioApplyDrc;
 
@@ -230,6 +235,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     unsigned int m_fanartRes; ///< \brief the maximal resolution to cache fanart at (assumes 16x9)
     unsigned int m_imageRes;  ///< \brief the maximal resolution to cache images at (assumes 16x9)
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
+    bool m_useDDSTextures; ///< \brief keep DXT compressed copies of cached images, which load without decoding
 
     int m_sambaclienttimeout;
     std::string m_sambadoscodepage;
@@ -340,6 +346,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiTextureAtlas; //!< pack small skin images into shared textures
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <vector>
+
+/*!
+ * \brief Bounded lock free queue between exactly one producer and one consumer thread.
+ *
+ * Push() must only be called by the producer, Pop() only by the consumer. Neither
+ * allocates nor blocks, waking up the other side is up to the caller. Items are copied,
+ * the queue is meant for pointers and other small types.
+ */
+template<typename T>
+class CSPSCQueue
+{
+public:
+  explicit CSPSCQueue(size_t capacity) : m_items(capacity + 1) {}
+
+  CSPSCQueue(const CSPSCQueue&) = delete;
+  CSPSCQueue& operator=(const CSPSCQueue&) = delete;
+
+  /*!
+   * \brief Append an item, producer only.
+   * \return false if the queue is full
+   */
+  bool Push(const T& item)
+  {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t next = Next(tail);
+    if (next == m_head.load(std::memory_order_acquire))
+      return false;
+
+    m_items[tail] = item;
+    m_tail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   * \brief Take the oldest item, consumer only.
+   * \return false if the queue is empty
+   */
+  bool Pop(T& item)
+  {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+      return false;
+
+    item = m_items[head];
+    m_head.store(Next(head), std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   * \brief Number of queued items. Exact for producer and consumer, a snapshot for
+   * every other thread.
+   */
+  size_t Size() const
+  {
+    const size_t head = m_head.load(std::memory_order_acquire);
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : tail + m_items.size() - head;
+  }
+
+  bool IsEmpty() const { return Size() == 0; }
+
+  size_t Capacity() const { return m_items.size() - 1; }
+
+  /*!
+   * \brief Drop all items. Producer and consumer must not run meanwhile, e.g. while
+   * one of them waits for the thread calling this.
+   */
+  void Clear()
+  {
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_release);
+  }
+
+private:
+  size_t Next(size_t pos) const { return pos + 1 == m_items.size() ? 0 : pos + 1; }
+
+  std::vector<T> m_items;
+  // producer and consumer each write one index, keep them on their own cache lines
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) std::atomic<size_t> m_tail{0};
+};
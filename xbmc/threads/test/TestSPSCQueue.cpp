@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/IRunnable.h"
+#include "threads/SPSCQueue.h"
+#include "threads/test/TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr unsigned int ITEMS = 100000;
+
+class producer : public IRunnable
+{
+  CSPSCQueue<unsigned int>& queue;
+
+public:
+  explicit producer(CSPSCQueue<unsigned int>& q) : queue(q) {}
+
+  void Run() override
+  {
+    for (unsigned int i = 1; i <= ITEMS;)
+    {
+      if (queue.Push(i))
+        i++;
+    }
+  }
+};
+} // namespace
+
+TEST(TestSPSCQueue, PushPop)
+{
+  CSPSCQueue<int> queue(3);
+  EXPECT_EQ(3u, queue.Capacity());
+  EXPECT_TRUE(queue.IsEmpty());
+
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_TRUE(queue.Push(3));
+  EXPECT_FALSE(queue.Push(4));
+  EXPECT_EQ(3u, queue.Size());
+
+  int item = 0;
+  EXPECT_TRUE(queue.Pop(item));
+  EXPECT_EQ(1, item);
+
+  // wrap around the end of the storage
+  EXPECT_TRUE(queue.Push(4));
+  for (int expected = 2; expected <= 4; expected++)
+  {
+    EXPECT_TRUE(queue.Pop(item));
+    EXPECT_EQ(expected, item);
+  }
+  EXPECT_FALSE(queue.Pop(item));
+  EXPECT_EQ(0u, queue.Size());
+}
+
+TEST(TestSPSCQueue, Clear)
+{
+  CSPSCQueue<int> queue(4);
+  queue.Push(1);
+  queue.Push(2);
+  queue.Clear();
+
+  int item;
+  EXPECT_FALSE(queue.Pop(item));
+  EXPECT_TRUE(queue.Push(5));
+  EXPECT_TRUE(queue.Pop(item));
+  EXPECT_EQ(5, item);
+}
+
+TEST(TestSPSCQueue, Threaded)
+{
+  CSPSCQueue<unsigned int> queue(16);
+  producer runnable(queue);
+  thread waitThread(runnable);
+
+  unsigned int expected = 1;
+  while (expected <= ITEMS)
+  {
+    unsigned int item;
+    if (!queue.Pop(item))
+      continue;
+    ASSERT_EQ(expected, item);
+    expected++;
+  }
+
+  EXPECT_TRUE(waitThread.timed_join(10s));
+  EXPECT_TRUE(queue.IsEmpty());
+}
@@ -27,6 +27,7 @@
 #include "settings/SettingUtils.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/CPUInfo.h"
 #include "utils/EmbeddedArt.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -77,29 +78,40 @@ bool CThumbExtractor::operator==(const CJob* job) const
   return false;
 }
 
-bool CThumbExtractor::DoWork()
+namespace
+{
+bool CanExtractFrom(const CFileItem& item)
 {
-  if (m_item.IsLiveTV()
+  if (item.IsLiveTV()
   // Due to a pvr addon api design flaw (no support for multiple concurrent streams
   // per addon instance), pvr recording thumbnail extraction does not work (reliably).
-  ||  URIUtils::IsPVRRecording(m_item.GetDynPath())
-  ||  URIUtils::IsUPnP(m_item.GetPath())
-  ||  URIUtils::IsBluray(m_item.GetPath())
-  ||  URIUtils::IsPlugin(m_item.GetDynPath()) // plugin path not fully resolved
-  ||  m_item.IsBDFile()
-  ||  m_item.IsDVD()
-  ||  m_item.IsDiscImage()
-  ||  m_item.IsDVDFile(false, true)
-  ||  m_item.IsInternetStream()
-  ||  m_item.IsDiscStub()
-  ||  m_item.IsPlayList())
+  ||  URIUtils::IsPVRRecording(item.GetDynPath())
+  ||  URIUtils::IsUPnP(item.GetPath())
+  ||  URIUtils::IsBluray(item.GetPath())
+  ||  URIUtils::IsPlugin(item.GetDynPath()) // plugin path not fully resolved
+  ||  item.IsBDFile()
+  ||  item.IsDVD()
+  ||  item.IsDiscImage()
+  ||  item.IsDVDFile(false, true)
+  ||  item.IsInternetStream()
+  ||  item.IsDiscStub()
+  ||  item.IsPlayList())
     return false;
 
   // For HTTP/FTP we only allow extraction when on a LAN
-  if (URIUtils::IsRemote(m_item.GetPath()) &&
-     !URIUtils::IsOnLAN(m_item.GetPath())  &&
-     (URIUtils::IsFTP(m_item.GetPath())    ||
-      URIUtils::IsHTTP(m_item.GetPath())))
+  if (URIUtils::IsRemote(item.GetPath()) &&
+     !URIUtils::IsOnLAN(item.GetPath())  &&
+     (URIUtils::IsFTP(item.GetPath())    ||
+      URIUtils::IsHTTP(item.GetPath())))
+    return false;
+
+  return true;
+}
+} // namespace
+
+bool CThumbExtractor::DoWork()
+{
+  if (!CanExtractFrom(m_item))
     return false;
 
   bool result=false;
@@ -181,8 +193,75 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CBatchThumbExtractor::CBatchThumbExtractor(const CFileItem& item,
+                                           std::vector<std::pair<std::string, int64_t>> targets)
+  : m_item(item), m_targets(std::move(targets))
+{
+  if (item.IsVideoDb() && item.HasVideoInfoTag())
+    m_item.SetPath(item.GetVideoInfoTag()->m_strFileNameAndPath);
+
+  if (m_item.IsStack())
+    m_item.SetPath(CStackDirectory::GetFirstStackedFile(m_item.GetPath()));
+}
+
+bool CBatchThumbExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CBatchThumbExtractor* jobExtract = dynamic_cast<const CBatchThumbExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath() &&
+        jobExtract->m_targets == m_targets)
+      return true;
+  }
+  return false;
+}
+
+bool CBatchThumbExtractor::DoWork()
+{
+  if (!CanExtractFrom(m_item) || m_targets.empty())
+    return false;
+
+  CLog::Log(LOGDEBUG, "{} - trying to extract {} thumbs from video file {}", __FUNCTION__,
+            m_targets.size(), CURL::GetRedacted(m_item.GetPath()));
+
+  std::vector<CTextureDetails> details(m_targets.size());
+  std::vector<CDVDFileInfo::ThumbRequest> requests(m_targets.size());
+  for (size_t i = 0; i < m_targets.size(); i++)
+  {
+    details[i].file = CTextureCache::GetCacheFile(m_targets[i].first) + ".jpg";
+    requests[i].pos = m_targets[i].second;
+    requests[i].details = &details[i];
+  }
+
+  unsigned int done = 0;
+  m_extracted.assign(m_targets.size(), false);
+  auto progress = [this, &requests, &done](const CDVDFileInfo::ThumbRequest& request) {
+    const size_t index = &request - requests.data();
+    if (request.extracted)
+    {
+      CTextureCache::GetInstance().AddCachedTexture(m_targets[index].first, *request.details);
+      m_extracted[index] = true;
+    }
+    m_lastCompleted = index;
+    return !ShouldCancel(++done, m_targets.size());
+  };
+
+  return CDVDFileInfo::ExtractThumbs(m_item, requests, nullptr, progress) > 0;
+}
+
+namespace
+{
+// extraction is mostly waiting on I/O and a single decoder thread, so a few files
+// can be worked on at once without starving the rest of the system
+unsigned int GetExtractionJobs()
+{
+  return static_cast<unsigned int>(
+      std::max(1, std::min(CServiceBroker::GetCPUInfo()->GetCPUCount() / 2, 4)));
+}
+} // namespace
+
 CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+  CThumbLoader(), CJobQueue(true, GetExtractionJobs(), CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
 }
@@ -13,6 +13,8 @@
 #include "utils/JobManager.h"
 
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 class CStreamDetails;
@@ -56,6 +58,56 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Extracts several thumbs from one video file in a single pass
+
+ The file is opened once and the positions are visited in order, which is much
+ cheaper than one CThumbExtractor per image (e.g. for chapter thumbs). Progress is
+ reported after each image via IJobCallback::OnJobProgress(), use GetLastCompleted()
+ from the callback to find out which target was handled.
+
+ \sa CThumbExtractor and CDVDFileInfo::ExtractThumbs
+ */
+class CBatchThumbExtractor : public CJob
+{
+public:
+  /*!
+   \param item the video file
+   \param targets pairs of thumb path and position in ms to extract it from
+   */
+  CBatchThumbExtractor(const CFileItem& item,
+                       std::vector<std::pair<std::string, int64_t>> targets);
+
+  bool DoWork() override;
+
+  const char* GetType() const override
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  bool operator==(const CJob* job) const override;
+
+  /*!
+   \brief Index into the targets of the image handled most recently
+   */
+  size_t GetLastCompleted() const { return m_lastCompleted; }
+
+  /*!
+   \brief Whether the target at index was extracted successfully
+   */
+  bool IsExtracted(size_t index) const
+  {
+    return index < m_extracted.size() && m_extracted[index];
+  }
+
+private:
+  CFileItem m_item;
+  std::vector<std::pair<std::string, int64_t>> m_targets;
+  std::vector<bool> m_extracted;
+  size_t m_lastCompleted = 0;
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
@@ -37,6 +37,7 @@
 #include "view/ViewState.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace KODI::MESSAGING;
@@ -263,6 +264,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
   }
 
   // add chapters if around
+  std::vector<std::pair<std::string, int64_t>> chapterTargets;
+  std::vector<unsigned int> chapterIndices;
   for (int i = 1; i <= g_application.GetAppPlayer().GetChapterCount(); ++i)
   {
     std::string chapterName;
@@ -285,11 +288,9 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
-      m_jobsStarted++;
+      chapterTargets.emplace_back(chapterPath, pos * 1000);
+      chapterIndices.push_back(i);
+      m_jobsStarted = i;
     }
 
     item->SetProperty("chapter", i);
@@ -298,6 +299,16 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  // extract all missing chapter thumbs in one pass over the file
+  if (!chapterTargets.empty())
+  {
+    CFileItem item(m_filePath, false);
+    CJob* job = new CBatchThumbExtractor(item, std::move(chapterTargets));
+    m_mapJobsChapter[job] = std::move(chapterIndices);
+    if (!AddJob(job))
+      m_mapJobsChapter.erase(job);
+  }
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -563,16 +574,27 @@ bool CGUIDialogVideoBookmarks::OnAddEpisodeBookmark()
 void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
                                              bool success, CJob* job)
 {
-  if (success && IsActive())
+  m_mapJobsChapter.erase(job);
+  CJobQueue::OnJobComplete(jobID, success, job);
+}
+
+void CGUIDialogVideoBookmarks::OnJobProgress(unsigned int jobID,
+                                             unsigned int progress,
+                                             unsigned int total,
+                                             const CJob* job)
+{
+  if (!IsActive())
+    return;
+
+  MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(const_cast<CJob*>(job));
+  if (iter != m_mapJobsChapter.end())
   {
-    MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
-    if (iter != m_mapJobsChapter.end())
+    const CBatchThumbExtractor* extractor = static_cast<const CBatchThumbExtractor*>(job);
+    const size_t index = extractor->GetLastCompleted();
+    if (index < iter->second.size() && extractor->IsExtracted(index))
     {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
+      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, iter->second[index]);
       CApplicationMessenger::GetInstance().SendGUIMessage(m);
-      m_mapJobsChapter.erase(iter);
     }
   }
-  CJobQueue::OnJobComplete(jobID, success, job);
 }
@@ -17,7 +17,7 @@ class CFileItemList;
 
 class CGUIDialogVideoBookmarks : public CGUIDialog, public CJobQueue
 {
-  typedef std::map<CJob*, unsigned int> MAPJOBSCHAPS;
+  typedef std::map<CJob*, std::vector<unsigned int>> MAPJOBSCHAPS;
 
 public:
   CGUIDialogVideoBookmarks(void);
@@ -61,6 +61,10 @@ protected:
   CGUIControl *GetFirstFocusableControl(int id) override;
 
   void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+  void OnJobProgress(unsigned int jobID,
+                     unsigned int progress,
+                     unsigned int total,
+                     const CJob* job) override;
 
   CFileItemList* m_vecItems;
   CGUIViewControl m_viewControl;
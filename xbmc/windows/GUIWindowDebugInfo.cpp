@@ -20,6 +20,7 @@
 #include "guilib/GUITextLayout.h"
 #include "guilib/GUIWindowManager.h"
 #include "input/WindowTranslator.h"
+#include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/CPUInfo.h"
@@ -129,6 +130,19 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                    .GetFPS(),
                                strCores, ucAppName, dCPU, profiling);
 #endif
+#if defined(HAS_GL) || defined(HAS_GLES)
+    info += StringUtils::Format("\nGUI: {} draw calls, {} texture binds",
+                                CServiceBroker::GetRenderSystem()->GetGUIDrawCalls(),
+                                CServiceBroker::GetRenderSystem()->GetGUITextureBinds());
+#endif
+    info += StringUtils::Format(
+        "\nINFO: {} condition updates",
+        CServiceBroker::GetGUI()->GetInfoManager().GetInfoBoolUpdatesLastFrame());
+    unsigned int shapedHits;
+    unsigned int shapedMisses;
+    g_fontManager.GetShapedTextStats(shapedHits, shapedMisses);
+    info += StringUtils::Format("\nFONT: shaped text cache {} hits, {} misses", shapedHits,
+                                shapedMisses);
   }
 
   // render the skin debug info